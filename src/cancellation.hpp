@@ -0,0 +1,63 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+
+namespace life_lang {
+
+// ============================================================================
+// Cancellation_Token - Cooperative cancellation with an optional deadline
+// ============================================================================
+// Shared between a requester (editor integration, build daemon) and long-running work
+// (parsing, module loading). The work polls is_cancelled() at item, statement and loop
+// boundaries and unwinds without committing partial results.
+//
+// Thread-safe: cancel() and set_deadline() may be called from any thread while the
+// work is polling. Once a token reports cancelled it stays cancelled.
+
+class Cancellation_Token {
+public:
+  using Clock = std::chrono::steady_clock;
+
+  Cancellation_Token() = default;
+  explicit Cancellation_Token(Clock::time_point deadline_) { set_deadline(deadline_); }
+
+  // Non-copyable, non-movable (shared by reference between threads)
+  Cancellation_Token(Cancellation_Token const&) = delete;
+  Cancellation_Token& operator=(Cancellation_Token const&) = delete;
+  Cancellation_Token(Cancellation_Token&&) = delete;
+  Cancellation_Token& operator=(Cancellation_Token&&) = delete;
+  ~Cancellation_Token() = default;
+
+  // Request cancellation; polling work stops at its next boundary check
+  void cancel() { m_cancelled.store(true, std::memory_order_relaxed); }
+
+  // Cancel automatically once the deadline has passed
+  void set_deadline(Clock::time_point deadline_) {
+    m_deadline.store(deadline_.time_since_epoch().count(), std::memory_order_relaxed);
+  }
+
+  // Convenience: deadline relative to now
+  void set_budget(Clock::duration budget_) { set_deadline(Clock::now() + budget_); }
+
+  [[nodiscard]] bool is_cancelled() const {
+    if (m_cancelled.load(std::memory_order_relaxed)) {
+      return true;
+    }
+    auto const deadline = m_deadline.load(std::memory_order_relaxed);
+    if (deadline != k_no_deadline && Clock::now().time_since_epoch().count() >= deadline) {
+      m_cancelled.store(true, std::memory_order_relaxed);  // Latch so later polls skip the clock read
+      return true;
+    }
+    return false;
+  }
+
+private:
+  static constexpr Clock::rep k_no_deadline = std::numeric_limits<Clock::rep>::max();
+
+  mutable std::atomic<bool> m_cancelled{false};
+  std::atomic<Clock::rep> m_deadline{k_no_deadline};
+};
+
+}  // namespace life_lang
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+namespace life_lang {
+
+// ============================================================================
+// Character Classification - constexpr, locale-independent
+// ============================================================================
+// Used by the lexer and the diagnostics printer instead of <cctype>.
+// std::isalpha & co. consult the process locale, so under a non-C locale bytes
+// >= 0x80 may classify as letters or spaces; the table below is a fixed ASCII
+// classification (bytes >= 0x80 belong to no class) and a single indexed load.
+
+using Char_Class_Mask = std::uint16_t;
+
+constexpr Char_Class_Mask k_char_upper = 1U << 0U;             // A-Z
+constexpr Char_Class_Mask k_char_lower = 1U << 1U;             // a-z
+constexpr Char_Class_Mask k_char_digit = 1U << 2U;             // 0-9
+constexpr Char_Class_Mask k_char_hex_digit = 1U << 3U;         // 0-9 a-f A-F
+constexpr Char_Class_Mask k_char_oct_digit = 1U << 4U;         // 0-7
+constexpr Char_Class_Mask k_char_bin_digit = 1U << 5U;         // 0-1
+constexpr Char_Class_Mask k_char_whitespace = 1U << 6U;        // space \t \n \v \f \r (same set as C-locale isspace)
+constexpr Char_Class_Mask k_char_line_break = 1U << 7U;        // \n \r
+constexpr Char_Class_Mask k_char_identifier_start = 1U << 8U;  // letters and _
+constexpr Char_Class_Mask k_char_identifier_continue = 1U << 9U;  // letters, digits and _
+constexpr Char_Class_Mask k_char_operator_start = 1U << 10U;      // first byte of a unary/binary operator
+
+namespace detail {
+
+constexpr std::array<Char_Class_Mask, 256> make_char_class_table() {
+  std::array<Char_Class_Mask, 256> table{};
+  auto const add = [&](std::string_view chars_, Char_Class_Mask mask_) {
+    for (char const c: chars_) {
+      table[static_cast<unsigned char>(c)] |= mask_;
+    }
+  };
+
+  constexpr std::string_view k_upper = "ABCDEFGHIJKLMNOPQRSTUVWXYZ";
+  constexpr std::string_view k_lower = "abcdefghijklmnopqrstuvwxyz";
+  constexpr std::string_view k_digits = "0123456789";
+
+  add(k_upper, k_char_upper | k_char_identifier_start | k_char_identifier_continue);
+  add(k_lower, k_char_lower | k_char_identifier_start | k_char_identifier_continue);
+  add("_", k_char_identifier_start | k_char_identifier_continue);
+  add(k_digits, k_char_digit | k_char_hex_digit | k_char_identifier_continue);
+  add("abcdefABCDEF", k_char_hex_digit);
+  add("01234567", k_char_oct_digit);
+  add("01", k_char_bin_digit);
+  add(" \t\n\v\f\r", k_char_whitespace);
+  add("\n\r", k_char_line_break);
+  add("+-*/%<>=!&|^~", k_char_operator_start);
+  return table;
+}
+
+}  // namespace detail
+
+inline constexpr std::array<Char_Class_Mask, 256> k_char_class_table = detail::make_char_class_table();
+
+[[nodiscard]] constexpr bool char_in_class(char ch_, Char_Class_Mask mask_) {
+  return (k_char_class_table[static_cast<unsigned char>(ch_)] & mask_) != 0;
+}
+
+[[nodiscard]] constexpr bool is_upper(char ch_) {
+  return char_in_class(ch_, k_char_upper);
+}
+[[nodiscard]] constexpr bool is_digit(char ch_) {
+  return char_in_class(ch_, k_char_digit);
+}
+[[nodiscard]] constexpr bool is_hex_digit(char ch_) {
+  return char_in_class(ch_, k_char_hex_digit);
+}
+[[nodiscard]] constexpr bool is_oct_digit(char ch_) {
+  return char_in_class(ch_, k_char_oct_digit);
+}
+[[nodiscard]] constexpr bool is_bin_digit(char ch_) {
+  return char_in_class(ch_, k_char_bin_digit);
+}
+[[nodiscard]] constexpr bool is_whitespace(char ch_) {
+  return char_in_class(ch_, k_char_whitespace);
+}
+[[nodiscard]] constexpr bool is_line_break(char ch_) {
+  return char_in_class(ch_, k_char_line_break);
+}
+[[nodiscard]] constexpr bool is_identifier_start(char ch_) {
+  return char_in_class(ch_, k_char_identifier_start);
+}
+[[nodiscard]] constexpr bool is_identifier_continue(char ch_) {
+  return char_in_class(ch_, k_char_identifier_continue);
+}
+[[nodiscard]] constexpr bool is_operator_start(char ch_) {
+  return char_in_class(ch_, k_char_operator_start);
+}
+
+// ASCII-only case mapping (bytes outside A-Z / a-z are returned unchanged)
+[[nodiscard]] constexpr char to_upper(char ch_) {
+  return char_in_class(ch_, k_char_lower) ? static_cast<char>(ch_ - 'a' + 'A') : ch_;
+}
+[[nodiscard]] constexpr char to_lower(char ch_) {
+  return char_in_class(ch_, k_char_upper) ? static_cast<char>(ch_ - 'A' + 'a') : ch_;
+}
+
+}  // namespace life_lang
@@ -0,0 +1,96 @@
+#include "content_hash.hpp"
+
+#include <bit>
+#include <cstddef>
+
+namespace life_lang {
+
+namespace {
+
+constexpr std::uint64_t k_prime_1 = 0x9E3779B185EBCA87ULL;
+constexpr std::uint64_t k_prime_2 = 0xC2B2AE3D27D4EB4FULL;
+constexpr std::uint64_t k_prime_3 = 0x165667B19E3779F9ULL;
+constexpr std::uint64_t k_prime_4 = 0x85EBCA77C2B2AE63ULL;
+constexpr std::uint64_t k_prime_5 = 0x27D4EB2F165667C5ULL;
+
+// Little-endian loads, independent of the host byte order (compilers fold these into one load)
+std::uint64_t read_u64(char const* bytes_) {
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < 8; ++i) {
+    value |= std::uint64_t{static_cast<unsigned char>(bytes_[i])} << (i * 8);
+  }
+  return value;
+}
+
+std::uint64_t read_u32(char const* bytes_) {
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < 4; ++i) {
+    value |= std::uint64_t{static_cast<unsigned char>(bytes_[i])} << (i * 8);
+  }
+  return value;
+}
+
+std::uint64_t round(std::uint64_t acc_, std::uint64_t input_) {
+  acc_ += input_ * k_prime_2;
+  acc_ = std::rotl(acc_, 31);
+  return acc_ * k_prime_1;
+}
+
+std::uint64_t merge_round(std::uint64_t acc_, std::uint64_t lane_) {
+  acc_ ^= round(0, lane_);
+  return (acc_ * k_prime_1) + k_prime_4;
+}
+
+}  // namespace
+
+std::uint64_t hash_bytes(std::string_view bytes_, std::uint64_t seed_) {
+  char const* at = bytes_.data();
+  char const* const end = at + bytes_.size();
+  std::uint64_t hash = 0;
+
+  if (bytes_.size() >= 32) {
+    std::uint64_t lane_1 = seed_ + k_prime_1 + k_prime_2;
+    std::uint64_t lane_2 = seed_ + k_prime_2;
+    std::uint64_t lane_3 = seed_;
+    std::uint64_t lane_4 = seed_ - k_prime_1;
+    for (; end - at >= 32; at += 32) {
+      lane_1 = round(lane_1, read_u64(at));
+      lane_2 = round(lane_2, read_u64(at + 8));
+      lane_3 = round(lane_3, read_u64(at + 16));
+      lane_4 = round(lane_4, read_u64(at + 24));
+    }
+    hash = std::rotl(lane_1, 1) + std::rotl(lane_2, 7) + std::rotl(lane_3, 12) + std::rotl(lane_4, 18);
+    hash = merge_round(hash, lane_1);
+    hash = merge_round(hash, lane_2);
+    hash = merge_round(hash, lane_3);
+    hash = merge_round(hash, lane_4);
+  } else {
+    hash = seed_ + k_prime_5;
+  }
+  hash += bytes_.size();
+
+  // Tail: 8, then 4, then 1 byte at a time
+  for (; end - at >= 8; at += 8) {
+    hash ^= round(0, read_u64(at));
+    hash = (std::rotl(hash, 27) * k_prime_1) + k_prime_4;
+  }
+  if (end - at >= 4) {
+    hash ^= read_u32(at) * k_prime_1;
+    hash = (std::rotl(hash, 23) * k_prime_2) + k_prime_3;
+    at += 4;
+  }
+  for (; at != end; ++at) {
+    hash ^= std::uint64_t{static_cast<unsigned char>(*at)} * k_prime_5;
+    hash = std::rotl(hash, 11) * k_prime_1;
+  }
+
+  // Avalanche
+  hash ^= hash >> 33;
+  hash *= k_prime_2;
+  hash ^= hash >> 29;
+  hash *= k_prime_3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+}  // namespace life_lang
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace life_lang {
+
+// ============================================================================
+// Content hashing - fast non-cryptographic 64-bit hash of file contents
+// ============================================================================
+// XXH64 (https://github.com/Cyan4973/xxHash): reads 32-byte stripes in four
+// independent lanes, so it runs at memory speed on source files and has no
+// per-call setup cost for short inputs. Results are stable across runs,
+// processes and platforms, which makes them usable as keys for on-disk caches.
+//
+// Not collision-resistant against an adversary: use it to detect changes,
+// never to authenticate content.
+//
+// Example:
+//   std::uint64_t const key = hash_bytes(source_text);
+//   std::uint64_t const salted = hash_bytes(source_text, k_format_seed);
+
+[[nodiscard]] std::uint64_t hash_bytes(std::string_view bytes_, std::uint64_t seed_ = 0);
+
+}  // namespace life_lang
@@ -1,9 +1,13 @@
 #include "diagnostics.hpp"
 
+#include "char_class.hpp"
 #include "utils.hpp"
 
 #include <algorithm>
 #include <format>
+#include <mutex>
+#include <tuple>
+#include <unordered_set>
 
 namespace life_lang {
 
@@ -11,6 +15,12 @@ namespace life_lang {
 // Source_File implementation
 // ============================================================================
 
+namespace {
+// Per-line flags; a line with neither flag maps columns to bytes and display cells 1:1
+constexpr std::uint8_t k_line_non_ascii = 1U << 0U;
+constexpr std::uint8_t k_line_has_tab = 1U << 1U;
+}  // namespace
+
 Source_File::Source_File(std::string source_) : m_source(std::move(source_)) {
   build_line_index();
 }
@@ -21,23 +31,139 @@ Source_File::Source_File(std::string path_, std::string source_)
 }
 
 void Source_File::set_source(std::string source_) {
+  // Reduce the replacement to the region between the common prefix and common suffix
+  std::size_t const common = std::min(m_source.size(), source_.size());
+  std::size_t prefix = 0;
+  while (prefix < common && m_source[prefix] == source_[prefix]) {
+    ++prefix;
+  }
+  std::size_t suffix = 0;
+  while (suffix < common - prefix && m_source[m_source.size() - 1 - suffix] == source_[source_.size() - 1 - suffix]) {
+    ++suffix;
+  }
+
+  std::size_t const removed_length = m_source.size() - prefix - suffix;
+  std::size_t const inserted_length = source_.size() - prefix - suffix;
   m_source = std::move(source_);
-  build_line_index();
+  update_line_index(prefix, removed_length, inserted_length);
+}
+
+void Source_File::apply_edit(Text_Edit const& edit_) {
+  std::size_t const offset = std::min(edit_.offset, m_source.size());
+  std::size_t const removed_length = std::min(edit_.removed_length, m_source.size() - offset);
+  m_source.replace(offset, removed_length, edit_.inserted);
+  update_line_index(offset, removed_length, edit_.inserted.size());
 }
 
 void Source_File::build_line_index() {
   m_line_offsets.clear();
   m_line_offsets.push_back(0);  // Line 1 starts at offset 0
   for (std::size_t i = 0; i < m_source.size(); ++i) {
+    if (!is_line_break(m_source[i])) {
+      continue;
+    }
     if (m_source[i] == '\n') {
       m_line_offsets.push_back(i + 1);
-    } else if (m_source[i] == '\r') {
+    } else {
       if (i + 1 < m_source.size() && m_source[i + 1] == '\n') {
         continue;  // CRLF - let \n handling record the line
       }
       m_line_offsets.push_back(i + 1);  // Old Mac CR
     }
   }
+
+  m_line_flags.resize(m_line_offsets.size());
+  for (std::size_t line = 0; line < m_line_offsets.size(); ++line) {
+    m_line_flags[line] = compute_line_flags(line);
+  }
+  m_utf8_errors = validate_utf8(m_source);
+}
+
+std::uint8_t Source_File::compute_line_flags(std::size_t line_index_) const {
+  std::size_t const start = m_line_offsets[line_index_];
+  std::size_t const end =
+      (line_index_ + 1 < m_line_offsets.size()) ? m_line_offsets[line_index_ + 1] : m_source.size();
+  std::string_view const line{m_source.data() + start, end - start};
+
+  std::uint8_t flags = 0;
+  if (!is_ascii(line)) {
+    flags |= k_line_non_ascii;
+  }
+  if (line.find('\t') != std::string_view::npos) {
+    flags |= k_line_has_tab;
+  }
+  return flags;
+}
+
+void Source_File::update_line_index(std::size_t offset_, std::size_t removed_length_, std::size_t inserted_length_) {
+  // A line start s is recorded because of the terminator at s - 1, and whether a '\r' terminates
+  // a line depends on the byte after it. So:
+  // - starts with s - 1 < offset_ - 1 only look at unchanged bytes before the edit: kept
+  // - starts with s - 1 >= old edit end only look at unchanged bytes after the edit: shifted
+  // - terminators in [offset_ - 1, new edit end) are rescanned
+  std::size_t const scan_start = (offset_ > 0) ? offset_ - 1 : 0;
+  std::size_t const old_edit_end = offset_ + removed_length_;
+  std::size_t const new_edit_end = std::min(offset_ + inserted_length_, m_source.size());
+
+  auto const keep_end = std::ranges::upper_bound(m_line_offsets, scan_start);
+  auto const tail_begin = std::ranges::upper_bound(m_line_offsets, old_edit_end);
+  auto const keep_count = static_cast<std::size_t>(keep_end - m_line_offsets.begin());
+  auto const tail_index = static_cast<std::size_t>(tail_begin - m_line_offsets.begin());
+  for (auto it = tail_begin; it != m_line_offsets.end(); ++it) {
+    *it = *it - old_edit_end + new_edit_end;
+  }
+
+  std::vector<std::size_t> rescanned;
+  for (std::size_t i = scan_start; i < new_edit_end; ++i) {
+    if (!is_line_break(m_source[i])) {
+      continue;
+    }
+    if (m_source[i] == '\n') {
+      rescanned.push_back(i + 1);
+    } else if (m_source[i] == '\r' && (i + 1 >= m_source.size() || m_source[i + 1] != '\n')) {
+      rescanned.push_back(i + 1);
+    }
+  }
+
+  auto const insert_at = m_line_offsets.erase(keep_end, tail_begin);
+  m_line_offsets.insert(insert_at, rescanned.begin(), rescanned.end());
+
+  // Lines from the one holding scan_start to the one after the rescanned starts may have new text
+  auto const flags_begin = m_line_flags.begin() + static_cast<std::ptrdiff_t>(keep_count);
+  m_line_flags.insert(
+      m_line_flags.erase(flags_begin, m_line_flags.begin() + static_cast<std::ptrdiff_t>(tail_index)),
+      rescanned.size(),
+      std::uint8_t{0}
+  );
+  std::size_t const first_line = keep_count - 1;
+  std::size_t const last_line = std::min(keep_count + rescanned.size(), m_line_offsets.size() - 1);
+  for (std::size_t line = first_line; line <= last_line; ++line) {
+    m_line_flags[line] = compute_line_flags(line);
+  }
+
+  // Sequences never span a line break, so revalidating those whole lines is exact; errors
+  // before them are kept and errors after them are shifted
+  std::size_t const region_begin = m_line_offsets[first_line];
+  std::size_t const region_end =
+      (last_line + 1 < m_line_offsets.size()) ? m_line_offsets[last_line + 1] : m_source.size();
+  std::size_t const old_region_end = region_end - new_edit_end + old_edit_end;
+
+  std::vector<Utf8_Error> errors;
+  for (auto const& error: m_utf8_errors) {
+    if (error.offset < region_begin) {
+      errors.push_back(error);
+    }
+  }
+  for (auto error: validate_utf8(std::string_view{m_source}.substr(region_begin, region_end - region_begin))) {
+    error.offset += region_begin;
+    errors.push_back(error);
+  }
+  for (auto const& error: m_utf8_errors) {
+    if (error.offset >= old_region_end) {
+      errors.push_back(Utf8_Error{.offset = error.offset - old_edit_end + new_edit_end, .length = error.length});
+    }
+  }
+  m_utf8_errors = std::move(errors);
 }
 
 std::string_view Source_File::get_line(std::size_t line_number_) const {
@@ -59,24 +185,132 @@ Source_Position Source_File::offset_to_position(std::size_t offset_) const {
   auto const it = std::ranges::upper_bound(m_line_offsets, offset_);
   auto const line = static_cast<std::size_t>(std::distance(m_line_offsets.begin(), it));
   std::size_t const line_start = (line > 0) ? m_line_offsets[line - 1] : 0;
-  std::size_t const column = offset_ - line_start + 1;
-  return Source_Position{.line = line, .column = column};
+  if (is_ascii_line(line) || offset_ > m_source.size()) {
+    return Source_Position{.line = line, .column = offset_ - line_start + 1};
+  }
+  std::string_view const prefix{m_source.data() + line_start, offset_ - line_start};
+  return Source_Position{.line = line, .column = count_code_points(prefix) + 1};
+}
+
+std::size_t Source_File::position_to_offset(Source_Position position_) const {
+  if (position_.line == 0) {
+    return 0;
+  }
+  if (position_.line > m_line_offsets.size()) {
+    return m_source.size();
+  }
+  std::size_t const line_start = m_line_offsets[position_.line - 1];
+  std::size_t const column = (position_.column > 0) ? position_.column - 1 : 0;
+  if (is_ascii_line(position_.line)) {
+    return std::min(line_start + column, m_source.size());
+  }
+  return advance_code_points(m_source, line_start, column);
+}
+
+bool Source_File::is_ascii_line(std::size_t line_number_) const {
+  if (line_number_ == 0 || line_number_ > m_line_flags.size()) {
+    return true;
+  }
+  return (m_line_flags[line_number_ - 1] & k_line_non_ascii) == 0;
+}
+
+std::size_t Source_File::visual_column(Source_Position position_) const {
+  if (position_.line == 0 || position_.line > m_line_flags.size()) {
+    return 0;  // No such line
+  }
+  auto const line = get_line(position_.line);
+  std::size_t const column = (position_.column > 0) ? position_.column - 1 : 0;
+  std::uint8_t const flags = m_line_flags[position_.line - 1];
+  if (line.empty() || (flags & (k_line_non_ascii | k_line_has_tab)) == 0) {
+    return std::min(column, line.size());
+  }
+
+  std::size_t visual = 0;
+  std::size_t i = 0;
+  for (std::size_t n = 0; n < column && i < line.size(); ++n) {
+    if (line[i] == '\t') {
+      visual += 8 - (visual % 8);
+    } else {
+      ++visual;
+    }
+    i = advance_code_points(line, i, 1);
+  }
+  return visual;
 }
 
 // ============================================================================
 // Source_File_Registry implementation
 // ============================================================================
 
+Source_File_Registry::Source_File_Registry(Source_File_Registry&& other_) noexcept
+    : m_files(std::move(other_.m_files)) {}
+
+Source_File_Registry& Source_File_Registry::operator=(Source_File_Registry&& other_) noexcept {
+  if (this != &other_) {
+    m_files = std::move(other_.m_files);
+  }
+  return *this;
+}
+
 File_Id Source_File_Registry::register_file(std::string path_, std::string source_) {
-  m_files.emplace_back(std::move(path_), std::move(source_));
+  auto file = std::make_unique<Source_File>(std::move(path_), std::move(source_));  // Indexed outside the lock
+  std::unique_lock const lock(m_mutex);
+  m_files.push_back(std::move(file));
   return static_cast<File_Id>(m_files.size());  // ID = index + 1
 }
 
-Source_File const* Source_File_Registry::get_file(File_Id id_) const {
+File_Id Source_File_Registry::reserve_files(std::vector<std::string> paths_) {
+  std::vector<std::unique_ptr<Source_File>> files;
+  files.reserve(paths_.size());
+  for (auto& path: paths_) {
+    files.push_back(std::make_unique<Source_File>(std::move(path), std::string{}));
+  }
+  std::unique_lock const lock(m_mutex);
+  auto const first = static_cast<File_Id>(m_files.size() + 1);
+  m_files.insert(m_files.end(), std::make_move_iterator(files.begin()), std::make_move_iterator(files.end()));
+  return first;
+}
+
+Source_File* Source_File_Registry::find_file(File_Id id_) const {
+  std::shared_lock const lock(m_mutex);
   if (id_ == k_invalid_file_id || id_ > m_files.size()) {
     return nullptr;
   }
-  return &m_files[id_ - 1];
+  return m_files[id_ - 1].get();
+}
+
+Source_File const* Source_File_Registry::get_file(File_Id id_) const {
+  return find_file(id_);
+}
+
+bool Source_File_Registry::set_source(File_Id id_, std::string source_) {
+  auto* file = find_file(id_);
+  if (file == nullptr) {
+    return false;
+  }
+  file->set_source(std::move(source_));
+  return true;
+}
+
+bool Source_File_Registry::apply_edit(File_Id id_, Text_Edit const& edit_) {
+  auto* file = find_file(id_);
+  if (file == nullptr) {
+    return false;
+  }
+  file->apply_edit(edit_);
+  return true;
+}
+
+std::size_t Source_File_Registry::file_count() const {
+  std::shared_lock const lock(m_mutex);
+  return m_files.size();
+}
+
+void Source_File_Registry::truncate(std::size_t count_) {
+  std::unique_lock const lock(m_mutex);
+  if (count_ < m_files.size()) {
+    m_files.resize(count_);
+  }
 }
 
 std::string_view Source_File_Registry::get_path(File_Id id_) const {
@@ -108,18 +342,6 @@ constexpr std::string_view level_string(Diagnostic_Level level_) {
   unreachable();
 }
 
-std::size_t visual_column(std::string_view line_, std::size_t column_) {
-  std::size_t visual = 0;
-  for (std::size_t i = 0; i < std::min(column_ - 1, line_.size()); ++i) {
-    if (line_[i] == '\t') {
-      visual += 8 - (visual % 8);
-    } else {
-      ++visual;
-    }
-  }
-  return visual;
-}
-
 void print_source_context(std::ostream& out_, Source_File const* source_, Diagnostic const& diag_) {
   if (source_ == nullptr || source_->empty()) {
     return;
@@ -133,8 +355,8 @@ void print_source_context(std::ostream& out_, Source_File const* source_, Diagno
 
     out_ << std::format("    {}\n", line);
 
-    std::size_t const start_col = visual_column(line, diag_.range.start.column);
-    std::size_t end_col = visual_column(line, diag_.range.end.column);
+    std::size_t const start_col = source_->visual_column(diag_.range.start);
+    std::size_t end_col = source_->visual_column(diag_.range.end);
     if (end_col <= start_col) {
       end_col = start_col + 1;
     }
@@ -146,8 +368,10 @@ void print_source_context(std::ostream& out_, Source_File const* source_, Diagno
 
     if (!first_line.empty()) {
       out_ << std::format("    {}\n", first_line);
-      std::size_t const start_col = visual_column(first_line, diag_.range.start.column);
-      std::size_t const rest_of_line = first_line.size() > start_col ? first_line.size() - start_col : 1;
+      std::size_t const start_col = source_->visual_column(diag_.range.start);
+      std::size_t const line_width =
+          source_->visual_column(Source_Position{.line = diag_.range.start.line, .column = std::string_view::npos});
+      std::size_t const rest_of_line = line_width > start_col ? line_width - start_col : 1;
       out_ << std::format("    {}^{}\n", std::string(start_col, ' '), std::string(rest_of_line - 1, '~'));
     }
 
@@ -157,7 +381,7 @@ void print_source_context(std::ostream& out_, Source_File const* source_, Diagno
 
     if (!last_line.empty() && diag_.range.end.line != diag_.range.start.line) {
       out_ << std::format("    {}\n", last_line);
-      std::size_t const end_col = visual_column(last_line, diag_.range.end.column);
+      std::size_t const end_col = source_->visual_column(diag_.range.end);
       out_ << std::format("    {}^\n", std::string(end_col > 0 ? end_col - 1 : 0, '~'));
     }
   }
@@ -191,7 +415,7 @@ void print_diagnostic(std::ostream& out_, Source_File_Registry const& registry_,
 // ============================================================================
 
 Diagnostic_Engine::Diagnostic_Engine(Source_File_Registry const& registry_, File_Id file_id_)
-    : m_registry(&registry_), m_file_id(file_id_) {}
+    : m_registry(&registry_), m_file_id(file_id_), m_file(registry_.get_file(file_id_)) {}
 
 void Diagnostic_Engine::add_error(Source_Range range_, std::string message_) {
   // Ensure the file ID matches
@@ -215,12 +439,11 @@ bool Diagnostic_Engine::has_errors() const {
 }
 
 Source_File const& Diagnostic_Engine::file() const {
-  auto const* f = m_registry->get_file(m_file_id);
-  if (f == nullptr) {
+  if (m_file == nullptr) {
     static Source_File const s_empty_file;
     return s_empty_file;
   }
-  return *f;
+  return *m_file;
 }
 
 std::string_view Diagnostic_Engine::source() const {
@@ -245,6 +468,24 @@ void Diagnostic_Engine::print(std::ostream& out_) const {
   }
 }
 
+// ============================================================================
+// Diagnostic_Sink implementation
+// ============================================================================
+
+void Diagnostic_Sink::add_error(Source_Range range_, std::string message_, std::string key_) {
+  m_entries.push_back(Entry{
+      .diagnostic =
+          Diagnostic{.level = Diagnostic_Level::Error, .range = range_, .message = std::move(message_), .notes = {}},
+      .key = std::move(key_),
+  });
+}
+
+bool Diagnostic_Sink::has_errors() const {
+  return std::ranges::any_of(m_entries, [](auto const& entry_) {
+    return entry_.diagnostic.level == Diagnostic_Level::Error;
+  });
+}
+
 // ============================================================================
 // Diagnostic_Manager implementation
 // ============================================================================
@@ -272,6 +513,38 @@ void Diagnostic_Manager::add_error(std::string const& file_path_, Source_Range r
   add_error(range_, std::move(message_));
 }
 
+void Diagnostic_Manager::add_diagnostics(std::vector<Diagnostic> diagnostics_) {
+  m_diagnostics.insert(
+      m_diagnostics.end(), std::make_move_iterator(diagnostics_.begin()), std::make_move_iterator(diagnostics_.end())
+  );
+}
+
+void Diagnostic_Manager::merge(std::span<Diagnostic_Sink> sinks_) {
+  std::vector<Diagnostic_Sink::Entry> entries;
+  for (auto& sink: sinks_) {
+    entries.insert(
+        entries.end(), std::make_move_iterator(sink.m_entries.begin()), std::make_move_iterator(sink.m_entries.end())
+    );
+    sink.m_entries.clear();
+  }
+
+  // Ties (the same message at the same place) are interchangeable, so a stable sort isn't needed
+  std::ranges::sort(entries, [](auto const& lhs_, auto const& rhs_) {
+    auto const& lhs = lhs_.diagnostic;
+    auto const& rhs = rhs_.diagnostic;
+    return std::tie(lhs.range.file, lhs.range.start, lhs.range.end, lhs.message, lhs_.key) <
+           std::tie(rhs.range.file, rhs.range.start, rhs.range.end, rhs.message, rhs_.key);
+  });
+
+  std::unordered_set<std::string_view> seen_keys;
+  for (auto& entry: entries) {
+    if (!entry.key.empty() && !seen_keys.insert(entry.key).second) {
+      continue;
+    }
+    m_diagnostics.push_back(std::move(entry.diagnostic));
+  }
+}
+
 bool Diagnostic_Manager::has_errors() const {
   return std::ranges::any_of(m_diagnostics, [](auto const& diag_) { return diag_.level == Diagnostic_Level::Error; });
 }
@@ -282,6 +555,12 @@ std::size_t Diagnostic_Manager::error_count() const {
   }));
 }
 
+void Diagnostic_Manager::truncate_diagnostics(std::size_t count_) {
+  if (count_ < m_diagnostics.size()) {
+    m_diagnostics.erase(m_diagnostics.begin() + static_cast<std::ptrdiff_t>(count_), m_diagnostics.end());
+  }
+}
+
 void Diagnostic_Manager::print(std::ostream& out_) const {
   for (auto const& diag: m_diagnostics) {
     print_diagnostic(out_, m_registry, diag);
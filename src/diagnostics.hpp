@@ -2,11 +2,16 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <ostream>
+#include <shared_mutex>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
+#include "utf8.hpp"
+
 namespace life_lang {
 
 // ============================================================================
@@ -55,9 +60,24 @@ struct Diagnostic {
   std::vector<Diagnostic> notes;
 };
 
+// ============================================================================
+// Text_Edit - Single contiguous replacement in a source buffer
+// ============================================================================
+// Replaces removed_length bytes starting at byte offset with inserted
+// Example: {.offset = 4, .removed_length = 3, .inserted = "bar"} turns "let foo" into "let bar"
+
+struct Text_Edit {
+  std::size_t offset{};
+  std::size_t removed_length{};
+  std::string inserted;
+};
+
 // ============================================================================
 // Source_File - Source text with line indexing
 // ============================================================================
+// The text is validated as UTF-8 up front (see utf8_errors()). Columns count code
+// points; each line caches whether it is pure ASCII so positions on ASCII lines
+// stay plain byte arithmetic.
 
 class Source_File {
 public:
@@ -65,8 +85,14 @@ public:
   explicit Source_File(std::string source_);
   Source_File(std::string path_, std::string source_);
 
+  // Replace the whole text; only the line index entries inside the changed
+  // region (common prefix/suffix stripped) are recomputed
   void set_source(std::string source_);
 
+  // Apply a single edit in place, updating the line index incrementally
+  // Edits that reach past the end of the text are clamped
+  void apply_edit(Text_Edit const& edit_);
+
   [[nodiscard]] std::string const& path() const { return m_path; }
   [[nodiscard]] std::string const& source() const { return m_source; }
   [[nodiscard]] bool empty() const { return m_source.empty(); }
@@ -74,21 +100,49 @@ public:
   // Get source line by line number (1-indexed)
   [[nodiscard]] std::string_view get_line(std::size_t line_number_) const;
 
+  // Number of lines (an empty text or a trailing newline still counts one line)
+  [[nodiscard]] std::size_t line_count() const { return m_line_offsets.size(); }
+
   // Convert byte offset to line/column position (1-indexed)
   [[nodiscard]] Source_Position offset_to_position(std::size_t offset_) const;
 
+  // Convert line/column position (1-indexed) back to a byte offset, clamped to the text size
+  [[nodiscard]] std::size_t position_to_offset(Source_Position position_) const;
+
+  // Ill-formed UTF-8 ranges found when the text was registered or edited
+  [[nodiscard]] std::vector<Utf8_Error> const& utf8_errors() const { return m_utf8_errors; }
+  [[nodiscard]] bool is_valid_utf8() const { return m_utf8_errors.empty(); }
+
+  // Whether a line (1-indexed) contains only ASCII bytes
+  [[nodiscard]] bool is_ascii_line(std::size_t line_number_) const;
+
+  // Display column (0-indexed) of a position: tabs advance to the next multiple of 8,
+  // every other code point takes one cell. Columns past the end of the line are clamped;
+  // a line outside the file (0, or past the last line) gives 0.
+  [[nodiscard]] std::size_t visual_column(Source_Position position_) const;
+
 private:
   std::string m_path;
   std::string m_source;
   std::vector<std::size_t> m_line_offsets;
+  std::vector<std::uint8_t> m_line_flags;  // Parallel to m_line_offsets, see k_line_* in diagnostics.cpp
+  std::vector<Utf8_Error> m_utf8_errors;
 
   void build_line_index();
+  [[nodiscard]] std::uint8_t compute_line_flags(std::size_t line_index_) const;
+
+  // Patch m_line_offsets after m_source[offset_, offset_ + removed_length_) was
+  // replaced by inserted_length_ bytes (m_source must already hold the new text)
+  void update_line_index(std::size_t offset_, std::size_t removed_length_, std::size_t inserted_length_);
 };
 
 // ============================================================================
 // Source_File_Registry - Central registry for all source files
 // ============================================================================
 // Maps File_Id to source file information. Shared between parser and semantic analysis.
+// Registration and lookup are thread-safe, and Source_File pointers stay valid for the
+// registry's lifetime, so files can be read and parsed on several threads at once.
+// Moving a registry is not thread-safe.
 
 struct Source_File_Registry {
   Source_File_Registry() = default;
@@ -96,14 +150,23 @@ struct Source_File_Registry {
   // Non-copyable, movable
   Source_File_Registry(Source_File_Registry const&) = delete;
   Source_File_Registry& operator=(Source_File_Registry const&) = delete;
-  Source_File_Registry(Source_File_Registry&&) = default;
-  Source_File_Registry& operator=(Source_File_Registry&&) = default;
+  Source_File_Registry(Source_File_Registry&& other_) noexcept;
+  Source_File_Registry& operator=(Source_File_Registry&& other_) noexcept;
   ~Source_File_Registry() = default;
 
   // Register a new source file, returns its File_Id
   // File_Id starts at 1 (0 is k_invalid_file_id)
   [[nodiscard]] File_Id register_file(std::string path_, std::string source_);
 
+  // Register empty files for paths_ in order and return the first File_Id (ids are consecutive)
+  // Used by parallel loading: ids follow the path order no matter which thread reads which file
+  // first; each file then receives its text through set_source
+  [[nodiscard]] File_Id reserve_files(std::vector<std::string> paths_);
+
+  // Replace the text of a registered file. Different files may be filled concurrently.
+  // Returns false if ID is invalid
+  bool set_source(File_Id id_, std::string source_);
+
   // Get file information by ID
   // Returns nullptr if ID is invalid or not found
   [[nodiscard]] Source_File const* get_file(File_Id id_) const;
@@ -116,11 +179,22 @@ struct Source_File_Registry {
   // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
   [[nodiscard]] std::string_view get_line(File_Id id_, std::size_t line_number_) const;
 
+  // Apply an edit to a registered file in place (File_Id and spans into unchanged text stay valid)
+  // Returns false if ID is invalid
+  bool apply_edit(File_Id id_, Text_Edit const& edit_);
+
   // Get number of registered files
-  [[nodiscard]] std::size_t file_count() const { return m_files.size(); }
+  [[nodiscard]] std::size_t file_count() const;
+
+  // Drop every file registered after the first count_ (undoes the registrations of a cancelled load)
+  // Their File_Ids are handed out again, so nothing may still refer to the dropped files
+  void truncate(std::size_t count_);
 
 private:
-  std::vector<Source_File> m_files;  // Index = File_Id - 1
+  [[nodiscard]] Source_File* find_file(File_Id id_) const;
+
+  mutable std::shared_mutex m_mutex;                  // Guards the m_files vector, not the files themselves
+  std::vector<std::unique_ptr<Source_File>> m_files;  // Index = File_Id - 1
 };
 
 // ============================================================================
@@ -146,6 +220,7 @@ struct Diagnostic_Engine {
   [[nodiscard]] bool has_errors() const;
 
   [[nodiscard]] std::vector<Diagnostic> const& diagnostics() const { return m_diagnostics; }
+  [[nodiscard]] std::vector<Diagnostic> take_diagnostics() { return std::move(m_diagnostics); }
   [[nodiscard]] File_Id file_id() const { return m_file_id; }
   [[nodiscard]] Source_File const& file() const;
 
@@ -167,9 +242,41 @@ struct Diagnostic_Engine {
 private:
   Source_File_Registry const* m_registry;
   File_Id m_file_id;
+  Source_File const* m_file;  // Looked up once - the lexer reads the text through file() per character
   std::vector<Diagnostic> m_diagnostics;
 };
 
+// ============================================================================
+// Diagnostic_Sink - Per-thread diagnostic collection (for concurrent queries)
+// ============================================================================
+// Each worker thread reports into its own sink, so reporting takes no lock;
+// Diagnostic_Manager::merge then adds the diagnostics of all sinks in source
+// order, whichever thread found which problem. A key marks diagnostics that
+// describe the same problem (e.g. one unresolved name in one module): merge
+// keeps only the first of them in source order.
+//
+// Example:
+//   std::vector<Diagnostic_Sink> sinks(pool.thread_count());
+//   // ... worker i calls ctx.resolve_type_name(module, name, sinks[i]) ...
+//   diagnostics.merge(sinks);
+
+class Diagnostic_Sink {
+public:
+  void add_error(Source_Range range_, std::string message_, std::string key_ = {});
+
+  [[nodiscard]] bool has_errors() const;
+  [[nodiscard]] std::size_t diagnostic_count() const { return m_entries.size(); }
+
+private:
+  friend class Diagnostic_Manager;
+
+  struct Entry {
+    Diagnostic diagnostic;
+    std::string key;  // Empty: never merged with another diagnostic
+  };
+  std::vector<Entry> m_entries;
+};
+
 // ============================================================================
 // Diagnostic_Manager - Multi-file diagnostic collection (for semantic analysis)
 // ============================================================================
@@ -200,6 +307,13 @@ public:
   // Legacy API for compatibility - uses file path lookup
   void add_error(std::string const& file_path_, Source_Range range_, std::string message_);
 
+  // Append diagnostics collected elsewhere (e.g. a per-file Diagnostic_Engine), keeping their order
+  void add_diagnostics(std::vector<Diagnostic> diagnostics_);
+
+  // Append the diagnostics of all sinks_ sorted by file, position and message, keeping the first of
+  // each key, and empty the sinks. The result doesn't depend on how the work was spread over them.
+  void merge(std::span<Diagnostic_Sink> sinks_);
+
   [[nodiscard]] bool has_errors() const;
   [[nodiscard]] std::size_t error_count() const;
   [[nodiscard]] std::size_t diagnostic_count() const { return m_diagnostics.size(); }
@@ -214,6 +328,8 @@ public:
   }
 
   void clear_diagnostics() { m_diagnostics.clear(); }
+  // Drop every diagnostic reported after the first count_
+  void truncate_diagnostics(std::size_t count_);
   void clear_all();
 
 private:
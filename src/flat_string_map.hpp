@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace life_lang {
+
+// ============================================================================
+// Flat_String_Map - Open-addressing hash map with string keys
+// ============================================================================
+// Symbol tables are built once and then probed far more often than they are
+// modified, so the layout favours lookups:
+// - Entries live in one dense vector in insertion order (iteration is
+//   deterministic and cache-friendly)
+// - The slot array is a power-of-two table of (hash fragment, entry index)
+//   pairs probed linearly; the fragment filters out almost every key compare
+// - find() takes a std::string_view, so a query never builds a std::string
+//   and never allocates
+//
+// There is no erase: tables are cleared and rebuilt wholesale. Pointers
+// returned by find()/try_emplace() are invalidated by the next insertion.
+//
+// Example:
+//   Flat_String_Map<int> ids;
+//   ids.try_emplace("Point", 1);
+//   if (int const* id = ids.find(segment_view)) { ... }
+
+template <typename Value>
+class Flat_String_Map {
+public:
+  struct Entry {
+    std::string key;
+    Value value;
+  };
+
+  [[nodiscard]] std::size_t size() const { return m_entries.size(); }
+  [[nodiscard]] bool empty() const { return m_entries.empty(); }
+
+  void clear() {
+    m_entries.clear();
+    m_slots.clear();
+  }
+
+  // Pre-size for count_ entries so that inserting them never rehashes
+  void reserve(std::size_t count_) {
+    m_entries.reserve(count_);
+    std::size_t const capacity = slot_count_for(count_);
+    if (capacity > m_slots.size()) {
+      rehash(capacity);
+    }
+  }
+
+  [[nodiscard]] Value const* find(std::string_view key_) const {
+    std::size_t const index = find_index(key_, hash_key(key_));
+    return index == k_npos ? nullptr : &m_entries[index].value;
+  }
+
+  [[nodiscard]] Value* find(std::string_view key_) {
+    std::size_t const index = find_index(key_, hash_key(key_));
+    return index == k_npos ? nullptr : &m_entries[index].value;
+  }
+
+  [[nodiscard]] bool contains(std::string_view key_) const { return find(key_) != nullptr; }
+
+  // Insert key_ with a value built from args_ unless key_ is already present
+  // Returns the stored value and whether it was inserted
+  template <typename... Args>
+  std::pair<Value*, bool> try_emplace(std::string_view key_, Args&&... args_) {
+    std::size_t const hash = hash_key(key_);
+    if (std::size_t const index = find_index(key_, hash); index != k_npos) {
+      return {&m_entries[index].value, false};
+    }
+    if (slot_count_for(m_entries.size() + 1) > m_slots.size()) {
+      rehash(slot_count_for(m_entries.size() + 1));
+    }
+    auto const index = static_cast<std::uint32_t>(m_entries.size());
+    m_entries.push_back(Entry{.key = std::string(key_), .value = Value(std::forward<Args>(args_)...)});
+    place(Slot{.fragment = fragment_of(hash), .index = index}, hash);
+    return {&m_entries.back().value, true};
+  }
+
+  // Value for key_, default-constructed and inserted if missing
+  Value& operator[](std::string_view key_) { return *try_emplace(key_).first; }
+
+  // Entries in insertion order
+  [[nodiscard]] auto begin() const { return m_entries.begin(); }
+  [[nodiscard]] auto end() const { return m_entries.end(); }
+  [[nodiscard]] auto begin() { return m_entries.begin(); }
+  [[nodiscard]] auto end() { return m_entries.end(); }
+
+private:
+  static constexpr std::uint32_t k_empty_slot = UINT32_MAX;
+  static constexpr std::size_t k_npos = SIZE_MAX;
+  static constexpr std::size_t k_min_slots = 8;
+
+  struct Slot {
+    std::uint32_t fragment{};            // High bits of the key hash (the low bits pick the slot)
+    std::uint32_t index = k_empty_slot;  // Position in m_entries
+  };
+
+  std::vector<Entry> m_entries;
+  std::vector<Slot> m_slots;  // Power-of-two size, at most 3/4 full
+
+  [[nodiscard]] static std::size_t hash_key(std::string_view key_) { return std::hash<std::string_view>{}(key_); }
+  [[nodiscard]] static std::uint32_t fragment_of(std::size_t hash_) {
+    return static_cast<std::uint32_t>(hash_ >> ((sizeof(std::size_t) - sizeof(std::uint32_t)) * CHAR_BIT));
+  }
+
+  [[nodiscard]] static std::size_t slot_count_for(std::size_t count_) {
+    if (count_ == 0) {
+      return 0;
+    }
+    return std::max(k_min_slots, std::bit_ceil(count_ + (count_ / 3) + 1));
+  }
+
+  [[nodiscard]] std::size_t find_index(std::string_view key_, std::size_t hash_) const {
+    if (m_slots.empty()) {
+      return k_npos;
+    }
+    std::size_t const mask = m_slots.size() - 1;
+    std::uint32_t const fragment = fragment_of(hash_);
+    for (std::size_t pos = hash_ & mask;; pos = (pos + 1) & mask) {
+      Slot const& slot = m_slots[pos];
+      if (slot.index == k_empty_slot) {
+        return k_npos;
+      }
+      if (slot.fragment == fragment && m_entries[slot.index].key == key_) {
+        return slot.index;
+      }
+    }
+  }
+
+  void place(Slot slot_, std::size_t hash_) {
+    std::size_t const mask = m_slots.size() - 1;
+    std::size_t pos = hash_ & mask;
+    while (m_slots[pos].index != k_empty_slot) {
+      pos = (pos + 1) & mask;
+    }
+    m_slots[pos] = slot_;
+  }
+
+  void rehash(std::size_t slot_count_) {
+    m_slots.assign(slot_count_, Slot{});
+    for (std::size_t i = 0; i < m_entries.size(); ++i) {
+      std::size_t const hash = hash_key(m_entries[i].key);
+      place(Slot{.fragment = fragment_of(hash), .index = static_cast<std::uint32_t>(i)}, hash);
+    }
+  }
+};
+
+}  // namespace life_lang
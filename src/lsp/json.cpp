@@ -0,0 +1,356 @@
+#include "json.hpp"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+
+#include "../char_class.hpp"
+
+namespace life_lang::lsp {
+
+namespace {
+
+constexpr std::size_t k_max_depth = 512;  // Deeper nesting is rejected instead of exhausting the stack
+
+Json const& null_json() {
+  static Json const null;
+  return null;
+}
+
+void append_utf8(std::string& out_, std::uint32_t code_point_) {
+  if (code_point_ < 0x80) {
+    out_ += static_cast<char>(code_point_);
+  } else if (code_point_ < 0x800) {
+    out_ += static_cast<char>(0xC0 | (code_point_ >> 6));
+    out_ += static_cast<char>(0x80 | (code_point_ & 0x3F));
+  } else if (code_point_ < 0x10000) {
+    out_ += static_cast<char>(0xE0 | (code_point_ >> 12));
+    out_ += static_cast<char>(0x80 | ((code_point_ >> 6) & 0x3F));
+    out_ += static_cast<char>(0x80 | (code_point_ & 0x3F));
+  } else {
+    out_ += static_cast<char>(0xF0 | (code_point_ >> 18));
+    out_ += static_cast<char>(0x80 | ((code_point_ >> 12) & 0x3F));
+    out_ += static_cast<char>(0x80 | ((code_point_ >> 6) & 0x3F));
+    out_ += static_cast<char>(0x80 | (code_point_ & 0x3F));
+  }
+}
+
+void append_escaped(std::string& out_, std::string_view text_) {
+  constexpr std::string_view k_hex = "0123456789abcdef";
+  out_ += '"';
+  for (char const c: text_) {
+    switch (c) {
+      case '"':
+        out_ += "\\\"";
+        break;
+      case '\\':
+        out_ += "\\\\";
+        break;
+      case '\n':
+        out_ += "\\n";
+        break;
+      case '\r':
+        out_ += "\\r";
+        break;
+      case '\t':
+        out_ += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out_ += "\\u00";
+          out_ += k_hex[static_cast<unsigned char>(c) >> 4];
+          out_ += k_hex[static_cast<unsigned char>(c) & 0xF];
+        } else {
+          out_ += c;  // UTF-8 passes through
+        }
+    }
+  }
+  out_ += '"';
+}
+
+class Json_Reader {
+public:
+  explicit Json_Reader(std::string_view text_) : m_text(text_) {}
+
+  std::optional<Json> read_document() {
+    auto value = read_value(0);
+    skip_whitespace();
+    if (!value || m_pos != m_text.size()) {
+      return std::nullopt;
+    }
+    return value;
+  }
+
+private:
+  std::string_view m_text;
+  std::size_t m_pos{};
+
+  void skip_whitespace() {
+    while (m_pos < m_text.size() &&
+           (m_text[m_pos] == ' ' || m_text[m_pos] == '\t' || m_text[m_pos] == '\n' || m_text[m_pos] == '\r')) {
+      ++m_pos;
+    }
+  }
+
+  bool consume(char expected_) {
+    skip_whitespace();
+    if (m_pos < m_text.size() && m_text[m_pos] == expected_) {
+      ++m_pos;
+      return true;
+    }
+    return false;
+  }
+
+  bool consume_word(std::string_view word_) {
+    if (m_text.substr(m_pos).starts_with(word_)) {
+      m_pos += word_.size();
+      return true;
+    }
+    return false;
+  }
+
+  std::optional<Json> read_value(std::size_t depth_) {
+    skip_whitespace();
+    if (m_pos >= m_text.size() || depth_ > k_max_depth) {
+      return std::nullopt;
+    }
+    switch (m_text[m_pos]) {
+      case '{':
+        return read_object(depth_);
+      case '[':
+        return read_array(depth_);
+      case '"': {
+        auto text = read_string();
+        return text ? std::optional<Json>{std::move(*text)} : std::nullopt;
+      }
+      case 't':
+        return consume_word("true") ? std::optional<Json>{true} : std::nullopt;
+      case 'f':
+        return consume_word("false") ? std::optional<Json>{false} : std::nullopt;
+      case 'n':
+        return consume_word("null") ? std::optional<Json>{nullptr} : std::nullopt;
+      default:
+        return read_number();
+    }
+  }
+
+  std::optional<Json> read_object(std::size_t depth_) {
+    ++m_pos;  // '{'
+    Json::Object object;
+    if (consume('}')) {
+      return Json{std::move(object)};
+    }
+    do {
+      skip_whitespace();
+      if (m_pos >= m_text.size() || m_text[m_pos] != '"') {
+        return std::nullopt;
+      }
+      auto key = read_string();
+      if (!key || !consume(':')) {
+        return std::nullopt;
+      }
+      auto value = read_value(depth_ + 1);
+      if (!value) {
+        return std::nullopt;
+      }
+      object.insert_or_assign(std::move(*key), std::move(*value));
+    } while (consume(','));
+    return consume('}') ? std::optional<Json>{std::move(object)} : std::nullopt;
+  }
+
+  std::optional<Json> read_array(std::size_t depth_) {
+    ++m_pos;  // '['
+    Json::Array array;
+    if (consume(']')) {
+      return Json{std::move(array)};
+    }
+    do {
+      auto value = read_value(depth_ + 1);
+      if (!value) {
+        return std::nullopt;
+      }
+      array.push_back(std::move(*value));
+    } while (consume(','));
+    return consume(']') ? std::optional<Json>{std::move(array)} : std::nullopt;
+  }
+
+  std::optional<std::uint32_t> read_hex4() {
+    if (m_text.size() - m_pos < 4) {
+      return std::nullopt;
+    }
+    std::uint32_t value = 0;
+    auto const [end, ec] = std::from_chars(m_text.data() + m_pos, m_text.data() + m_pos + 4, value, 16);
+    if (ec != std::errc{} || end != m_text.data() + m_pos + 4) {
+      return std::nullopt;
+    }
+    m_pos += 4;
+    return value;
+  }
+
+  std::optional<std::string> read_string() {
+    ++m_pos;  // Opening quote
+    std::string out;
+    while (m_pos < m_text.size()) {
+      char const c = m_text[m_pos++];
+      if (c == '"') {
+        return out;
+      }
+      if (static_cast<unsigned char>(c) < 0x20) {
+        return std::nullopt;
+      }
+      if (c != '\\') {
+        out += c;
+        continue;
+      }
+      if (m_pos >= m_text.size()) {
+        return std::nullopt;
+      }
+      switch (m_text[m_pos++]) {
+        case '"':
+          out += '"';
+          break;
+        case '\\':
+          out += '\\';
+          break;
+        case '/':
+          out += '/';
+          break;
+        case 'b':
+          out += '\b';
+          break;
+        case 'f':
+          out += '\f';
+          break;
+        case 'n':
+          out += '\n';
+          break;
+        case 'r':
+          out += '\r';
+          break;
+        case 't':
+          out += '\t';
+          break;
+        case 'u': {
+          auto code_point = read_hex4();
+          if (!code_point) {
+            return std::nullopt;
+          }
+          // A high surrogate followed by an escaped low surrogate is one code point
+          if (*code_point >= 0xD800 && *code_point < 0xDC00 && m_text.substr(m_pos).starts_with("\\u")) {
+            auto const saved = m_pos;
+            m_pos += 2;
+            auto const low = read_hex4();
+            if (low && *low >= 0xDC00 && *low < 0xE000) {
+              *code_point = 0x10000 + ((*code_point - 0xD800) << 10) + (*low - 0xDC00);
+            } else {
+              m_pos = saved;
+            }
+          }
+          if (*code_point >= 0xD800 && *code_point < 0xE000) {
+            *code_point = 0xFFFD;  // Lone surrogate
+          }
+          append_utf8(out, *code_point);
+          break;
+        }
+        default:
+          return std::nullopt;
+      }
+    }
+    return std::nullopt;
+  }
+
+  std::optional<Json> read_number() {
+    auto const start = m_pos;
+    if (m_pos < m_text.size() && m_text[m_pos] == '-') {
+      ++m_pos;
+    }
+    while (m_pos < m_text.size() &&
+           (is_digit(m_text[m_pos]) || m_text[m_pos] == '.' || m_text[m_pos] == 'e' || m_text[m_pos] == 'E' ||
+            m_text[m_pos] == '+' || m_text[m_pos] == '-')) {
+      ++m_pos;
+    }
+    double value{};
+    auto const [end, ec] = std::from_chars(m_text.data() + start, m_text.data() + m_pos, value);
+    if (start == m_pos || ec != std::errc{} || end != m_text.data() + m_pos) {
+      return std::nullopt;
+    }
+    return Json{value};
+  }
+};
+
+}  // namespace
+
+std::optional<Json> Json::parse(std::string_view text_) { return Json_Reader{text_}.read_document(); }
+
+std::string Json::dump() const {
+  std::string out;
+  dump_to(out);
+  return out;
+}
+
+void Json::dump_to(std::string& out_) const {
+  std::visit(
+      [&out_](auto const& value_) {
+        using T = std::decay_t<decltype(value_)>;
+        if constexpr (std::same_as<T, std::nullptr_t>) {
+          out_ += "null";
+        } else if constexpr (std::same_as<T, bool>) {
+          out_ += value_ ? "true" : "false";
+        } else if constexpr (std::same_as<T, double>) {
+          if (!std::isfinite(value_)) {
+            out_ += "null";  // Not representable in JSON
+            return;
+          }
+          std::array<char, 32> buffer{};
+          auto const [end, ec] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value_);
+          out_.append(buffer.data(), end);
+        } else if constexpr (std::same_as<T, std::string>) {
+          append_escaped(out_, value_);
+        } else if constexpr (std::same_as<T, Array>) {
+          out_ += '[';
+          for (std::size_t i = 0; i < value_.size(); ++i) {
+            if (i > 0) {
+              out_ += ',';
+            }
+            value_[i].dump_to(out_);
+          }
+          out_ += ']';
+        } else {
+          out_ += '{';
+          bool first = true;
+          for (auto const& [key, member]: value_) {
+            if (!first) {
+              out_ += ',';
+            }
+            first = false;
+            append_escaped(out_, key);
+            out_ += ':';
+            member.dump_to(out_);
+          }
+          out_ += '}';
+        }
+      },
+      m_value
+  );
+}
+
+std::int64_t Json::as_int(std::int64_t fallback_) const {
+  auto const* number = as_number();
+  return number != nullptr ? static_cast<std::int64_t>(*number) : fallback_;
+}
+
+Json const& Json::operator[](std::string_view key_) const {
+  auto const* object = as_object();
+  if (object == nullptr) {
+    return null_json();
+  }
+  auto const it = object->find(key_);
+  return it != object->end() ? it->second : null_json();
+}
+
+Json const& Json::operator[](std::size_t index_) const {
+  auto const* array = as_array();
+  return array != nullptr && index_ < array->size() ? (*array)[index_] : null_json();
+}
+
+}  // namespace life_lang::lsp
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace life_lang::lsp {
+
+// ============================================================================
+// Json - The JSON values the language server exchanges with editors
+// ============================================================================
+// Just enough JSON for JSON-RPC: numbers are doubles (exact for the integers
+// LSP uses), objects keep their keys sorted, and reading a missing member or
+// an element of a non-array yields null instead of failing, so message fields
+// can be read without checking every level.
+//
+// Example:
+//   auto const message = Json::parse(R"({"id": 1, "params": {"textDocument": {"uri": "file:///a.life"}}})");
+//   std::string const* uri = (*message)["params"]["textDocument"]["uri"].as_string();
+//   Json reply = Json::Object{{"id", (*message)["id"]}, {"result", nullptr}};
+//   send(reply.dump());
+
+class Json {
+public:
+  using Array = std::vector<Json>;
+  using Object = std::map<std::string, Json, std::less<>>;
+
+  Json() = default;
+  Json(std::nullptr_t) {}                                    // NOLINT(google-explicit-constructor)
+  Json(bool value_) : m_value(value_) {}                     // NOLINT(google-explicit-constructor)
+  Json(double value_) : m_value(value_) {}                   // NOLINT(google-explicit-constructor)
+  Json(std::string value_) : m_value(std::move(value_)) {}   // NOLINT(google-explicit-constructor)
+  Json(std::string_view value_) : m_value(std::string{value_}) {}  // NOLINT(google-explicit-constructor)
+  Json(char const* value_) : m_value(std::string{value_}) {}       // NOLINT(google-explicit-constructor)
+  Json(Array value_) : m_value(std::move(value_)) {}               // NOLINT(google-explicit-constructor)
+  Json(Object value_) : m_value(std::move(value_)) {}              // NOLINT(google-explicit-constructor)
+
+  template <std::integral T>
+    requires(!std::same_as<T, bool>)
+  Json(T value_) : m_value(static_cast<double>(value_)) {}  // NOLINT(google-explicit-constructor)
+
+  // std::nullopt if text_ isn't one complete JSON value (surrounding whitespace allowed)
+  [[nodiscard]] static std::optional<Json> parse(std::string_view text_);
+
+  // Compact text, no whitespace between tokens
+  [[nodiscard]] std::string dump() const;
+
+  [[nodiscard]] bool is_null() const { return std::holds_alternative<std::nullptr_t>(m_value); }
+  [[nodiscard]] bool const* as_bool() const { return std::get_if<bool>(&m_value); }
+  [[nodiscard]] double const* as_number() const { return std::get_if<double>(&m_value); }
+  [[nodiscard]] std::string const* as_string() const { return std::get_if<std::string>(&m_value); }
+  [[nodiscard]] Array const* as_array() const { return std::get_if<Array>(&m_value); }
+  [[nodiscard]] Object const* as_object() const { return std::get_if<Object>(&m_value); }
+
+  // The number as an integer, or fallback_ if this isn't a number
+  [[nodiscard]] std::int64_t as_int(std::int64_t fallback_ = 0) const;
+
+  // Object member (null if this isn't an object or has no such key)
+  [[nodiscard]] Json const& operator[](std::string_view key_) const;
+
+  // Array element (null if this isn't an array or index_ is out of range)
+  [[nodiscard]] Json const& operator[](std::size_t index_) const;
+
+  bool operator==(Json const&) const = default;
+
+private:
+  std::variant<std::nullptr_t, bool, double, std::string, Array, Object> m_value{nullptr};
+
+  void dump_to(std::string& out_) const;
+};
+
+}  // namespace life_lang::lsp
@@ -0,0 +1,857 @@
+#include "language_server.hpp"
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <filesystem>
+#include <future>
+#include <istream>
+#include <map>
+#include <mutex>
+#include <ostream>
+#include <set>
+#include <thread>
+#include <utility>
+
+#include "../cancellation.hpp"
+#include "../char_class.hpp"
+#include "../diagnostics.hpp"
+#include "../parser/parser.hpp"
+#include "../semantic/module_loader.hpp"
+#include "../semantic/semantic_context.hpp"
+#include "../utf8.hpp"
+
+namespace life_lang::lsp {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+// JSON-RPC and LSP error codes
+constexpr int k_parse_error = -32700;
+constexpr int k_invalid_request = -32600;
+constexpr int k_method_not_found = -32601;
+constexpr int k_invalid_params = -32602;
+constexpr int k_server_not_initialized = -32002;
+constexpr int k_request_cancelled = -32800;
+constexpr int k_content_modified = -32801;
+
+constexpr int k_sync_incremental = 2;  // TextDocumentSyncKind.Incremental
+
+// LSP SymbolKind values used for module items
+enum class Symbol_Kind : std::uint8_t {
+  Namespace = 3,
+  Method = 6,
+  Enum = 10,
+  Interface = 11,
+  Function = 12,
+  Struct = 23,
+  Type_Parameter = 26,
+};
+
+// ----------------------------------------------------------------------------
+// URIs and positions
+// ----------------------------------------------------------------------------
+
+std::optional<fs::path> uri_to_path(std::string_view uri_) {
+  constexpr std::string_view k_scheme = "file://";
+  if (!uri_.starts_with(k_scheme)) {
+    return std::nullopt;
+  }
+  uri_.remove_prefix(k_scheme.size());
+  std::string path;
+  for (std::size_t i = 0; i < uri_.size(); ++i) {
+    if (uri_[i] == '%' && i + 2 < uri_.size() && is_hex_digit(uri_[i + 1]) && is_hex_digit(uri_[i + 2])) {
+      unsigned value = 0;
+      for (char const c: uri_.substr(i + 1, 2)) {
+        value = value * 16 + static_cast<unsigned>(is_digit(c) ? c - '0' : (c | 0x20) - 'a' + 10);
+      }
+      path += static_cast<char>(value);
+      i += 2;
+    } else {
+      path += uri_[i];
+    }
+  }
+  return fs::path{path};
+}
+
+std::string path_to_uri(fs::path const& path_) {
+  constexpr std::string_view k_hex = "0123456789ABCDEF";
+  std::string uri = "file://";
+  for (char const c: path_.string()) {
+    if (is_identifier_continue(c) || c == '/' || c == '.' || c == '-' || c == '~') {
+      uri += c;
+    } else {
+      uri += '%';
+      uri += k_hex[static_cast<unsigned char>(c) >> 4];
+      uri += k_hex[static_cast<unsigned char>(c) & 0xF];
+    }
+  }
+  return uri;
+}
+
+// LSP positions are 0-based lines and UTF-16 code units into the line
+Json lsp_position(Source_File const& file_, Source_Position position_) {
+  std::size_t const line = std::max<std::size_t>(position_.line, 1);
+  auto const line_start = file_.position_to_offset({.line = line, .column = 1});
+  auto const offset = std::max(file_.position_to_offset(position_), line_start);
+  auto const prefix = std::string_view{file_.source()}.substr(line_start, offset - line_start);
+  return Json::Object{{"line", line - 1}, {"character", count_utf16_units(prefix)}};
+}
+
+Json lsp_range(Source_File const& file_, Source_Range const& range_) {
+  return Json::Object{{"start", lsp_position(file_, range_.start)}, {"end", lsp_position(file_, range_.end)}};
+}
+
+std::size_t byte_offset(Source_File const& file_, Json const& position_) {
+  auto const line = position_["line"].as_int(-1);
+  if (line < 0) {
+    return 0;
+  }
+  auto const line_number = static_cast<std::size_t>(line) + 1;
+  if (line_number > file_.line_count()) {
+    return file_.source().size();
+  }
+  auto const line_start = file_.position_to_offset({.line = line_number, .column = 1});
+  auto const character = static_cast<std::size_t>(std::max<std::int64_t>(position_["character"].as_int(), 0));
+  return line_start + advance_utf16_units(file_.get_line(line_number), 0, character);
+}
+
+// ----------------------------------------------------------------------------
+// Items
+// ----------------------------------------------------------------------------
+
+std::optional<std::string_view> item_name(ast::Item const& item_) {
+  return std::visit(
+      [](auto const& stmt_) -> std::optional<std::string_view> {
+        using T = std::decay_t<decltype(stmt_)>;
+        if constexpr (std::same_as<T, std::shared_ptr<ast::Func_Def>>) {
+          return stmt_->declaration.name;
+        } else if constexpr (std::same_as<T, std::shared_ptr<ast::Struct_Def>> ||
+                             std::same_as<T, std::shared_ptr<ast::Enum_Def>> ||
+                             std::same_as<T, std::shared_ptr<ast::Trait_Def>> ||
+                             std::same_as<T, std::shared_ptr<ast::Type_Alias>>) {
+          return stmt_->name;
+        } else {
+          return std::nullopt;
+        }
+      },
+      item_.item
+  );
+}
+
+// The text that introduces an item, up to its body: "pub fn origin(): Point", "impl Display for Point"
+std::string item_header(Source_File const& file_, Source_Range const& range_) {
+  std::string_view const source = file_.source();
+  auto const begin = file_.position_to_offset(range_.start);
+  auto text = source.substr(begin, std::min(source.find('\n', begin), source.size()) - begin);
+  text = text.substr(0, std::min(text.find('{'), text.size()));
+  while (!text.empty() && is_whitespace(text.back())) {
+    text.remove_suffix(1);
+  }
+  return std::string{text};
+}
+
+Json symbol(
+    std::string name_,
+    Symbol_Kind kind_,
+    Source_File const& file_,
+    Source_Range const& range_,
+    Source_Range const& selection_,
+    Json::Array children_ = {}
+) {
+  Json::Object symbol{
+      {"name", std::move(name_)},
+      {"kind", static_cast<int>(kind_)},
+      {"range", lsp_range(file_, range_)},
+      {"selectionRange", lsp_range(file_, selection_)},
+  };
+  if (!children_.empty()) {
+    symbol.emplace("children", std::move(children_));
+  }
+  return symbol;
+}
+
+Json item_symbol(Source_File const& file_, ast::Item const& item_) {
+  return std::visit(
+      [&](auto const& stmt_) -> Json {
+        using T = std::decay_t<decltype(stmt_)>;
+        auto const method_symbols = [&](auto const& methods_) {
+          Json::Array children;
+          for (auto const& method: methods_) {
+            if constexpr (std::same_as<std::decay_t<decltype(method)>, ast::Func_Def>) {
+              children.push_back(
+                  symbol(method.declaration.name, Symbol_Kind::Method, file_, method.span, method.declaration.span)
+              );
+            } else {
+              children.push_back(symbol(method.name, Symbol_Kind::Method, file_, method.span, method.span));
+            }
+          }
+          return children;
+        };
+        if constexpr (std::same_as<T, std::shared_ptr<ast::Func_Def>>) {
+          return symbol(stmt_->declaration.name, Symbol_Kind::Function, file_, item_.span, stmt_->declaration.span);
+        } else if constexpr (std::same_as<T, std::shared_ptr<ast::Struct_Def>>) {
+          return symbol(stmt_->name, Symbol_Kind::Struct, file_, item_.span, stmt_->span);
+        } else if constexpr (std::same_as<T, std::shared_ptr<ast::Enum_Def>>) {
+          return symbol(stmt_->name, Symbol_Kind::Enum, file_, item_.span, stmt_->span);
+        } else if constexpr (std::same_as<T, std::shared_ptr<ast::Type_Alias>>) {
+          return symbol(stmt_->name, Symbol_Kind::Type_Parameter, file_, item_.span, stmt_->span);
+        } else if constexpr (std::same_as<T, std::shared_ptr<ast::Trait_Def>>) {
+          return symbol(
+              stmt_->name, Symbol_Kind::Interface, file_, item_.span, stmt_->span, method_symbols(stmt_->methods)
+          );
+        } else if constexpr (std::same_as<T, std::shared_ptr<ast::Impl_Block>> ||
+                             std::same_as<T, std::shared_ptr<ast::Trait_Impl>>) {
+          return symbol(
+              item_header(file_, stmt_->span),
+              Symbol_Kind::Namespace,
+              file_,
+              item_.span,
+              stmt_->span,
+              method_symbols(stmt_->methods)
+          );
+        } else {
+          return nullptr;
+        }
+      },
+      item_.item
+  );
+}
+
+// The (possibly module-qualified) name under the cursor: "Point", "Geometry.Point", "origin".
+// Qualifiers are only taken while they look like module names, so "p.x" yields "x".
+std::optional<std::string> name_at(std::string_view source_, std::size_t offset_) {
+  auto begin = std::min(offset_, source_.size());
+  auto end = begin;
+  while (begin > 0 && is_identifier_continue(source_[begin - 1])) {
+    --begin;
+  }
+  while (end < source_.size() && is_identifier_continue(source_[end])) {
+    ++end;
+  }
+  if (begin == end || !is_identifier_start(source_[begin])) {
+    return std::nullopt;
+  }
+  while (begin >= 2 && source_[begin - 1] == '.') {
+    auto qualifier = begin - 1;
+    while (qualifier > 0 && is_identifier_continue(source_[qualifier - 1])) {
+      --qualifier;
+    }
+    if (qualifier == begin - 1 || !is_upper(source_[qualifier])) {
+      break;
+    }
+    begin = qualifier;
+  }
+  return std::string{source_.substr(begin, end - begin)};
+}
+
+// ----------------------------------------------------------------------------
+// State
+// ----------------------------------------------------------------------------
+
+struct Document {
+  fs::path path;
+  std::string module_path;  // Dot-separated module the file belongs to (empty outside src/)
+  std::int64_t version{};
+  Source_File_Registry registry;
+  File_Id file{};
+  std::optional<ast::Module> module;  // Parse of the current text; std::nullopt while it doesn't parse
+  std::vector<Diagnostic> diagnostics;
+
+  [[nodiscard]] Source_File const& source() const { return *registry.get_file(file); }
+};
+
+// The src/ tree, loaded and indexed off the main thread
+struct Workspace_Index {
+  Diagnostic_Manager diagnostics;
+  semantic::Semantic_Context context{diagnostics};
+};
+
+// Where a name is defined
+struct Definition {
+  std::string module_path;
+  ast::Item const* item{};
+  Source_File const* file{};
+  fs::path path;
+};
+
+}  // namespace
+
+struct Language_Server::Impl {
+  Send send;
+  std::optional<fs::path> src_root;
+  bool initialized{false};
+  bool shutdown{false};
+  bool exit{false};
+
+  std::map<std::string, std::unique_ptr<Document>, std::less<>> documents;
+  std::unique_ptr<parser::Parser> parser;  // Rebound to each parse; keeps its allocations
+
+  std::unique_ptr<Workspace_Index> index;
+  std::future<std::unique_ptr<Workspace_Index>> pending_index;
+  std::shared_ptr<Cancellation_Token> index_cancel;
+  std::vector<fs::path> pending_saves;  // Saved while the index was loading; applied once it is adopted
+
+  explicit Impl(Send send_) : send(std::move(send_)) {}
+
+  void reply(Json const& id_, Json result_) const {
+    send(Json{Json::Object{{"jsonrpc", "2.0"}, {"id", id_}, {"result", std::move(result_)}}}.dump());
+  }
+
+  void reply_error(Json const& id_, int code_, std::string message_) const {
+    Json::Object error{{"code", code_}, {"message", std::move(message_)}};
+    send(Json{Json::Object{{"jsonrpc", "2.0"}, {"id", id_}, {"error", std::move(error)}}}.dump());
+  }
+
+  void notify(std::string method_, Json params_) const {
+    send(Json{Json::Object{{"jsonrpc", "2.0"}, {"method", std::move(method_)}, {"params", std::move(params_)}}}.dump()
+    );
+  }
+
+  [[nodiscard]] Document* find_document(Json const& params_) {
+    auto const* uri = params_["textDocument"]["uri"].as_string();
+    if (uri == nullptr) {
+      return nullptr;
+    }
+    auto const it = documents.find(*uri);
+    return it != documents.end() ? it->second.get() : nullptr;
+  }
+
+  void parse_document(Document& document_, Text_Edit const* edit_, Source_Position removed_end_);
+  void start_indexing();
+  bool adopt_index();
+  void apply_saves(std::vector<fs::path> paths_);
+
+  void handle(
+      Json const& message_,
+      std::size_t position_,
+      std::map<std::string, std::size_t, std::less<>> const& last_edits_,
+      std::set<std::string> const& cancelled_,
+      std::set<std::string>& edited_
+  );
+  void handle_request(std::string_view method_, Json const& id_, Json const& params_);
+  void handle_notification(std::string_view method_, Json const& params_, std::set<std::string>& edited_);
+
+  void initialize(Json const& id_, Json const& params_);
+  void did_open(Json const& params_);
+  void did_change(Json const& params_);
+  void publish_diagnostics(std::string const& uri_);
+  [[nodiscard]] std::optional<Definition> find_definition(Document const& document_, Json const& position_);
+  [[nodiscard]] std::optional<std::pair<std::string, ast::Item const*>>
+  resolve_in_index(std::string const& module_path_, std::string const& name_) const;
+};
+
+void Language_Server::Impl::parse_document(Document& document_, Text_Edit const* edit_, Source_Position removed_end_) {
+  Diagnostic_Engine diagnostics{document_.registry, document_.file};
+  if (parser == nullptr) {
+    parser = std::make_unique<parser::Parser>(diagnostics);
+  } else {
+    parser->reset(diagnostics);
+  }
+  if (edit_ != nullptr && document_.module) {
+    document_.module = parser->reparse_module(*document_.module, *edit_, removed_end_);
+  } else {
+    document_.module = parser->parse_module();
+  }
+  document_.diagnostics = diagnostics.take_diagnostics();
+}
+
+// Load the whole src/ tree on a background thread; a tree that fails to load leaves no index
+// until a save starts another attempt
+void Language_Server::Impl::start_indexing() {
+  if (!src_root || pending_index.valid()) {
+    return;
+  }
+  index_cancel = std::make_shared<Cancellation_Token>();
+  pending_index = std::async(std::launch::async, [root = *src_root, cancel = index_cancel] {
+    auto loaded = std::make_unique<Workspace_Index>();
+    if (loaded->context.load_modules(root, *cancel) != semantic::Load_Status::Ok) {
+      return std::unique_ptr<Workspace_Index>{};
+    }
+    loaded->diagnostics.clear_diagnostics();
+    return loaded;
+  });
+}
+
+bool Language_Server::Impl::adopt_index() {
+  if (!pending_index.valid() ||
+      pending_index.wait_for(std::chrono::seconds{0}) != std::future_status::ready) {
+    return false;
+  }
+  index = pending_index.get();
+  if (index != nullptr && !pending_saves.empty()) {
+    apply_saves(std::exchange(pending_saves, {}));
+  }
+  pending_saves.clear();
+  return index != nullptr;
+}
+
+void Language_Server::Impl::apply_saves(std::vector<fs::path> paths_) {
+  if (pending_index.valid()) {
+    pending_saves.insert(pending_saves.end(), paths_.begin(), paths_.end());
+    return;
+  }
+  if (index == nullptr) {
+    start_indexing();  // The last load failed; the saved file may have fixed it
+    return;
+  }
+  index->context.update(paths_);
+  index->diagnostics.clear_diagnostics();  // Open documents report their own parse errors
+}
+
+void Language_Server::Impl::handle(
+    Json const& message_,
+    std::size_t position_,
+    std::map<std::string, std::size_t, std::less<>> const& last_edits_,
+    std::set<std::string> const& cancelled_,
+    std::set<std::string>& edited_
+) {
+  auto const* method = message_["method"].as_string();
+  if (method == nullptr) {
+    return;  // A response; the server sends no requests
+  }
+  auto const& params = message_["params"];
+  auto const* object = message_.as_object();
+  if (object == nullptr || !object->contains("id")) {
+    handle_notification(*method, params, edited_);
+    return;
+  }
+
+  auto const& id = message_["id"];
+  if (cancelled_.contains(id.dump())) {
+    reply_error(id, k_request_cancelled, "request cancelled");
+    return;
+  }
+  if (auto const* uri = params["textDocument"]["uri"].as_string()) {
+    auto const edit = last_edits_.find(*uri);
+    if (edit != last_edits_.end() && edit->second > position_) {
+      reply_error(id, k_content_modified, "document changed");  // The client asks again for the new text
+      return;
+    }
+  }
+  if (!initialized && *method != "initialize") {
+    reply_error(id, k_server_not_initialized, "server not initialized");
+    return;
+  }
+  if (shutdown) {
+    reply_error(id, k_invalid_request, "server is shutting down");
+    return;
+  }
+  handle_request(*method, id, params);
+}
+
+void Language_Server::Impl::handle_request(std::string_view method_, Json const& id_, Json const& params_) {
+  if (method_ == "initialize") {
+    initialize(id_, params_);
+    return;
+  }
+  if (method_ == "shutdown") {
+    shutdown = true;
+    if (index_cancel != nullptr) {
+      index_cancel->cancel();
+    }
+    reply(id_, nullptr);
+    return;
+  }
+
+  auto const* document = find_document(params_);
+  if (method_ == "textDocument/documentSymbol") {
+    if (document == nullptr) {
+      reply_error(id_, k_invalid_params, "document is not open");
+      return;
+    }
+    Json::Array symbols;
+    if (document->module) {
+      for (auto const& item: document->module->items) {
+        if (auto item_symbol_json = item_symbol(document->source(), item); !item_symbol_json.is_null()) {
+          symbols.push_back(std::move(item_symbol_json));
+        }
+      }
+    }
+    reply(id_, std::move(symbols));
+    return;
+  }
+  if (method_ == "textDocument/definition" || method_ == "textDocument/hover") {
+    if (document == nullptr) {
+      reply_error(id_, k_invalid_params, "document is not open");
+      return;
+    }
+    auto const definition = find_definition(*document, params_["position"]);
+    if (!definition) {
+      reply(id_, nullptr);
+      return;
+    }
+    auto const& span = definition->item->span;
+    if (method_ == "textDocument/definition") {
+      reply(
+          id_,
+          Json::Object{{"uri", path_to_uri(definition->path)}, {"range", lsp_range(*definition->file, span)}}
+      );
+      return;
+    }
+    std::string text = "```life\n" + item_header(*definition->file, span) + "\n```";
+    if (!definition->module_path.empty()) {
+      text += "\n\nmodule `" + definition->module_path + "`";
+    }
+    reply(id_, Json::Object{{"contents", Json::Object{{"kind", "markdown"}, {"value", std::move(text)}}}});
+    return;
+  }
+  reply_error(id_, k_method_not_found, "unsupported method " + std::string{method_});
+}
+
+void Language_Server::Impl::initialize(Json const& id_, Json const& params_) {
+  std::optional<fs::path> root;
+  if (auto const* uri = params_["rootUri"].as_string()) {
+    root = uri_to_path(*uri);
+  } else if (auto const* folder = params_["workspaceFolders"][0]["uri"].as_string()) {
+    root = uri_to_path(*folder);
+  } else if (auto const* path = params_["rootPath"].as_string()) {
+    root = fs::path{*path};
+  }
+  if (root) {
+    std::error_code ec;
+    src_root = fs::is_directory(*root / "src", ec) ? *root / "src" : *root;
+  }
+  initialized = true;
+
+  Json::Object capabilities{
+      {"textDocumentSync",
+       Json::Object{{"openClose", true}, {"change", k_sync_incremental}, {"save", Json::Object{}}}},
+      {"documentSymbolProvider", true},
+      {"definitionProvider", true},
+      {"hoverProvider", true},
+  };
+  reply(
+      id_,
+      Json::Object{{"capabilities", std::move(capabilities)}, {"serverInfo", Json::Object{{"name", "lifec-lsp"}}}}
+  );
+}
+
+void Language_Server::Impl::handle_notification(
+    std::string_view method_,
+    Json const& params_,
+    std::set<std::string>& edited_
+) {
+  if (method_ == "exit") {
+    exit = true;
+    return;
+  }
+  if (method_ == "initialized") {
+    start_indexing();
+    return;
+  }
+  auto const* uri = params_["textDocument"]["uri"].as_string();
+  if (uri == nullptr) {
+    return;
+  }
+  if (method_ == "textDocument/didOpen") {
+    did_open(params_);
+    edited_.insert(*uri);
+  } else if (method_ == "textDocument/didChange") {
+    did_change(params_);
+    edited_.insert(*uri);
+  } else if (method_ == "textDocument/didSave") {
+    if (auto const path = uri_to_path(*uri)) {
+      apply_saves({*path});
+    }
+  } else if (method_ == "textDocument/didClose") {
+    documents.erase(*uri);
+    edited_.erase(*uri);
+    notify("textDocument/publishDiagnostics", Json::Object{{"uri", *uri}, {"diagnostics", Json::Array{}}});
+  }
+}
+
+void Language_Server::Impl::did_open(Json const& params_) {
+  auto const& item = params_["textDocument"];
+  auto const* uri = item["uri"].as_string();
+  auto const* text = item["text"].as_string();
+  auto path = uri_to_path(*uri);
+  if (text == nullptr || !path) {
+    return;
+  }
+  auto document = std::make_unique<Document>();
+  document->path = std::move(*path);
+  document->version = item["version"].as_int();
+  document->file = document->registry.register_file(document->path.string(), *text);
+  if (src_root) {
+    if (auto const descriptor = semantic::Module_Loader::describe_directory(*src_root, document->path.parent_path())) {
+      document->module_path = descriptor->module_path_string();
+    }
+  }
+  parse_document(*document, nullptr, {});
+  documents.insert_or_assign(*uri, std::move(document));
+}
+
+void Language_Server::Impl::did_change(Json const& params_) {
+  auto* document = find_document(params_);
+  auto const* changes = params_["contentChanges"].as_array();
+  if (document == nullptr || changes == nullptr) {
+    return;
+  }
+  document->version = params_["textDocument"]["version"].as_int(document->version);
+  for (auto const& change: *changes) {
+    auto const* text = change["text"].as_string();
+    if (text == nullptr) {
+      continue;
+    }
+    if (change["range"].is_null()) {
+      document->registry.set_source(document->file, *text);
+      parse_document(*document, nullptr, {});
+      continue;
+    }
+    auto const& file = document->source();
+    auto start = byte_offset(file, change["range"]["start"]);
+    auto end = byte_offset(file, change["range"]["end"]);
+    if (end < start) {
+      std::swap(start, end);
+    }
+    Text_Edit const edit{.offset = start, .removed_length = end - start, .inserted = *text};
+    auto const removed_end = file.offset_to_position(end);  // Old spans are mapped through it
+    document->registry.apply_edit(document->file, edit);
+    parse_document(*document, &edit, removed_end);
+  }
+}
+
+void Language_Server::Impl::publish_diagnostics(std::string const& uri_) {
+  auto const it = documents.find(uri_);
+  if (it == documents.end()) {
+    return;
+  }
+  auto const& document = *it->second;
+  Json::Array diagnostics;
+  for (auto const& diagnostic: document.diagnostics) {
+    int const severity = diagnostic.level == Diagnostic_Level::Error     ? 1
+                         : diagnostic.level == Diagnostic_Level::Warning ? 2
+                                                                         : 3;
+    diagnostics.emplace_back(Json::Object{
+        {"range", lsp_range(document.source(), diagnostic.range)},
+        {"severity", severity},
+        {"source", "lifec"},
+        {"message", diagnostic.message},
+    });
+  }
+  notify(
+      "textDocument/publishDiagnostics",
+      Json::Object{{"uri", uri_}, {"version", document.version}, {"diagnostics", std::move(diagnostics)}}
+  );
+}
+
+// The item a name under the cursor refers to: a top-level item of the document itself (as
+// currently typed), else whatever the workspace index resolves it to from the document's module
+std::optional<Definition> Language_Server::Impl::find_definition(Document const& document_, Json const& position_) {
+  auto const& file = document_.source();
+  auto const name = name_at(file.source(), byte_offset(file, position_));
+  if (!name) {
+    return std::nullopt;
+  }
+  if (document_.module && name->find('.') == std::string::npos) {
+    for (auto const& item: document_.module->items) {
+      if (item_name(item) == *name) {
+        return Definition{.module_path = document_.module_path, .item = &item, .file = &file, .path = document_.path};
+      }
+    }
+  }
+  if (index == nullptr || document_.module_path.empty()) {
+    return std::nullopt;
+  }
+  auto const resolved = resolve_in_index(document_.module_path, *name);
+  if (!resolved || resolved->second == nullptr) {
+    return std::nullopt;  // Unknown, or a built-in type
+  }
+  auto const target = resolved->second->span.file;
+  auto const& registry = index->diagnostics.registry();
+  return Definition{
+      .module_path = resolved->first,
+      .item = resolved->second,
+      .file = registry.get_file(target),
+      .path = fs::path{registry.get_path(target)},
+  };
+}
+
+// Resolve name_ as written in module_path_: as a type name first, then as a function or variable name
+std::optional<std::pair<std::string, ast::Item const*>>
+Language_Server::Impl::resolve_in_index(std::string const& module_path_, std::string const& name_) const {
+  Source_File_Registry registry;
+  File_Id const file_id = registry.register_file("<name>", name_);
+  std::optional<std::pair<std::string, ast::Item const*>> resolved;
+  {
+    Diagnostic_Engine diagnostics{registry, file_id};
+    parser::Parser name_parser{diagnostics};
+    if (auto const type_name = name_parser.parse_type_name(); type_name && name_parser.all_input_consumed()) {
+      resolved = index->context.resolve_type_name(module_path_, *type_name);
+    }
+  }
+  if (!resolved) {
+    Diagnostic_Engine diagnostics{registry, file_id};
+    parser::Parser name_parser{diagnostics};
+    if (auto const var_name = name_parser.parse_qualified_variable_name();
+        var_name && name_parser.all_input_consumed()) {
+      resolved = index->context.resolve_var_name(module_path_, *var_name);
+    }
+  }
+  index->diagnostics.clear_diagnostics();  // Misses are answered with null, not reported
+  return resolved;
+}
+
+Language_Server::Language_Server(Send send_) : m_impl(std::make_unique<Impl>(std::move(send_))) {}
+
+Language_Server::~Language_Server() {
+  if (m_impl->index_cancel != nullptr) {
+    m_impl->index_cancel->cancel();
+  }
+  if (m_impl->pending_index.valid()) {
+    m_impl->pending_index.wait();
+  }
+}
+
+void Language_Server::handle_batch(std::vector<Json> const& messages_) {
+  // Look ahead: the last edit of each document and the cancelled request ids
+  std::map<std::string, std::size_t, std::less<>> last_edits;
+  std::set<std::string> cancelled;
+  for (std::size_t i = 0; i < messages_.size(); ++i) {
+    auto const* method = messages_[i]["method"].as_string();
+    if (method == nullptr) {
+      continue;
+    }
+    if (*method == "textDocument/didChange") {
+      if (auto const* uri = messages_[i]["params"]["textDocument"]["uri"].as_string()) {
+        last_edits.insert_or_assign(*uri, i);
+      }
+    } else if (*method == "$/cancelRequest") {
+      cancelled.insert(messages_[i]["params"]["id"].dump());
+    }
+  }
+
+  std::set<std::string> edited;
+  m_impl->adopt_index();
+  for (std::size_t i = 0; i < messages_.size() && !m_impl->exit; ++i) {
+    m_impl->handle(messages_[i], i, last_edits, cancelled, edited);
+  }
+  for (auto const& uri: edited) {
+    m_impl->publish_diagnostics(uri);
+  }
+}
+
+bool Language_Server::poll_index() { return m_impl->adopt_index(); }
+
+void Language_Server::wait_for_index() {
+  if (m_impl->pending_index.valid()) {
+    m_impl->pending_index.wait();
+    m_impl->adopt_index();
+  }
+}
+
+bool Language_Server::exit_requested() const { return m_impl->exit; }
+
+int Language_Server::exit_code() const { return m_impl->shutdown ? 0 : 1; }
+
+int Language_Server::run(std::istream& in_, std::ostream& out_) {
+  // Messages are read and parsed on their own thread so that everything that arrived while a batch
+  // was being handled forms the next batch. The reader stops after exit (nothing may follow it) or
+  // at end of input, and is joined before returning: in_ is only borrowed.
+  struct Inbox {
+    std::mutex mutex;
+    std::condition_variable ready;
+    std::deque<std::optional<Json>> messages;  // std::nullopt for a body that isn't valid JSON
+    bool closed{false};
+  };
+  Inbox inbox;
+  std::jthread reader{[&inbox, &in_] {
+    bool exit = false;
+    while (!exit) {
+      auto body = read_message(in_);
+      if (!body) {
+        break;
+      }
+      auto message = Json::parse(*body);
+      if (message) {
+        auto const* method = (*message)["method"].as_string();
+        exit = method != nullptr && *method == "exit";
+      }
+      std::scoped_lock const lock{inbox.mutex};
+      inbox.messages.push_back(std::move(message));
+      inbox.ready.notify_one();
+    }
+    std::scoped_lock const lock{inbox.mutex};
+    inbox.closed = true;
+    inbox.ready.notify_one();
+  }};
+
+  Language_Server server{[&out_](std::string const& message_) { write_message(out_, message_); }};
+  constexpr auto k_index_poll = std::chrono::milliseconds{50};
+  while (!server.exit_requested()) {
+    std::deque<std::optional<Json>> messages;
+    bool closed = false;
+    {
+      std::unique_lock lock{inbox.mutex};
+      inbox.ready.wait_for(lock, k_index_poll, [&] { return !inbox.messages.empty() || inbox.closed; });
+      messages.swap(inbox.messages);
+      closed = inbox.closed;
+    }
+    std::vector<Json> batch;
+    for (auto& message: messages) {
+      if (message) {
+        batch.push_back(std::move(*message));
+      } else {
+        Json::Object error{{"code", k_parse_error}, {"message", "invalid JSON"}};
+        Json const reply = Json::Object{{"jsonrpc", "2.0"}, {"id", nullptr}, {"error", std::move(error)}};
+        write_message(out_, reply.dump());
+      }
+    }
+    if (!batch.empty()) {
+      server.handle_batch(batch);
+    }
+    server.poll_index();
+    if (closed && messages.empty()) {
+      break;
+    }
+  }
+  // Either exit was handled (the reader stopped right after reading it) or the input ended
+  reader.join();
+  return server.exit_requested() ? server.exit_code() : 1;
+}
+
+std::optional<std::string> read_message(std::istream& in_) {
+  constexpr std::string_view k_length_header = "Content-Length:";
+  std::optional<std::size_t> length;
+  std::string line;
+  while (std::getline(in_, line)) {
+    if (!line.empty() && line.back() == '\r') {
+      line.pop_back();
+    }
+    if (line.empty()) {
+      break;
+    }
+    if (line.starts_with(k_length_header)) {
+      std::size_t value = 0;
+      auto digits = std::string_view{line}.substr(k_length_header.size());
+      while (!digits.empty() && digits.front() == ' ') {
+        digits.remove_prefix(1);
+      }
+      auto const [end, ec] = std::from_chars(digits.data(), digits.data() + digits.size(), value);
+      if (ec != std::errc{} || end != digits.data() + digits.size()) {
+        return std::nullopt;
+      }
+      length = value;
+    }
+  }
+  if (!in_ || !length) {
+    return std::nullopt;
+  }
+  std::string body(*length, '\0');
+  if (!in_.read(body.data(), static_cast<std::streamsize>(*length))) {
+    return std::nullopt;
+  }
+  return body;
+}
+
+void write_message(std::ostream& out_, std::string_view body_) {
+  out_ << "Content-Length: " << body_.size() << "\r\n\r\n" << body_;
+  out_.flush();
+}
+
+}  // namespace life_lang::lsp
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <functional>
+#include <iosfwd>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "json.hpp"
+
+namespace life_lang::lsp {
+
+// ============================================================================
+// Language_Server - LSP for .life files, on the compiler's own structures
+// ============================================================================
+// Open documents live in their own Source_File_Registry: every didChange edit
+// is applied in place (Source_File::apply_edit) and the document is reparsed
+// with Parser::reparse_module, which only parses the items the edit touched.
+// The workspace's src/ tree is indexed by a Semantic_Context loaded on a
+// background thread; open-document work never waits for it. Saving a document
+// updates the index for that module only (Semantic_Context::update).
+//
+// Supported: initialize/shutdown/exit, didOpen/didChange (incremental sync)/
+// didSave/didClose, publishDiagnostics, documentSymbol, definition, hover and
+// $/cancelRequest.
+//
+// Messages are handled in batches (everything the client sent while the
+// server was busy): edits are applied in order, diagnostics are published
+// once per edited document at the end of the batch, and a request about a
+// document that a later message of the batch edits, or that the batch
+// cancels, is answered with an error instead of being computed.
+//
+// Example:
+//   return Language_Server::run(std::cin, std::cout);  // lifec-lsp
+
+class Language_Server {
+public:
+  // Receives each outgoing JSON-RPC message (the body, without the Content-Length header)
+  using Send = std::function<void(std::string const& message_)>;
+
+  explicit Language_Server(Send send_);
+
+  // Non-copyable, non-movable (the background index refers back to the server's state)
+  Language_Server(Language_Server const&) = delete;
+  Language_Server& operator=(Language_Server const&) = delete;
+  Language_Server(Language_Server&&) = delete;
+  Language_Server& operator=(Language_Server&&) = delete;
+
+  // Cancels background indexing and waits for it
+  ~Language_Server();
+
+  void handle_batch(std::vector<Json> const& messages_);
+
+  // Start using the background index once it has finished; false while it is still loading
+  bool poll_index();
+
+  // Block until background indexing (if started) has finished and is in use
+  void wait_for_index();
+
+  [[nodiscard]] bool exit_requested() const;
+
+  // Process exit code once exit_requested(): 0 if shutdown came first, as LSP specifies
+  [[nodiscard]] int exit_code() const;
+
+  // Serve LSP messages from in_ until exit or end of input; returns the process exit code
+  static int run(std::istream& in_, std::ostream& out_);
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+// Read one Content-Length framed message body; std::nullopt at end of input or on a malformed header
+[[nodiscard]] std::optional<std::string> read_message(std::istream& in_);
+
+// Write one message body with its Content-Length header and flush
+void write_message(std::ostream& out_, std::string_view body_);
+
+}  // namespace life_lang::lsp
@@ -0,0 +1,9 @@
+#include <iostream>
+
+#include "lsp/language_server.hpp"
+
+// Language server for .life files: LSP over stdin/stdout
+int main() {
+  std::ios::sync_with_stdio(false);
+  return life_lang::lsp::Language_Server::run(std::cin, std::cout);
+}
@@ -1,13 +1,118 @@
+#include <unistd.h>
+
+#include <algorithm>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <filesystem>
 #include <format>
 #include <iostream>
+#include <optional>
+#include <set>
 #include <string>
 #include <string_view>
+#include <vector>
 
+#include "cancellation.hpp"
 #include "diagnostics.hpp"
 #include "parser/parser.hpp"
 #include "parser/sexp.hpp"
+#include "semantic/module_interface.hpp"
+#include "semantic/module_loader.hpp"
+#include "semantic/semantic_context.hpp"
+#include "server/compile_server.hpp"
+#include "server/source_watcher.hpp"
+#include "thread_pool.hpp"
 #include "version.hpp"
 
+namespace {
+
+namespace fs = std::filesystem;
+
+// Environment variable naming the socket of a running `lifec --server`
+constexpr char const* k_server_socket_env = "LIFEC_SERVER_SOCKET";
+
+// Fired by SIGINT/SIGTERM to end --server and --watch
+life_lang::Cancellation_Token g_stop;
+
+extern "C" void request_stop(int /*signal_*/) { g_stop.cancel(); }
+
+// Answer a check/parse/resolve request: by the server named in LIFEC_SERVER_SOCKET if one is
+// running there and serves this tree, else in this process
+int run_request(life_lang::server::Request const& request_, fs::path const& src_root_) {
+  using life_lang::server::Reply_Status;
+  std::optional<life_lang::server::Reply> reply;
+  if (char const* socket = std::getenv(k_server_socket_env); socket != nullptr && *socket != '\0') {
+    reply = life_lang::server::send_request(socket, request_);
+  }
+  if (!reply || reply->status == Reply_Status::Rejected) {
+    life_lang::server::Compile_Server local{src_root_, {}};
+    reply = local.handle(request_);
+  }
+  bool const ok = reply->status == Reply_Status::Ok;
+  (ok && request_.command != "check" ? std::cout : std::cerr) << reply->output;
+  return ok ? 0 : (reply->status == Reply_Status::Failed ? 1 : 2);
+}
+
+// Keep src_root_ loaded and, after every settled batch of saves, update only the modules of the
+// changed files and print what that found
+int run_watch(fs::path const& src_root_) {
+  auto watcher = life_lang::server::Source_Watcher::open(src_root_);
+  if (!watcher) {
+    std::cerr << std::format("cannot watch {}\n", src_root_.string());
+    return 1;
+  }
+  life_lang::Diagnostic_Manager diagnostics;
+  life_lang::semantic::Semantic_Context context{diagnostics};
+  bool loaded = context.load_modules(watcher->src_root());
+  diagnostics.print(std::cerr);
+  diagnostics.clear_diagnostics();
+  std::cout << std::format(
+      "watching {} modules under {}{}\n",
+      watcher->modules().size(),
+      watcher->src_root().string(),
+      loaded ? "" : " (fix the errors above)"
+  ) << std::flush;
+
+  std::set<fs::path> failed;  // Files of a failed update, retried with the next batch until they load
+  while (auto batch = watcher->wait_for_changes(g_stop)) {
+    auto const start = std::chrono::steady_clock::now();
+    failed.insert(batch->begin(), batch->end());
+    std::vector<fs::path> const changed(failed.begin(), failed.end());
+    bool const ok = loaded ? context.update(changed) : context.load_modules(watcher->src_root());
+    loaded = loaded || ok;
+    if (ok) {
+      failed.clear();
+    }
+    auto const elapsed =
+        std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    std::set<std::string> module_names;
+    auto const modules = watcher->modules();
+    for (auto const& path: *batch) {
+      auto const module =
+          std::ranges::find(modules, path.parent_path(), &life_lang::semantic::Module_Descriptor::directory);
+      module_names.insert(module != modules.end() ? module->module_path_string() : "(removed)");
+    }
+    std::string names;
+    for (auto const& name: module_names) {
+      names += names.empty() ? name : ", " + name;
+    }
+    diagnostics.print(std::cerr);
+    std::cout << std::format(
+        "{} changed file(s) in {}: {} ({} ms)\n",
+        batch->size(),
+        names,
+        ok && !diagnostics.has_errors() ? "ok" : "errors",
+        elapsed.count()
+    ) << std::flush;
+    diagnostics.clear_diagnostics();
+  }
+  return 0;
+}
+
+}  // namespace
+
 int main(int argc, char* argv[]) {
   // Handle command line arguments
   if (argc > 1) {
@@ -22,8 +127,64 @@ int main(int argc, char* argv[]) {
       std::cout << "  -v, --version    Show version information\n";
       std::cout << "  -h, --help       Show this help message\n";
       std::cout << "  -                Read source from stdin\n";
+      std::cout << "  --emit-interfaces <src> <out>\n";
+      std::cout << "                   Write an interface file (.lli) for every module under <src> into <out>\n";
+      std::cout << "  --check <src>    Load every module under <src> and report errors\n";
+      std::cout << "  --parse <file>   Print the AST of <file>\n";
+      std::cout << "  --resolve <src> <module> <name>\n";
+      std::cout << "                   Show where <name>, as written in <module>, is defined\n";
+      std::cout << "  --watch <src>    Check <src>, then recheck the modules of changed files as they are saved\n";
+      std::cout << "  --server <src> <socket>\n";
+      std::cout << "                   Keep <src> loaded and answer --check/--parse/--resolve over <socket>;\n";
+      std::cout << std::format("                   clients use it when {} names <socket>\n", k_server_socket_env);
+      return 0;
+    }
+    if (arg == "--emit-interfaces") {
+      if (argc != 4) {
+        std::cerr << std::format("Usage: {} --emit-interfaces <src> <out>\n", argv[0]);
+        return 2;
+      }
+      life_lang::Diagnostic_Manager diagnostics;
+      life_lang::Thread_Pool pool;
+      bool const ok = life_lang::semantic::emit_module_interfaces(argv[2], argv[3], diagnostics, pool);
+      diagnostics.print(std::cerr);
+      return ok ? 0 : 1;
+    }
+    if (arg == "--server") {
+      if (argc != 4) {
+        std::cerr << std::format("Usage: {} --server <src> <socket>\n", argv[0]);
+        return 2;
+      }
+      life_lang::server::Compile_Server server{argv[2], argv[3]};
+      if (!server.listen()) {
+        std::cerr << std::format("cannot listen on {} (in use, or not a valid socket path)\n", argv[3]);
+        return 1;
+      }
+      std::signal(SIGINT, request_stop);
+      std::signal(SIGTERM, request_stop);
+      server.serve(g_stop);
       return 0;
     }
+    if (arg == "--watch") {
+      if (argc != 3) {
+        std::cerr << std::format("Usage: {} --watch <src>\n", argv[0]);
+        return 2;
+      }
+      std::signal(SIGINT, request_stop);
+      std::signal(SIGTERM, request_stop);
+      return run_watch(argv[2]);
+    }
+    if (arg == "--check" && argc == 3) {
+      auto const src_root = fs::absolute(argv[2]);
+      return run_request({.command = "check", .args = {src_root.string()}}, src_root);
+    }
+    if (arg == "--parse" && argc == 3) {
+      return run_request({.command = "parse", .args = {fs::absolute(argv[2]).string()}}, {});
+    }
+    if (arg == "--resolve" && argc == 5) {
+      auto const src_root = fs::absolute(argv[2]);
+      return run_request({.command = "resolve", .args = {src_root.string(), argv[3], argv[4]}}, src_root);
+    }
     if (arg == "-") {
       std::string input((std::istreambuf_iterator<char>(std::cin)), std::istreambuf_iterator<char>());
 
@@ -33,9 +194,8 @@ int main(int argc, char* argv[]) {
       life_lang::parser::Parser parser{diagnostics};
       auto const result = parser.parse_module();
       if (result) {
-        // Print AST as indented S-expression (use 0 for compact)
-        std::cout << std::format("{}\n", life_lang::ast::to_sexp_string(*result, 2));
-        return 0;
+        // Print AST as indented S-expression (use 0 for compact), streamed: dumps can be huge
+        return life_lang::ast::write_sexp(STDOUT_FILENO, *result, 2) ? 0 : 1;
       }
       diagnostics.print(std::cerr);
       return 1;
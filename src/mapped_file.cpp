@@ -0,0 +1,58 @@
+#include "mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <utility>
+
+namespace life_lang {
+
+std::optional<Mapped_File> Mapped_File::open(std::filesystem::path const& path_) {
+  int const fd = ::open(path_.c_str(), O_RDONLY | O_CLOEXEC);  // NOLINT(cppcoreguidelines-pro-type-vararg)
+  if (fd < 0) {
+    return std::nullopt;
+  }
+  struct stat info{};
+  if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode)) {
+    ::close(fd);
+    return std::nullopt;
+  }
+  auto const size = static_cast<std::size_t>(info.st_size);
+  if (size == 0) {
+    ::close(fd);
+    return Mapped_File(nullptr, 0);  // mmap rejects empty mappings
+  }
+
+  void* const data = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);  // The mapping keeps the file alive
+  if (data == MAP_FAILED) {  // NOLINT(cppcoreguidelines-pro-type-cstyle-cast)
+    return std::nullopt;
+  }
+  return Mapped_File(static_cast<char const*>(data), size);
+}
+
+Mapped_File::Mapped_File(Mapped_File&& other_) noexcept
+    : m_data(std::exchange(other_.m_data, nullptr)), m_size(std::exchange(other_.m_size, 0)) {}
+
+Mapped_File& Mapped_File::operator=(Mapped_File&& other_) noexcept {
+  if (this != &other_) {
+    release();
+    m_data = std::exchange(other_.m_data, nullptr);
+    m_size = std::exchange(other_.m_size, 0);
+  }
+  return *this;
+}
+
+Mapped_File::~Mapped_File() { release(); }
+
+void Mapped_File::release() {
+  if (m_data != nullptr) {
+    ::munmap(const_cast<char*>(m_data), m_size);  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+    m_data = nullptr;
+    m_size = 0;
+  }
+}
+
+}  // namespace life_lang
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+namespace life_lang {
+
+// ============================================================================
+// Mapped_File - Read-only memory mapping of a whole file
+// ============================================================================
+// Lets readers of binary artifacts (cached ASTs, interface files) work on the
+// bytes in place instead of copying them into a buffer first; pages the reader
+// never touches are never read from disk.
+//
+// The view stays valid while the Mapped_File lives. Replacing the file through
+// rename (as the caches do) is safe; truncating it in place is not.
+//
+// Example:
+//   if (auto const file = Mapped_File::open(path)) {
+//     decode(file->bytes());
+//   }
+
+class Mapped_File {
+public:
+  // std::nullopt if the file can't be opened or mapped; an empty file maps to an empty view
+  [[nodiscard]] static std::optional<Mapped_File> open(std::filesystem::path const& path_);
+
+  // Move-only (the mapping is released exactly once)
+  Mapped_File(Mapped_File const&) = delete;
+  Mapped_File& operator=(Mapped_File const&) = delete;
+  Mapped_File(Mapped_File&& other_) noexcept;
+  Mapped_File& operator=(Mapped_File&& other_) noexcept;
+  ~Mapped_File();
+
+  [[nodiscard]] std::string_view bytes() const { return {m_data, m_size}; }
+
+private:
+  Mapped_File(char const* data_, std::size_t size_) : m_data(data_), m_size(size_) {}
+
+  void release();
+
+  char const* m_data = nullptr;
+  std::size_t m_size = 0;
+};
+
+}  // namespace life_lang
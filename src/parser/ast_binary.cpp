@@ -0,0 +1,725 @@
+#include "ast_binary.hpp"
+
+#include <concepts>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+#include "../content_hash.hpp"
+#include "../flat_string_map.hpp"
+#include "../mapped_file.hpp"
+#include "version.hpp"
+
+namespace life_lang::ast {
+
+namespace {
+
+// ============================================================================
+// Field lists - one per node, in declaration order
+// ============================================================================
+// Shared by the encoder (const nodes) and the decoder (mutable nodes), so the two
+// directions can't drift apart. A field missing here is silently dropped from
+// the cache: keep these in sync with ast.hpp (and bump k_ast_binary_version).
+
+template <typename Node, typename T>
+concept Node_Of = std::same_as<std::remove_const_t<Node>, T>;
+
+// Type names
+template <Node_Of<Function_Type> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.param_types, n_.return_type);
+}
+template <Node_Of<Path_Type> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.segments);
+}
+template <Node_Of<Array_Type> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.element_type, n_.size);
+}
+template <Node_Of<Tuple_Type> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.element_types);
+}
+template <Node_Of<Type_Name_Segment> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.value, n_.type_params);
+}
+template <Node_Of<Trait_Bound> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.trait_name);
+}
+template <Node_Of<Type_Param> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.bounds);
+}
+template <Node_Of<Where_Predicate> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.type_name, n_.bounds);
+}
+template <Node_Of<Where_Clause> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.predicates);
+}
+
+// Names and literals
+template <Node_Of<Var_Name> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.segments);
+}
+template <Node_Of<Var_Name_Segment> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.value, n_.type_params);
+}
+template <Node_Of<String> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.value);
+}
+template <Node_Of<String_Interpolation> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.parts);
+}
+template <Node_Of<Integer> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.value, n_.suffix);
+}
+template <Node_Of<Float> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.value, n_.suffix);
+}
+template <Node_Of<Char> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.value);
+}
+template <Node_Of<Bool_Literal> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.value);
+}
+template <Node_Of<Unit_Literal> N>
+auto fields(N& n_) {
+  return std::tie(n_.span);
+}
+template <Node_Of<Field_Initializer> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.value);
+}
+template <Node_Of<Struct_Literal> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.type_name, n_.fields);
+}
+template <Node_Of<Array_Literal> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.elements);
+}
+template <Node_Of<Tuple_Literal> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.elements);
+}
+
+// Expressions
+template <Node_Of<Binary_Expr> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.lhs, n_.op, n_.rhs);
+}
+template <Node_Of<Unary_Expr> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.op, n_.operand);
+}
+template <Node_Of<Range_Expr> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.start, n_.end, n_.inclusive);
+}
+template <Node_Of<Cast_Expr> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.expr, n_.target_type);
+}
+template <Node_Of<Func_Call_Expr> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.params);
+}
+template <Node_Of<Field_Access_Expr> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.object, n_.field_name);
+}
+template <Node_Of<Index_Expr> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.object, n_.index);
+}
+template <Node_Of<If_Expr> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.condition, n_.then_block, n_.else_ifs, n_.else_block);
+}
+template <Node_Of<Else_If_Clause> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.condition, n_.then_block);
+}
+template <Node_Of<While_Expr> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.condition, n_.body);
+}
+template <Node_Of<For_Expr> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.pattern, n_.iterator, n_.body);
+}
+template <Node_Of<Match_Arm> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.pattern, n_.guard, n_.result);
+}
+template <Node_Of<Match_Expr> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.scrutinee, n_.arms);
+}
+
+// Statements
+template <Node_Of<Assignment_Statement> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.target, n_.value);
+}
+template <Node_Of<Func_Call_Statement> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.expr);
+}
+template <Node_Of<Expr_Statement> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.expr);
+}
+template <Node_Of<Return_Statement> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.expr);
+}
+template <Node_Of<Break_Statement> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.value);
+}
+template <Node_Of<Continue_Statement> N>
+auto fields(N& n_) {
+  return std::tie(n_.span);
+}
+template <Node_Of<If_Statement> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.expr);
+}
+template <Node_Of<While_Statement> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.expr);
+}
+template <Node_Of<For_Statement> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.expr);
+}
+template <Node_Of<Block> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.statements, n_.trailing_expr);
+}
+template <Node_Of<Let_Statement> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.is_mut, n_.pattern, n_.type, n_.value);
+}
+
+// Patterns
+template <Node_Of<Wildcard_Pattern> N>
+auto fields(N& n_) {
+  return std::tie(n_.span);
+}
+template <Node_Of<Literal_Pattern> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.value);
+}
+template <Node_Of<Simple_Pattern> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name);
+}
+template <Node_Of<Field_Pattern> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.pattern);
+}
+template <Node_Of<Struct_Pattern> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.type_name, n_.fields, n_.has_rest);
+}
+template <Node_Of<Tuple_Pattern> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.elements);
+}
+template <Node_Of<Enum_Pattern> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.type_name, n_.patterns);
+}
+template <Node_Of<Or_Pattern> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.alternatives);
+}
+
+// Definitions
+template <Node_Of<Func_Param> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.is_mut, n_.name, n_.type);
+}
+template <Node_Of<Func_Decl> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.type_params, n_.func_params, n_.return_type, n_.where_clause);
+}
+template <Node_Of<Func_Def> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.is_pub, n_.declaration, n_.body);
+}
+template <Node_Of<Struct_Field> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.is_pub, n_.name, n_.type);
+}
+template <Node_Of<Struct_Def> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.type_params, n_.fields, n_.where_clause);
+}
+template <Node_Of<Unit_Variant> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name);
+}
+template <Node_Of<Tuple_Variant> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.tuple_fields);
+}
+template <Node_Of<Struct_Variant> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.struct_fields);
+}
+template <Node_Of<Enum_Def> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.type_params, n_.variants, n_.where_clause);
+}
+template <Node_Of<Impl_Block> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.type_name, n_.type_params, n_.methods, n_.where_clause);
+}
+template <Node_Of<Assoc_Type_Decl> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.bounds);
+}
+template <Node_Of<Assoc_Type_Impl> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.type_value);
+}
+template <Node_Of<Trait_Def> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.type_params, n_.assoc_types, n_.methods, n_.where_clause);
+}
+template <Node_Of<Trait_Impl> N>
+auto fields(N& n_) {
+  return std::tie(
+      n_.span, n_.trait_name, n_.type_name, n_.type_params, n_.assoc_type_impls, n_.methods, n_.where_clause
+  );
+}
+template <Node_Of<Type_Alias> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.type_params, n_.aliased_type);
+}
+
+// Modules
+template <Node_Of<Import_Item> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.name, n_.alias);
+}
+template <Node_Of<Import_Statement> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.module_path, n_.items);
+}
+template <Node_Of<Item> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.is_pub, n_.item);
+}
+template <Node_Of<Module> N>
+auto fields(N& n_) {
+  return std::tie(n_.span, n_.imports, n_.items);
+}
+
+template <typename Node>
+concept Has_Fields = requires(Node& node_) { fields(node_); };
+
+// Expr, Statement, Pattern, Type_Name, ... (std::variant wrappers)
+template <typename Node>
+concept Variant_Node = requires { typename Node::Base_Type; };
+
+constexpr auto k_max_binary_op = static_cast<std::uint64_t>(Binary_Op::Shr);
+constexpr auto k_max_unary_op = static_cast<std::uint64_t>(Unary_Op::BitNot);
+
+// ============================================================================
+// File layout
+// ============================================================================
+
+constexpr std::string_view k_magic = "LLAB";
+
+// Fixed-size header: magic, version, compiler hash, source hash, string count,
+// string/node/span table sizes, checksum of the body
+constexpr std::size_t k_header_size = 4 + 4 + 8 + 8 + 4 + 4 + 4 + 4 + 8;
+constexpr std::size_t k_checksum_offset = k_header_size - 8;
+
+void put_fixed(std::string& out_, std::uint64_t value_, std::size_t width_) {
+  for (std::size_t i = 0; i < width_; ++i) {
+    out_ += static_cast<char>((value_ >> (i * 8)) & 0xFF);
+  }
+}
+
+std::uint64_t get_fixed(std::string_view in_, std::size_t offset_, std::size_t width_) {
+  std::uint64_t value = 0;
+  for (std::size_t i = 0; i < width_; ++i) {
+    value |= std::uint64_t{static_cast<unsigned char>(in_[offset_ + i])} << (i * 8);
+  }
+  return value;
+}
+
+// Signed deltas as unsigned varints: 0, -1, 1, -2, ... -> 0, 1, 2, 3, ...
+std::uint64_t zigzag(std::size_t to_, std::size_t from_) {
+  auto const delta = static_cast<std::int64_t>(to_) - static_cast<std::int64_t>(from_);
+  return (static_cast<std::uint64_t>(delta) << 1) ^ static_cast<std::uint64_t>(delta >> 63);
+}
+
+std::size_t unzigzag(std::size_t from_, std::uint64_t value_) {
+  auto const delta = static_cast<std::int64_t>(value_ >> 1) ^ -static_cast<std::int64_t>(value_ & 1);
+  return static_cast<std::size_t>(static_cast<std::int64_t>(from_) + delta);
+}
+
+// ============================================================================
+// Encoder
+// ============================================================================
+
+class Encoder {
+public:
+  // Header and sections, ready to be written out
+  [[nodiscard]] std::string finish(std::uint64_t source_hash_) {
+    std::string body;
+    body.reserve((m_string_ends.size() * 4) + m_string_bytes.size() + m_nodes.size() + m_spans.size());
+    for (std::uint32_t const end: m_string_ends) {
+      put_fixed(body, end, 4);
+    }
+    body += m_string_bytes;
+    body += m_nodes;
+    body += m_spans;
+
+    // Sections are bounded by u32 sizes (4 GiB), far beyond any module's tree
+    std::string file;
+    file.reserve(k_header_size + body.size());
+    file += k_magic;
+    put_fixed(file, k_ast_binary_version, 4);
+    put_fixed(file, ast_binary_compiler_hash(), 8);
+    put_fixed(file, source_hash_, 8);
+    put_fixed(file, m_string_ends.size(), 4);
+    put_fixed(file, (m_string_ends.size() * 4) + m_string_bytes.size(), 4);
+    put_fixed(file, m_nodes.size(), 4);
+    put_fixed(file, m_spans.size(), 4);
+    put_fixed(file, hash_bytes(body), 8);
+    file += body;
+    return file;
+  }
+
+  void operator()(Source_Range const& range_) {
+    Source_Position const& start = range_.start;
+    Source_Position const& end = range_.end;
+    varint(m_spans, (zigzag(start.line, m_previous.line) << 1) | (range_.file != k_invalid_file_id ? 1U : 0U));
+    varint(m_spans, start.line == m_previous.line ? zigzag(start.column, m_previous.column) : start.column);
+    varint(m_spans, zigzag(end.line, start.line));
+    varint(m_spans, end.line == start.line ? zigzag(end.column, start.column) : end.column);
+    m_previous = start;
+  }
+
+  void operator()(std::string const& text_) {
+    auto const [id, inserted] = m_string_ids.try_emplace(text_, static_cast<std::uint32_t>(m_string_ends.size()));
+    if (inserted) {
+      m_string_bytes += text_;
+      m_string_ends.push_back(static_cast<std::uint32_t>(m_string_bytes.size()));
+    }
+    varint(m_nodes, *id);
+  }
+
+  void operator()(bool value_) { varint(m_nodes, value_ ? 1 : 0); }
+  void operator()(Binary_Op op_) { varint(m_nodes, static_cast<std::uint64_t>(op_)); }
+  void operator()(Unary_Op op_) { varint(m_nodes, static_cast<std::uint64_t>(op_)); }
+
+  template <typename T>
+  void operator()(std::optional<T> const& value_) {
+    (*this)(value_.has_value());
+    if (value_) {
+      (*this)(*value_);
+    }
+  }
+
+  template <typename T>
+  void operator()(std::shared_ptr<T> const& node_) {
+    (*this)(node_ != nullptr);
+    if (node_) {
+      (*this)(*node_);
+    }
+  }
+
+  template <typename T>
+  void operator()(std::vector<T> const& nodes_) {
+    varint(m_nodes, nodes_.size());
+    for (auto const& node: nodes_) {
+      (*this)(node);
+    }
+  }
+
+  template <Variant_Node T>
+  void operator()(T const& node_) {
+    auto const& base = static_cast<typename T::Base_Type const&>(node_);
+    varint(m_nodes, base.index());
+    std::visit(*this, base);
+  }
+
+  template <Has_Fields T>
+  void operator()(T const& node_) {
+    std::apply([this](auto const&... field_) { ((*this)(field_), ...); }, fields(node_));
+  }
+
+private:
+  std::string m_nodes;
+  std::string m_spans;
+  std::string m_string_bytes;
+  std::vector<std::uint32_t> m_string_ends;
+  Flat_String_Map<std::uint32_t> m_string_ids;  // Each distinct string is stored once
+  Source_Position m_previous;                   // Start of the previous span
+
+  // LEB128: 7 bits per byte, high bit set on every byte but the last
+  static void varint(std::string& out_, std::uint64_t value_) {
+    while (value_ >= 0x80) {
+      out_ += static_cast<char>((value_ & 0x7F) | 0x80);
+      value_ >>= 7;
+    }
+    out_ += static_cast<char>(value_);
+  }
+};
+
+// ============================================================================
+// Decoder
+// ============================================================================
+// Reads are bounds-checked; the first malformed read marks the decoder failed and
+// moves every cursor to the end of its section, so later reads fail fast and the
+// walk unwinds without allocating anything further.
+
+class Decoder {
+public:
+  // Sections as laid out by Encoder::finish(); sizes already checked against the file
+  Decoder(
+      std::string_view strings_,
+      std::uint32_t string_count_,
+      std::string_view nodes_,
+      std::string_view spans_,
+      File_Id file_
+  )
+      : m_string_ends(strings_.substr(0, std::size_t{string_count_} * 4)),
+        m_string_bytes(strings_.substr(std::size_t{string_count_} * 4)),
+        m_string_count(string_count_),
+        m_nodes{.at = nodes_.data(), .end = nodes_.data() + nodes_.size()},
+        m_spans{.at = spans_.data(), .end = spans_.data() + spans_.size()},
+        m_file(file_) {}
+
+  // True if everything decoded and both tables were consumed exactly
+  [[nodiscard]] bool done() const { return m_ok && m_nodes.at == m_nodes.end && m_spans.at == m_spans.end; }
+
+  void operator()(Source_Range& range_) {
+    std::uint64_t const head = varint(m_spans);
+    range_.file = (head & 1) != 0 ? m_file : k_invalid_file_id;
+    range_.start.line = unzigzag(m_previous.line, head >> 1);
+    std::uint64_t const start_column = varint(m_spans);
+    range_.start.column =
+        range_.start.line == m_previous.line ? unzigzag(m_previous.column, start_column) : start_column;
+    range_.end.line = unzigzag(range_.start.line, varint(m_spans));
+    std::uint64_t const end_column = varint(m_spans);
+    range_.end.column =
+        range_.end.line == range_.start.line ? unzigzag(range_.start.column, end_column) : end_column;
+    m_previous = range_.start;
+  }
+
+  void operator()(std::string& text_) {
+    std::uint64_t const id = varint(m_nodes);
+    if (id >= m_string_count) {
+      fail();
+      return;
+    }
+    auto const begin = id == 0 ? 0 : get_fixed(m_string_ends, (id - 1) * 4, 4);
+    auto const end = get_fixed(m_string_ends, id * 4, 4);
+    if (begin > end || end > m_string_bytes.size()) {
+      fail();
+      return;
+    }
+    text_.assign(m_string_bytes.substr(begin, end - begin));
+  }
+
+  void operator()(bool& value_) { value_ = bounded(1) == 1; }
+  void operator()(Binary_Op& op_) { op_ = static_cast<Binary_Op>(bounded(k_max_binary_op)); }
+  void operator()(Unary_Op& op_) { op_ = static_cast<Unary_Op>(bounded(k_max_unary_op)); }
+
+  template <typename T>
+  void operator()(std::optional<T>& value_) {
+    if (bounded(1) == 1) {
+      (*this)(value_.emplace());
+    }
+  }
+
+  template <typename T>
+  void operator()(std::shared_ptr<T>& node_) {
+    if (bounded(1) == 1) {
+      node_ = std::make_shared<T>();
+      (*this)(*node_);
+    }
+  }
+
+  template <typename T>
+  void operator()(std::vector<T>& nodes_) {
+    // Every element takes at least one node table byte, so a corrupt count can't
+    // trigger a huge allocation
+    std::uint64_t const count = varint(m_nodes);
+    if (count > static_cast<std::size_t>(m_nodes.end - m_nodes.at)) {
+      fail();
+      return;
+    }
+    nodes_.resize(count);
+    for (auto& node: nodes_) {
+      (*this)(node);
+    }
+  }
+
+  template <Variant_Node T>
+  void operator()(T& node_) {
+    using Base = typename T::Base_Type;
+    auto const index = bounded(std::variant_size_v<Base> - 1);
+    emplace_alternative(static_cast<Base&>(node_), index, std::make_index_sequence<std::variant_size_v<Base>>{});
+  }
+
+  template <Has_Fields T>
+  void operator()(T& node_) {
+    std::apply([this](auto&... field_) { ((*this)(field_), ...); }, fields(node_));
+  }
+
+private:
+  struct Cursor {
+    char const* at;
+    char const* end;
+  };
+
+  std::string_view m_string_ends;
+  std::string_view m_string_bytes;
+  std::uint32_t m_string_count;
+  Cursor m_nodes;
+  Cursor m_spans;
+  File_Id m_file;
+  Source_Position m_previous;
+  bool m_ok = true;
+
+  void fail() {
+    m_ok = false;
+    m_nodes.at = m_nodes.end;
+    m_spans.at = m_spans.end;
+  }
+
+  std::uint64_t varint(Cursor& cursor_) {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7) {
+      if (cursor_.at == cursor_.end) {
+        fail();
+        return 0;
+      }
+      auto const byte = static_cast<unsigned char>(*cursor_.at++);
+      value |= std::uint64_t{byte & 0x7FU} << shift;
+      if ((byte & 0x80U) == 0) {
+        return value;
+      }
+    }
+    fail();  // More than ten bytes: not something the encoder writes
+    return 0;
+  }
+
+  std::uint64_t bounded(std::uint64_t max_) {
+    std::uint64_t const value = varint(m_nodes);
+    if (value > max_) {
+      fail();
+      return 0;
+    }
+    return value;
+  }
+
+  template <typename Variant, std::size_t... Index>
+  void emplace_alternative(Variant& node_, std::size_t index_, std::index_sequence<Index...> /*indices_*/) {
+    (void)((index_ == Index && ((*this)(node_.template emplace<Index>()), true)) || ...);
+  }
+};
+
+}  // namespace
+
+std::uint64_t ast_binary_compiler_hash() {
+  static std::uint64_t const hash = hash_bytes(k_build_id, hash_bytes(k_version));
+  return hash;
+}
+
+std::string encode_module(Module const& module_, std::uint64_t source_hash_) {
+  Encoder encoder;
+  encoder(module_);
+  return encoder.finish(source_hash_);
+}
+
+std::optional<Ast_Binary_Header> read_header(std::string_view bytes_) {
+  if (bytes_.size() < k_header_size || !bytes_.starts_with(k_magic)) {
+    return std::nullopt;
+  }
+  Ast_Binary_Header const header{
+      .version = static_cast<std::uint32_t>(get_fixed(bytes_, 4, 4)),
+      .compiler_hash = get_fixed(bytes_, 8, 8),
+      .source_hash = get_fixed(bytes_, 16, 8),
+  };
+  if (header.version != k_ast_binary_version || header.compiler_hash != ast_binary_compiler_hash()) {
+    return std::nullopt;
+  }
+  return header;
+}
+
+std::optional<std::size_t> encoded_size(std::string_view bytes_) {
+  if (!read_header(bytes_)) {
+    return std::nullopt;
+  }
+  std::size_t const size =
+      k_header_size + get_fixed(bytes_, 28, 4) + get_fixed(bytes_, 32, 4) + get_fixed(bytes_, 36, 4);
+  if (size > bytes_.size()) {
+    return std::nullopt;
+  }
+  return size;
+}
+
+std::optional<Module> decode_module(std::string_view bytes_, File_Id file_) {
+  if (!read_header(bytes_)) {
+    return std::nullopt;
+  }
+  auto const string_count = static_cast<std::uint32_t>(get_fixed(bytes_, 24, 4));
+  std::size_t const string_size = get_fixed(bytes_, 28, 4);
+  std::size_t const node_size = get_fixed(bytes_, 32, 4);
+  std::size_t const span_size = get_fixed(bytes_, 36, 4);
+  std::string_view const body = bytes_.substr(k_header_size);
+  if (body.size() != string_size + node_size + span_size || std::size_t{string_count} * 4 > string_size ||
+      get_fixed(bytes_, k_checksum_offset, 8) != hash_bytes(body)) {
+    return std::nullopt;
+  }
+
+  Decoder decoder(
+      body.substr(0, string_size),
+      string_count,
+      body.substr(string_size, node_size),
+      body.substr(string_size + node_size),
+      file_
+  );
+  Module module;
+  decoder(module);
+  if (!decoder.done()) {
+    return std::nullopt;
+  }
+  return module;
+}
+
+std::optional<Module> read_module_file(std::filesystem::path const& path_, File_Id file_) {
+  auto const file = Mapped_File::open(path_);
+  if (!file) {
+    return std::nullopt;
+  }
+  return decode_module(file->bytes(), file_);
+}
+
+}  // namespace life_lang::ast
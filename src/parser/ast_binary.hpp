@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+
+#include "ast.hpp"
+
+namespace life_lang::ast {
+
+// ============================================================================
+// Binary AST format - parsed modules as compact, versioned files
+// ============================================================================
+// Used by the parse cache and for shipping pre-parsed modules. Every node kind
+// in ast.hpp round-trips: decode_module(encode_module(m)) prints and re-encodes
+// exactly like m.
+//
+// Layout (integers little-endian, sections in this order):
+//   Header         magic "LLAB", format version, compiler hash, source hash,
+//                  string count, section sizes, checksum of everything after it
+//   String table   one u32 end offset per string, then the bytes of every distinct
+//                  string once; nodes refer to strings by index
+//   Node table     depth-first walk over the node fields: LEB128 varints, counts
+//                  before vectors, a presence flag before optionals and shared
+//                  children, the alternative index before variants
+//   Span table     one record per span in walk order, as offsets from the
+//                  previous span (a typical span takes 4 bytes instead of 32)
+//
+// Spans are stored without their File_Id: a file is registered under a fresh id
+// on every run, so the reader stamps the id it is given into every located span.
+//
+// Readers reject files from another format version or another compiler build
+// (compiler hash), as well as truncated or corrupt ones (checksum), by returning
+// std::nullopt. The string table is read in place, so over a mapped file the
+// only copies made are the std::strings of the rebuilt nodes themselves.
+//
+// Bump k_ast_binary_version whenever a node gains, loses or reorders a field.
+//
+// Example:
+//   std::string const bytes = encode_module(module, hash_bytes(source));
+//   std::optional<Module> const copy = decode_module(bytes, file_id);
+//   std::optional<Module> const shipped = read_module_file("std/io.lab", file_id);
+
+inline constexpr std::uint32_t k_ast_binary_version = 2;
+
+struct Ast_Binary_Header {
+  std::uint32_t version{};
+  std::uint64_t compiler_hash{};  // Identifies the compiler build that wrote the file
+  std::uint64_t source_hash{};    // Caller-defined, e.g. hash_bytes() of the source text (0 if unused)
+};
+
+// Hash of the running compiler's version and build id (k_build_id), as written into every header
+[[nodiscard]] std::uint64_t ast_binary_compiler_hash();
+
+[[nodiscard]] std::string encode_module(Module const& module_, std::uint64_t source_hash_ = 0);
+
+// Header of a file written by this compiler build, or std::nullopt if the bytes are
+// not one (checks magic, version and compiler hash; cheap, doesn't touch the body)
+[[nodiscard]] std::optional<Ast_Binary_Header> read_header(std::string_view bytes_);
+
+// Size of the encoded module bytes_ starts with, header included, for files that hold several in a row;
+// std::nullopt if there is no header from this build or fewer bytes than it announces
+[[nodiscard]] std::optional<std::size_t> encoded_size(std::string_view bytes_);
+
+// std::nullopt if the header doesn't match this build or the body is corrupt or truncated
+[[nodiscard]] std::optional<Module> decode_module(std::string_view bytes_, File_Id file_);
+
+// Map path_ and decode it; std::nullopt if it can't be read or decoded
+[[nodiscard]] std::optional<Module> read_module_file(std::filesystem::path const& path_, File_Id file_);
+
+}  // namespace life_lang::ast
@@ -18,26 +18,21 @@
 
 #include "parser.hpp"
 
+#include "../cancellation.hpp"
+#include "../char_class.hpp"
 #include "../diagnostics.hpp"
+#include "../utf8.hpp"
+#include "span_rebase.hpp"
 #include "utils.hpp"
 
+#include <algorithm>
 #include <array>
-#include <cctype>
 #include <format>
 #include <string>
 
 namespace life_lang::parser {
 
 namespace {
-// Identifier checks
-[[nodiscard]] bool is_identifier_start(char ch_) {
-  return std::isalpha(static_cast<unsigned char>(ch_)) != 0 || ch_ == '_';
-}
-
-[[nodiscard]] bool is_identifier_continue(char ch_) {
-  return std::isalnum(static_cast<unsigned char>(ch_)) != 0 || ch_ == '_';
-}
-
 // Operator precedence and parsing helpers
 [[nodiscard]] constexpr int get_precedence(ast::Binary_Op op_) {
   // Precedence levels (higher = tighter binding):
@@ -98,10 +93,19 @@ struct Parser::Impl {
   std::size_t pos = 0;  // Current position in source
   Diagnostic_Engine* diagnostics = nullptr;
 
+  // Cooperative cancellation (see Parser::set_cancellation_token)
+  Cancellation_Token const* cancel_token = nullptr;
+  bool cancelled = false;  // Latched once the token fires; suppresses further diagnostics
+
+  // Poll the cancellation token - call at item, statement and loop boundaries
+  [[nodiscard]] bool poll_cancelled();
+
   // Lexical helpers
   char peek() const;
   char peek(std::size_t offset_) const;
   char advance(std::size_t count_ = 1);
+  // Consume bytes up to (not including) the first of stops_ or EOF and return them
+  std::string_view advance_until_any(std::string_view stops_);
   void skip_whitespace_and_comments();
   [[nodiscard]] bool is_at_end() const;
   [[nodiscard]] Source_Position current_position() const;
@@ -160,10 +164,29 @@ char Parser::Impl::advance(std::size_t count_) {
   return last_char;
 }
 
+std::string_view Parser::Impl::advance_until_any(std::string_view stops_) {
+  std::string_view const source = diagnostics->source();
+  std::size_t const start = std::min(pos, source.size());
+  std::size_t end = start;
+  // A NUL byte reads as k_eof_char through peek(), so it stops the run as well
+  while (end < source.size() && source[end] != k_eof_char && stops_.find(source[end]) == std::string_view::npos) {
+    ++end;
+  }
+  pos = end;
+  return source.substr(start, end - start);
+}
+
 bool Parser::Impl::is_at_end() const {
   return pos >= diagnostics->source().size();
 }
 
+bool Parser::Impl::poll_cancelled() {
+  if (!cancelled && cancel_token != nullptr && cancel_token->is_cancelled()) {
+    cancelled = true;
+  }
+  return cancelled;
+}
+
 template <typename Predicate>
 char Parser::Impl::collect_digits(std::string& value_, Predicate is_valid_digit_) {
   char last_char = peek();
@@ -193,7 +216,7 @@ void Parser::Impl::skip_whitespace_and_comments() {
     char const current = peek();
 
     // Skip whitespace
-    if (std::isspace(static_cast<unsigned char>(current)) != 0) {
+    if (is_whitespace(current)) {
       advance();
       continue;
     }
@@ -246,6 +269,9 @@ Source_Range Parser::Impl::make_range(Source_Position start_) const {
 }
 
 void Parser::Impl::error(std::string message_, Source_Range range_) const {
+  if (cancelled) {
+    return;  // Errors while unwinding a cancelled parse are artifacts, not user mistakes
+  }
   diagnostics->add_error(range_, std::move(message_));
 }
 
@@ -377,6 +403,11 @@ std::optional<ast::Statement> Parser::Impl::try_parse_expr_as_statement(Parser*
 [[nodiscard]] std::optional<ast::Binary_Op> Parser::Impl::try_parse_binary_op() {
   skip_whitespace_and_comments();
 
+  // Fast reject: most calls land on ')', ';', ',', '{' or an identifier
+  if (!is_operator_start(peek())) {
+    return std::nullopt;
+  }
+
   // Two-character operators first
   if (peek() == '=' && peek(1) == '=') {
     advance(2);
@@ -510,6 +541,22 @@ Parser::Parser(Diagnostic_Engine& diagnostics_) : m_impl(std::make_unique<Impl>(
 
 Parser::~Parser() = default;
 
+void Parser::reset(Diagnostic_Engine& diagnostics_) {
+  m_impl->pos = 0;
+  m_impl->diagnostics = &diagnostics_;
+  m_impl->cancel_token = nullptr;
+  m_impl->cancelled = false;
+}
+
+void Parser::set_cancellation_token(Cancellation_Token const* token_) {
+  m_impl->cancel_token = token_;
+  m_impl->cancelled = false;
+}
+
+bool Parser::cancelled() const {
+  return m_impl->cancelled;
+}
+
 bool Parser::all_input_consumed() const {
   // Save position
   auto saved_pos = m_impl->pos;
@@ -519,7 +566,7 @@ bool Parser::all_input_consumed() const {
     char const current = m_impl->diagnostics->source()[saved_pos];
 
     // Skip whitespace
-    if (std::isspace(static_cast<unsigned char>(current)) != 0) {
+    if (is_whitespace(current)) {
       ++saved_pos;
       continue;
     }
@@ -566,6 +613,20 @@ bool Parser::all_input_consumed() const {
 }
 
 std::optional<ast::Module> Parser::parse_module() {
+  // The lexer assumes well-formed UTF-8; files that failed validation at registration are not lexed
+  auto const& file = m_impl->diagnostics->file();
+  if (!file.is_valid_utf8()) {
+    for (auto const& bad: file.utf8_errors()) {
+      m_impl->error(
+          "Invalid UTF-8 byte sequence",
+          m_impl->diagnostics->make_range(
+              file.offset_to_position(bad.offset), file.offset_to_position(bad.offset + bad.length)
+          )
+      );
+    }
+    return std::nullopt;
+  }
+
   m_impl->skip_whitespace_and_comments();
 
   auto const module_start = m_impl->current_position();
@@ -575,6 +636,10 @@ std::optional<ast::Module> Parser::parse_module() {
 
   // Parse import statements
   while (m_impl->pos < m_impl->diagnostics->source().size()) {
+    if (m_impl->poll_cancelled()) {
+      return std::nullopt;
+    }
+
     m_impl->skip_whitespace_and_comments();
 
     if (m_impl->pos >= m_impl->diagnostics->source().size()) {
@@ -600,52 +665,196 @@ std::optional<ast::Module> Parser::parse_module() {
 
   // Parse items (with optional pub modifier)
   while (m_impl->pos < m_impl->diagnostics->source().size()) {
+    if (m_impl->poll_cancelled()) {
+      return std::nullopt;
+    }
+
     m_impl->skip_whitespace_and_comments();
 
     if (m_impl->pos >= m_impl->diagnostics->source().size()) {
       break;
     }
 
-    auto const start_pos = m_impl->current_position();
+    auto item = parse_module_item();
+    if (!item) {
+      return std::nullopt;
+    }
 
-    // Check for optional 'pub' modifier
-    bool is_pub = false;
-    if (m_impl->match_keyword("pub")) {
-      is_pub = true;
-      m_impl->skip_whitespace_and_comments();
+    items.push_back(std::move(*item));
+    m_impl->skip_whitespace_and_comments();
+  }
+
+  if (m_impl->cancelled || m_impl->diagnostics->has_errors()) {
+    return std::nullopt;
+  }
+
+  return ast::Module{
+      .span = m_impl->make_range(module_start),
+      .imports = std::move(imports),
+      .items = std::move(items)
+  };
+}
+
+std::optional<ast::Item> Parser::parse_module_item() {
+  auto const start_pos = m_impl->current_position();
+
+  // Check for optional 'pub' modifier
+  bool is_pub = false;
+  if (m_impl->match_keyword("pub")) {
+    is_pub = true;
+    m_impl->skip_whitespace_and_comments();
+  }
+
+  auto const start_char = m_impl->peek();
+
+  // Module-level items must start with a keyword (fn, struct, enum, impl, trait, type)
+  // Reject arbitrary expressions/statements at module level
+  if (start_char != k_eof_char && !m_impl->lookahead("fn") && !m_impl->lookahead("struct") &&
+      !m_impl->lookahead("enum") && !m_impl->lookahead("impl") && !m_impl->lookahead("trait") &&
+      !m_impl->lookahead("type")) {
+    m_impl->error(
+        "Expected module-level item (fn, struct, enum, impl, trait, or type), found unexpected content",
+        m_impl->make_range(start_pos)
+    );
+    return std::nullopt;
+  }
+
+  auto stmt = parse_statement();
+  if (!stmt) {
+    if (m_impl->diagnostics->has_errors()) {
+      return std::nullopt;
     }
+    m_impl->error(
+        "Expected statement or declaration at module level",
+        m_impl->make_range(m_impl->current_position())
+    );
+    return std::nullopt;
+  }
 
-    auto const start_char = m_impl->peek();
+  return ast::Item{.span = m_impl->make_range(start_pos), .is_pub = is_pub, .item = std::move(*stmt)};
+}
 
-    // Module-level items must start with a keyword (fn, struct, enum, impl, trait, type)
-    // Reject arbitrary expressions/statements at module level
-    if (start_char != k_eof_char && !m_impl->lookahead("fn") && !m_impl->lookahead("struct") &&
-        !m_impl->lookahead("enum") && !m_impl->lookahead("impl") && !m_impl->lookahead("trait") &&
-        !m_impl->lookahead("type")) {
-      m_impl->error(
-          "Expected module-level item (fn, struct, enum, impl, trait, or type), found unexpected content",
-          m_impl->make_range(start_pos)
-      );
+std::optional<ast::Module>
+Parser::reparse_module(ast::Module const& previous_, Text_Edit const& edit_, Source_Position removed_end_) {
+  auto const& source = m_impl->diagnostics->file();
+  File_Id const file_id = m_impl->diagnostics->file_id();
+
+  auto const full_parse = [&] {
+    m_impl->pos = 0;
+    return parse_module();
+  };
+
+  // Sanity: the engine's text must already hold the edit
+  std::size_t const edit_begin = edit_.offset;
+  std::size_t const inserted_end = edit_.offset + edit_.inserted.size();
+  if (!source.is_valid_utf8() || inserted_end > source.source().size() ||
+      source.source().compare(edit_begin, edit_.inserted.size(), edit_.inserted) != 0) {
+    return full_parse();
+  }
+
+  // Old positions are mapped through the edit alone - no copy of the previous text:
+  // - before the edit they are unchanged
+  // - on a line after the edit's last line only the line number moves
+  Source_Position const edit_start = source.offset_to_position(edit_begin);
+  if (removed_end_ < edit_start) {
+    return full_parse();
+  }
+  auto const line_delta = static_cast<std::ptrdiff_t>(source.offset_to_position(inserted_end).line) -
+                          static_cast<std::ptrdiff_t>(removed_end_.line);
+
+  // Edits touching the import list change what every item may refer to - start over
+  bool const touches_imports = !previous_.imports.empty() && previous_.imports.back().span.end >= edit_start;
+  if (previous_.items.empty() || touches_imports) {
+    return full_parse();
+  }
+
+  // Items ending strictly before the edit are reused unchanged
+  std::size_t before_count = 0;
+  while (before_count < previous_.items.size() && previous_.items[before_count].span.end < edit_start) {
+    ++before_count;
+  }
+
+  // Items starting on a line after the edit are reused with their lines shifted
+  // (same-line followers would need column fixes - cheaper to just reparse them)
+  std::size_t after_index = before_count;
+  while (after_index < previous_.items.size() && previous_.items[after_index].span.start.line <= removed_end_.line) {
+    ++after_index;
+  }
+
+  auto const new_offset_of = [&](ast::Item const& item_) {
+    auto const line = static_cast<std::ptrdiff_t>(item_.span.start.line) + line_delta;
+    return source.position_to_offset({.line = static_cast<std::size_t>(line), .column = item_.span.start.column});
+  };
+
+  // Unchanged prefix: share nodes outright unless the text now lives in another registry entry
+  auto const reuse_before = [&](auto const& node_) {
+    return (node_.span.file == file_id) ? node_ : ast::rebase_spans(node_, 0, file_id);
+  };
+
+  m_impl->pos = 0;
+  m_impl->skip_whitespace_and_comments();
+  auto const module_start = m_impl->current_position();
+
+  std::vector<ast::Import_Statement> imports;
+  imports.reserve(previous_.imports.size());
+  for (auto const& import: previous_.imports) {
+    imports.push_back(reuse_before(import));
+  }
+
+  std::vector<ast::Item> items;
+  items.reserve(previous_.items.size() + 1);
+  for (std::size_t i = 0; i < before_count; ++i) {
+    items.push_back(reuse_before(previous_.items[i]));
+  }
+
+  // Reparse the damaged region item by item, exactly as parse_module would
+  if (before_count > 0) {
+    m_impl->pos = source.position_to_offset(previous_.items[before_count - 1].span.end);
+  } else if (!previous_.imports.empty()) {
+    m_impl->pos = source.position_to_offset(previous_.imports.back().span.end);
+  }
+
+  while (m_impl->pos < source.source().size()) {
+    if (m_impl->poll_cancelled()) {
       return std::nullopt;
     }
 
-    auto stmt = parse_statement();
-    if (!stmt) {
-      if (m_impl->diagnostics->has_errors()) {
-        return std::nullopt;
+    m_impl->skip_whitespace_and_comments();
+
+    if (m_impl->pos >= source.source().size()) {
+      break;
+    }
+
+    // Still in the import section of the new text: the import list changed after all
+    if (items.empty() && m_impl->lookahead("import")) {
+      return full_parse();
+    }
+
+    // Resynchronised with the untouched tail: the rest of the file parses exactly as before
+    while (after_index < previous_.items.size() && new_offset_of(previous_.items[after_index]) < m_impl->pos) {
+      ++after_index;
+    }
+    if (after_index < previous_.items.size() && new_offset_of(previous_.items[after_index]) == m_impl->pos) {
+      for (std::size_t i = after_index; i < previous_.items.size(); ++i) {
+        auto const& item = previous_.items[i];
+        items.push_back(
+            (line_delta == 0 && item.span.file == file_id) ? item : ast::rebase_spans(item, line_delta, file_id)
+        );
       }
-      m_impl->error(
-          "Expected statement or declaration at module level",
-          m_impl->make_range(m_impl->current_position())
-      );
+      m_impl->pos = source.source().size();
+      break;
+    }
+
+    auto item = parse_module_item();
+    if (!item) {
       return std::nullopt;
     }
 
-    items.push_back(ast::Item{.span = m_impl->make_range(start_pos), .is_pub = is_pub, .item = std::move(*stmt)});
+    items.push_back(std::move(*item));
     m_impl->skip_whitespace_and_comments();
   }
 
-  if (m_impl->diagnostics->has_errors()) {
+  if (m_impl->cancelled || m_impl->diagnostics->has_errors()) {
     return std::nullopt;
   }
 
@@ -674,7 +883,7 @@ std::optional<ast::Import_Statement> Parser::parse_import_statement() {
 
   while (true) {
     // Parse type name (module names use Camel_Snake_Case)
-    if (!is_identifier_start(m_impl->peek()) || (std::isupper(static_cast<unsigned char>(m_impl->peek())) == 0)) {
+    if (!is_identifier_start(m_impl->peek()) || !is_upper(m_impl->peek())) {
       m_impl->error(
           "Expected module name (must start with uppercase letter)",
           m_impl->make_range(m_impl->current_position())
@@ -825,15 +1034,14 @@ std::optional<ast::Integer> Parser::parse_integer() {
     m_impl->advance(2);  // consume '0x' or '0X'
 
     // Must have at least one hex digit after 0x
-    if (std::isxdigit(static_cast<unsigned char>(m_impl->peek())) == 0) {
+    if (!is_hex_digit(m_impl->peek())) {
       m_impl->error("Invalid hexadecimal literal: expected hex digit after '0x'", m_impl->make_range(start_pos));
       return std::nullopt;
     }
 
     // Collect hex digits and underscores
     value = "0x";
-    char const last_char =
-        m_impl->collect_digits(value, [](char ch_) { return std::isxdigit(static_cast<unsigned char>(ch_)) != 0; });
+    char const last_char = m_impl->collect_digits(value, is_hex_digit);
 
     // Check for trailing underscore
     if (last_char == '_') {
@@ -853,7 +1061,7 @@ std::optional<ast::Integer> Parser::parse_integer() {
 
     // Collect octal digits and underscores
     value = "0o";
-    char const last_char = m_impl->collect_digits(value, [](char ch_) { return ch_ >= '0' && ch_ <= '7'; });
+    char const last_char = m_impl->collect_digits(value, is_oct_digit);
 
     // Check for trailing underscore
     if (last_char == '_') {
@@ -873,7 +1081,7 @@ std::optional<ast::Integer> Parser::parse_integer() {
 
     // Collect binary digits and underscores
     value = "0b";
-    char const last_char = m_impl->collect_digits(value, [](char ch_) { return ch_ == '0' || ch_ == '1'; });
+    char const last_char = m_impl->collect_digits(value, is_bin_digit);
 
     // Check for trailing underscore
     if (last_char == '_') {
@@ -883,15 +1091,14 @@ std::optional<ast::Integer> Parser::parse_integer() {
   }
   // Check for leading zero (only "0" is allowed, not "01", "02", etc.)
   else if (m_impl->peek() == '0') {
-    if (std::isdigit(static_cast<unsigned char>(m_impl->peek(1))) != 0 || m_impl->peek(1) == '_') {
+    if (is_digit(m_impl->peek(1)) || m_impl->peek(1) == '_') {
       m_impl->error("Invalid integer: leading zero not allowed (except standalone '0')", m_impl->make_range(start_pos));
       return std::nullopt;
     }
     value += m_impl->advance();
   } else if (m_impl->peek() >= '1' && m_impl->peek() <= '9') {
     // Non-zero start - collect all digits and underscores
-    char const last_char =
-        m_impl->collect_digits(value, [](char ch_) { return std::isdigit(static_cast<unsigned char>(ch_)) != 0; });
+    char const last_char = m_impl->collect_digits(value, is_digit);
     // Check for trailing underscore
     if (last_char == '_') {
       m_impl->error("Invalid integer: trailing underscore not allowed", m_impl->make_range(start_pos));
@@ -912,11 +1119,11 @@ std::optional<ast::Integer> Parser::parse_integer() {
   // Check for optional type suffix (I8, I16, I32, I64, U8, U16, U32, U64)
   if (m_impl->peek() == 'I' || m_impl->peek() == 'U') {
     suffix = std::string(1, m_impl->advance());
-    if (std::isdigit(static_cast<unsigned char>(m_impl->peek())) == 0) {
+    if (!is_digit(m_impl->peek())) {
       m_impl->error("Expected digit after type suffix", m_impl->make_range(start_pos));
       return std::nullopt;
     }
-    while (std::isdigit(static_cast<unsigned char>(m_impl->peek())) != 0) {
+    while (is_digit(m_impl->peek())) {
       *suffix += m_impl->advance();
     }
   }
@@ -947,11 +1154,11 @@ std::optional<ast::Float> Parser::parse_float() {
     // Check for optional type suffix (F32, F64)
     if (m_impl->peek() == 'F') {
       suffix = std::string(1, m_impl->advance());
-      if (std::isdigit(static_cast<unsigned char>(m_impl->peek())) == 0) {
+      if (!is_digit(m_impl->peek())) {
         m_impl->error("Expected digit after type suffix", m_impl->make_range(start_pos));
         return std::nullopt;
       }
-      while (std::isdigit(static_cast<unsigned char>(m_impl->peek())) != 0) {
+      while (is_digit(m_impl->peek())) {
         *suffix += m_impl->advance();
       }
     }
@@ -972,11 +1179,11 @@ std::optional<ast::Float> Parser::parse_float() {
     // Check for optional type suffix (F32, F64)
     if (m_impl->peek() == 'F') {
       suffix = std::string(1, m_impl->advance());
-      if (std::isdigit(static_cast<unsigned char>(m_impl->peek())) == 0) {
+      if (!is_digit(m_impl->peek())) {
         m_impl->error("Expected digit after type suffix", m_impl->make_range(start_pos));
         return std::nullopt;
       }
-      while (std::isdigit(static_cast<unsigned char>(m_impl->peek())) != 0) {
+      while (is_digit(m_impl->peek())) {
         *suffix += m_impl->advance();
       }
     }
@@ -994,8 +1201,7 @@ std::optional<ast::Float> Parser::parse_float() {
   // Also supports scientific notation (e/E)
 
   // Collect digits before dot (if any)
-  char const last_char_before_dot =
-      m_impl->collect_digits(value, [](char ch_) { return std::isdigit(static_cast<unsigned char>(ch_)) != 0; });
+  char const last_char_before_dot = m_impl->collect_digits(value, is_digit);
 
   // Must have dot or exponent
   bool has_dot = false;
@@ -1012,8 +1218,7 @@ std::optional<ast::Float> Parser::parse_float() {
     value += m_impl->advance();  // consume '.'
 
     // Collect fractional digits
-    char const last_char_after_dot =
-        m_impl->collect_digits(value, [](char ch_) { return std::isdigit(static_cast<unsigned char>(ch_)) != 0; });
+    char const last_char_after_dot = m_impl->collect_digits(value, is_digit);
     // Check for trailing underscore after fractional part
     if (last_char_after_dot == '_') {
       m_impl->error("Invalid float: trailing underscore after decimal", m_impl->make_range(start_pos));
@@ -1041,13 +1246,12 @@ std::optional<ast::Float> Parser::parse_float() {
     }
 
     // Collect exponent digits
-    if (std::isdigit(static_cast<unsigned char>(m_impl->peek())) == 0) {
+    if (!is_digit(m_impl->peek())) {
       m_impl->error("Expected digits after exponent", m_impl->make_range(start_pos));
       return std::nullopt;
     }
 
-    char const last_char_in_exponent =
-        m_impl->collect_digits(value, [](char ch_) { return std::isdigit(static_cast<unsigned char>(ch_)) != 0; });
+    char const last_char_in_exponent = m_impl->collect_digits(value, is_digit);
     // Check for trailing underscore in exponent
     if (last_char_in_exponent == '_') {
       m_impl->error("Invalid float: trailing underscore in exponent", m_impl->make_range(start_pos));
@@ -1064,11 +1268,11 @@ std::optional<ast::Float> Parser::parse_float() {
   // Check for optional type suffix (F32, F64)
   if (m_impl->peek() == 'F') {
     suffix = std::string(1, m_impl->advance());
-    if (std::isdigit(static_cast<unsigned char>(m_impl->peek())) == 0) {
+    if (!is_digit(m_impl->peek())) {
       m_impl->error("Expected digit after type suffix", m_impl->make_range(start_pos));
       return std::nullopt;
     }
-    while (std::isdigit(static_cast<unsigned char>(m_impl->peek())) != 0) {
+    while (is_digit(m_impl->peek())) {
       *suffix += m_impl->advance();
     }
   }
@@ -1107,7 +1311,8 @@ std::optional<ast::String> Parser::parse_string() {
       }
       value += m_impl->advance();  // consume escaped character
     } else {
-      value += m_impl->advance();
+      // Copy the whole run up to the next quote or escape at once
+      value += m_impl->advance_until_any("\"\\");
     }
   }
 
@@ -1180,7 +1385,7 @@ std::optional<ast::String_Interpolation> Parser::parse_string_interpolation() {
       // Add expression to parts
       parts.emplace_back(std::make_shared<ast::Expr>(std::move(*expr)));
     } else {
-      current_literal += m_impl->advance();
+      current_literal += m_impl->advance_until_any("\"\\{");
     }
   }
 
@@ -1263,6 +1468,7 @@ std::optional<ast::String> Parser::parse_raw_string() {
 
     // Not the closing delimiter, just part of content
     value += m_impl->advance();
+    value += m_impl->advance_until_any("\"");
   }
 
   m_impl->error("Unterminated raw string literal", m_impl->make_range(start_pos));
@@ -1302,7 +1508,7 @@ std::optional<ast::Char> Parser::parse_char() {
     if (escape_char == 'x') {
       // Hex escape: \xHH (exactly 2 hex digits)
       for (int i = 0; i < 2; i++) {
-        if (m_impl->peek() == k_eof_char || std::isxdigit(static_cast<unsigned char>(m_impl->peek())) == 0) {
+        if (m_impl->peek() == k_eof_char || !is_hex_digit(m_impl->peek())) {
           m_impl->error("Invalid hex escape sequence (expected 2 hex digits)", m_impl->make_range(start_pos));
           return std::nullopt;
         }
@@ -1318,7 +1524,7 @@ std::optional<ast::Char> Parser::parse_char() {
 
       int digit_count = 0;
       while (m_impl->peek() != '}' && digit_count < 6) {
-        if (std::isxdigit(static_cast<unsigned char>(m_impl->peek())) == 0) {
+        if (!is_hex_digit(m_impl->peek())) {
           m_impl->error("Invalid unicode escape (expected hex digit or '}')", m_impl->make_range(start_pos));
           return std::nullopt;
         }
@@ -1339,31 +1545,11 @@ std::optional<ast::Char> Parser::parse_char() {
     }
     // For simple escapes like \n, \t, \', \", \\, we've already consumed the char
   } else {
-    // Regular character (may be multi-byte UTF-8)
-    char const first_byte = m_impl->peek();
-    value += m_impl->advance();
-
-    // UTF-8 continuation bytes start with 10xxxxxx (0x80-0xBF)
-    // Detect multi-byte UTF-8 by checking if first byte has high bit set
-    if ((static_cast<unsigned char>(first_byte) & 0x80U) != 0) {
-      // This is a multi-byte UTF-8 sequence
-      // Count continuation bytes based on leading byte
-      int continuation_bytes = 0;
-      if ((static_cast<unsigned char>(first_byte) & 0xE0U) == 0xC0U) {
-        continuation_bytes = 1;  // 2-byte sequence (110xxxxx)
-      } else if ((static_cast<unsigned char>(first_byte) & 0xF0U) == 0xE0U) {
-        continuation_bytes = 2;  // 3-byte sequence (1110xxxx)
-      } else if ((static_cast<unsigned char>(first_byte) & 0xF8U) == 0xF0U) {
-        continuation_bytes = 3;  // 4-byte sequence (11110xxx)
-      }
-
-      for (int i = 0; i < continuation_bytes; i++) {
-        if (m_impl->peek() == k_eof_char) {
-          m_impl->error("Invalid UTF-8 sequence in character literal", m_impl->make_range(start_pos));
-          return std::nullopt;
-        }
-        value += m_impl->advance();
-      }
+    // Regular character - the file passed UTF-8 validation, so the lead byte tells the
+    // sequence length and the continuation bytes need no checks
+    std::size_t const length = std::max<std::size_t>(utf8_sequence_length(m_impl->peek()), 1);
+    for (std::size_t i = 0; i < length && !m_impl->is_at_end(); ++i) {
+      value += m_impl->advance();
     }
   }
 
@@ -1434,7 +1620,7 @@ std::optional<ast::Struct_Literal> Parser::parse_struct_literal() {
   auto const start_pos = m_impl->current_position();
 
   // Parse type name (must start with uppercase)
-  if (!is_identifier_start(m_impl->peek()) || std::isupper(static_cast<unsigned char>(m_impl->peek())) == 0) {
+  if (!is_identifier_start(m_impl->peek()) || !is_upper(m_impl->peek())) {
     m_impl->error("Expected type name for struct literal", m_impl->make_range(start_pos));
     return std::nullopt;
   }
@@ -2036,13 +2222,13 @@ std::optional<ast::Array_Type> Parser::parse_array_type() {
     m_impl->skip_whitespace_and_comments();
 
     // Parse array size (integer literal)
-    if (std::isdigit(static_cast<unsigned char>(m_impl->peek())) == 0) {
+    if (!is_digit(m_impl->peek())) {
       m_impl->error("Expected integer literal for array size", m_impl->make_range(start_pos));
       return std::nullopt;
     }
 
     std::string size_str;
-    while (std::isdigit(static_cast<unsigned char>(m_impl->peek())) != 0) {
+    while (is_digit(m_impl->peek())) {
       size_str += m_impl->advance();
     }
     size = std::move(size_str);
@@ -2215,7 +2401,7 @@ std::optional<ast::Expr> Parser::parse_primary_expr() {
   }
 
   // Try integer or float
-  if (std::isdigit(static_cast<unsigned char>(m_impl->peek())) != 0) {
+  if (is_digit(m_impl->peek())) {
     // Need to distinguish between integer and float
     // Look ahead for decimal point or exponent
     bool is_float = false;
@@ -2229,7 +2415,7 @@ std::optional<ast::Expr> Parser::parse_primary_expr() {
         is_float = true;
         break;
       }
-      if (std::isdigit(static_cast<unsigned char>(ch)) == 0 && ch != '_') {
+      if (!is_digit(ch) && ch != '_') {
         break;
       }
     }
@@ -2407,7 +2593,7 @@ std::optional<ast::Expr> Parser::parse_primary_expr() {
 
     // Check if this is a struct literal (uppercase identifier followed by '{')
     bool is_struct_literal = false;
-    if (std::isupper(static_cast<unsigned char>(m_impl->peek())) != 0) {
+    if (is_upper(m_impl->peek())) {
       std::size_t look_ahead = 0;
       while (is_identifier_continue(m_impl->peek(look_ahead))) {
         look_ahead++;
@@ -2582,7 +2768,7 @@ std::optional<ast::Expr> Parser::parse_primary_expr() {
     // Grammar: x + y as I64 * z => x + ((y as I64) * z)
     if (m_impl->lookahead("as") &&
         (m_impl->peek(2) == ' ' || m_impl->peek(2) == '\t' || m_impl->peek(2) == '\n' || m_impl->peek(2) == '\r' ||
-         (std::isupper(static_cast<unsigned char>(m_impl->peek(2))) != 0))) {
+         is_upper(m_impl->peek(2)))) {
       int const cast_precedence = 11;  // Just below postfix (highest), above unary and multiplicative
       if (cast_precedence < min_precedence_) {
         break;
@@ -2692,7 +2878,7 @@ std::optional<ast::Expr> Parser::parse_primary_expr() {
       m_impl->skip_whitespace_and_comments();
 
       // Allow both identifier field names and numeric field names (for tuple access like pair.0)
-      if (!is_identifier_start(m_impl->peek()) && (std::isdigit(static_cast<unsigned char>(m_impl->peek())) == 0)) {
+      if (!is_identifier_start(m_impl->peek()) && !is_digit(m_impl->peek())) {
         m_impl->error("Expected field name after '.'");
         return std::nullopt;
       }
@@ -2916,6 +3102,10 @@ std::optional<ast::Expr> Parser::parse_primary_expr() {
   std::optional<std::shared_ptr<ast::Expr>> trailing_expr;
 
   while (true) {
+    if (m_impl->poll_cancelled()) {
+      return std::nullopt;
+    }
+
     m_impl->skip_whitespace_and_comments();
 
     if (m_impl->peek() == '}') {
@@ -3081,6 +3271,10 @@ std::optional<ast::Expr> Parser::parse_primary_expr() {
   std::vector<ast::Match_Arm> arms;
 
   while (true) {
+    if (m_impl->poll_cancelled()) {
+      return std::nullopt;
+    }
+
     m_impl->skip_whitespace_and_comments();
 
     if (m_impl->peek() == '}') {
@@ -4061,6 +4255,10 @@ std::optional<ast::Expr> Parser::parse_primary_expr() {
   std::vector<ast::Func_Decl> methods;
 
   while (m_impl->peek() != '}' && m_impl->pos < m_impl->diagnostics->source().size()) {
+    if (m_impl->poll_cancelled()) {
+      return std::nullopt;
+    }
+
     auto const item_start = m_impl->current_position();
 
     if (m_impl->lookahead("type")) {
@@ -4263,6 +4461,10 @@ std::optional<ast::Expr> Parser::parse_primary_expr() {
 
   std::vector<ast::Func_Def> methods;
   while (m_impl->peek() != '}' && m_impl->pos < m_impl->diagnostics->source().size()) {
+    if (m_impl->poll_cancelled()) {
+      return std::nullopt;
+    }
+
     // Check for optional 'pub' keyword for methods
     bool const is_pub = m_impl->match_keyword("pub");
     if (is_pub) {
@@ -4440,6 +4642,10 @@ std::optional<ast::Expr> Parser::parse_primary_expr() {
   std::vector<ast::Func_Def> methods;
 
   while (m_impl->peek() != '}' && m_impl->pos < m_impl->diagnostics->source().size()) {
+    if (m_impl->poll_cancelled()) {
+      return std::nullopt;
+    }
+
     auto const item_start = m_impl->current_position();
 
     if (m_impl->lookahead("type")) {
@@ -4526,8 +4732,7 @@ std::optional<ast::Expr> Parser::parse_primary_expr() {
     return ast::Pattern{std::move(tuple_pat)};
   }
 
-  if (m_impl->peek() == '"' || std::isdigit(m_impl->peek()) != 0 ||
-      (m_impl->peek() == '-' && std::isdigit(m_impl->peek(1)) != 0) ||
+  if (m_impl->peek() == '"' || is_digit(m_impl->peek()) || (m_impl->peek() == '-' && is_digit(m_impl->peek(1))) ||
       (m_impl->lookahead("true") && !is_identifier_continue(m_impl->peek(4))) ||
       (m_impl->lookahead("false") && !is_identifier_continue(m_impl->peek(5)))) {
     auto expr = parse_primary_expr();
@@ -7,6 +7,7 @@
 
 namespace life_lang {
 struct Diagnostic_Engine;
+class Cancellation_Token;
 }  // namespace life_lang
 
 namespace life_lang::parser {
@@ -34,6 +35,31 @@ public:
   // This is the main entry point for production use - validates entire input
   std::optional<ast::Module> parse_module();
 
+  // Incrementally reparse a module after a single text edit
+  // previous_ must have been parsed from the text before edit_; the engine's file must already
+  // hold the edited text. removed_end_ is where the removed range ended in the previous text
+  // (the edit's end position before it was applied) - old spans are mapped through it
+  // Top-level items the edit does not touch are reused - shared as-is when nothing moved,
+  // span-rebased when lines shifted - and only the damaged region is parsed again.
+  // Produces the same module and diagnostics as parse_module() on the new text; falls back
+  // to a full parse when the edit reaches the imports
+  std::optional<ast::Module>
+  reparse_module(ast::Module const& previous_, Text_Edit const& edit_, Source_Position removed_end_);
+
+  // Rebind the parser to another file so one instance can parse many files in a row
+  // Keeps the parser's own allocations; resets position, cancellation token and
+  // cancellation state as if freshly constructed with diagnostics_
+  void reset(Diagnostic_Engine& diagnostics_);
+
+  // Cooperative cancellation: the token is polled at item, statement and loop boundaries
+  // Once it fires, parsing unwinds without recording further diagnostics and the
+  // interrupted parse_*() call returns std::nullopt with cancelled() == true
+  // Pass nullptr to disable (the default); the token must outlive the parse
+  void set_cancellation_token(Cancellation_Token const* token_);
+
+  // True if the last parse was abandoned because the cancellation token fired
+  [[nodiscard]] bool cancelled() const;
+
   // ============================================================================
   // Testing API
   // ============================================================================
@@ -109,6 +135,9 @@ public:
   std::optional<ast::Trait_Impl> parse_trait_impl();
 
 private:
+  // One module-level item (with optional pub) - shared by parse_module and reparse_module
+  std::optional<ast::Item> parse_module_item();
+
   struct Impl;
   std::unique_ptr<Impl> m_impl;
 };
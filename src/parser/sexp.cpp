@@ -1,22 +1,112 @@
 #include "sexp.hpp"
 
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <ostream>
+
+#include "thread_pool.hpp"
+
 namespace life_lang::ast::detail {
 
+namespace {
+
+// Indentation is sliced out of this instead of building a string per line
+constexpr std::size_t k_spaces_size = 256;
+constexpr auto k_spaces = [] {
+  std::array<char, k_spaces_size> spaces{};
+  spaces.fill(' ');
+  return spaces;
+}();
+
+constexpr std::string_view k_escaped_chars = "\"\\\n\r\t";
+
+bool write_all(int fd_, std::string_view bytes_) {
+  while (!bytes_.empty()) {
+    auto const written = ::write(fd_, bytes_.data(), bytes_.size());
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    bytes_.remove_prefix(static_cast<std::size_t>(written));
+  }
+  return true;
+}
+
+}  // namespace
+
+Sexp_Printer::Sexp_Printer(Sexp_Sink sink_, int indent_)
+    : m_sink(sink_), m_streaming(sink_.stream != nullptr || sink_.fd >= 0), m_indent_size(indent_) {
+  if (m_streaming) {
+    m_buffer.reserve(k_flush_bytes + k_spaces_size);
+  }
+}
+
+void Sexp_Printer::flush() {
+  if (m_buffer.empty()) {
+    return;
+  }
+  if (m_sink_ok) {
+    if (m_sink.stream != nullptr) {
+      auto const size = static_cast<std::streamsize>(m_buffer.size());
+      m_sink_ok = static_cast<bool>(m_sink.stream->write(m_buffer.data(), size));
+    } else {
+      m_sink_ok = write_all(m_sink.fd, m_buffer);
+    }
+  }
+  m_buffer.clear();  // Keeps its capacity: steady-state streaming doesn't allocate
+}
+
+bool Sexp_Printer::finish() {
+  if (m_streaming) {
+    flush();
+    if (m_sink.stream != nullptr) {
+      m_sink_ok = m_sink_ok && static_cast<bool>(m_sink.stream->flush());
+    }
+  }
+  return m_sink_ok;
+}
+
+Sexp_Printer Sexp_Printer::fork() const {
+  Sexp_Printer fork(m_indent_size);
+  fork.m_depth = m_depth;
+  fork.m_needs_indent = m_needs_indent;
+  return fork;
+}
+
+void Sexp_Printer::splice(Sexp_Printer&& fork_) {
+  // The fork already wrote any pending indentation
+  m_needs_indent = fork_.m_needs_indent;
+  put(fork_.m_buffer);
+}
+
 void Sexp_Printer::write(std::string_view text_) {
   maybe_indent();
-  m_oss << text_;
+  put(text_);
 }
 
 void Sexp_Printer::maybe_indent() {
   if (m_needs_indent && m_indent_size > 0) {
-    m_oss << '\n' << std::string(static_cast<std::size_t>(m_depth * m_indent_size), ' ');
+    m_buffer.push_back('\n');
+    auto remaining = static_cast<std::size_t>(m_depth * m_indent_size);
+    while (remaining > 0) {
+      auto const chunk = std::min(remaining, k_spaces_size);
+      m_buffer.append(k_spaces.data(), chunk);
+      remaining -= chunk;
+    }
     m_needs_indent = false;
+    maybe_flush();
   }
 }
 
 void Sexp_Printer::begin_list(std::string_view tag_) {
   maybe_indent();
-  m_oss << '(' << tag_;
+  m_buffer.push_back('(');
+  put(tag_);
   ++m_depth;
   m_needs_indent = true;
 }
@@ -25,55 +115,62 @@ void Sexp_Printer::end_list() {
   --m_depth;
   m_needs_indent = true;
   maybe_indent();
-  m_oss << ')';
+  put(')');
 }
 
 void Sexp_Printer::space() {
   if (m_indent_size > 0) {
     m_needs_indent = true;
   } else {
-    m_oss << ' ';
+    put(' ');
   }
 }
 
 void Sexp_Printer::write_quoted(std::string_view str_) {
   maybe_indent();
-  m_oss << escape_string(str_);
+  append_escaped(m_buffer, str_);
+  maybe_flush();
 }
 
 void Sexp_Printer::write_bool(bool value_) {
   maybe_indent();
-  m_oss << (value_ ? "true" : "false");
+  put(value_ ? "true" : "false");
 }
 
-// Helper to escape strings for S-expression output
-std::string escape_string(std::string_view str_) {
-  std::ostringstream oss;
-  oss << '"';
-  for (char const ch: str_) {
-    switch (ch) {
-      case '"':
-        oss << "\\\"";
-        break;
-      case '\\':
-        oss << "\\\\";
-        break;
+void append_escaped(std::string& out_, std::string_view str_) {
+  out_.push_back('"');
+  while (!str_.empty()) {
+    auto const special = str_.find_first_of(k_escaped_chars);
+    out_.append(str_.substr(0, special));
+    if (special == std::string_view::npos) {
+      break;
+    }
+    out_.push_back('\\');
+    switch (str_[special]) {
       case '\n':
-        oss << "\\n";
+        out_.push_back('n');
         break;
       case '\r':
-        oss << "\\r";
+        out_.push_back('r');
         break;
       case '\t':
-        oss << "\\t";
+        out_.push_back('t');
         break;
-      default:
-        oss << ch;
+      default:  // '"' and '\\' stand for themselves
+        out_.push_back(str_[special]);
         break;
     }
+    str_.remove_prefix(special + 1);
   }
-  oss << '"';
-  return oss.str();
+  out_.push_back('"');
+}
+
+// Helper to escape strings for S-expression output
+std::string escape_string(std::string_view str_) {
+  std::string out;
+  out.reserve(str_.size() + 2);
+  append_escaped(out, str_);
+  return out;
 }
 
 namespace {
@@ -87,7 +184,7 @@ void print_sexp(Sexp_Printer& p_, If_Expr const& if_expr_);
 void print_sexp(Sexp_Printer& p_, While_Expr const& while_expr_);
 void print_sexp(Sexp_Printer& p_, For_Expr const& for_expr_);
 void print_sexp(Sexp_Printer& p_, Match_Expr const& match_expr_);
-void print_sexp(Sexp_Printer& p_, Module const& mod_);
+void print_sexp(Sexp_Printer& p_, Module const& mod_, Thread_Pool* pool_ = nullptr);
 
 // Type system S-expression printers
 void print_sexp(Sexp_Printer& p_, Type_Name_Segment const& seg_) {
@@ -982,8 +1079,30 @@ void print_sexp(Sexp_Printer& p_, Item const& item_) {
   p_.end_list();
 }
 
-// Module S-expression printer
-void print_sexp(Sexp_Printer& p_, Module const& mod_) {
+// Items rendered on pool_, each into a fork of p_, then spliced back in order
+void print_items_parallel(Sexp_Printer& p_, std::vector<Item> const& items_, Thread_Pool& pool_) {
+  // Every item starts in the same printer state (right after "(items" or a space()),
+  // so all forks can be taken up front
+  std::vector<Sexp_Printer> forks;
+  forks.reserve(items_.size());
+  for (std::size_t i = 0; i < items_.size(); ++i) {
+    forks.push_back(p_.fork());
+  }
+  for (std::size_t i = 0; i < items_.size(); ++i) {
+    pool_.submit([&forks, &items_, i] { print_sexp(forks[i], items_[i]); });
+  }
+  pool_.wait();
+
+  for (std::size_t i = 0; i < items_.size(); ++i) {
+    if (i > 0) {
+      p_.space();
+    }
+    p_.splice(std::move(forks[i]));
+  }
+}
+
+// Module S-expression printer (items in parallel if given a pool)
+void print_sexp(Sexp_Printer& p_, Module const& mod_, Thread_Pool* pool_) {
   p_.begin_list("module");
 
   // Print imports
@@ -1003,11 +1122,15 @@ void print_sexp(Sexp_Printer& p_, Module const& mod_) {
   if (!mod_.items.empty()) {
     p_.space();
     p_.begin_list("items");
-    for (std::size_t i = 0; i < mod_.items.size(); ++i) {
-      if (i > 0) {
-        p_.space();
+    if (pool_ != nullptr && mod_.items.size() > 1) {
+      print_items_parallel(p_, mod_.items, *pool_);
+    } else {
+      for (std::size_t i = 0; i < mod_.items.size(); ++i) {
+        if (i > 0) {
+          p_.space();
+        }
+        print_sexp(p_, mod_.items[i]);
       }
-      print_sexp(p_, mod_.items[i]);
     }
     p_.end_list();
   }
@@ -1024,7 +1147,30 @@ template <typename T>
 std::string to_sexp_string(T const& node_, int indent_) {
   detail::Sexp_Printer printer(indent_);
   detail::print_sexp(printer, node_);
-  return printer.str();
+  return std::move(printer).take();
+}
+
+std::string to_sexp_string(Module const& module_, int indent_, Thread_Pool& pool_) {
+  detail::Sexp_Printer printer(indent_);
+  detail::print_sexp(printer, module_, &pool_);
+  return std::move(printer).take();
+}
+
+namespace {
+bool stream_module(detail::Sexp_Sink sink_, Module const& module_, int indent_) {
+  detail::Sexp_Printer printer(sink_, indent_);
+  detail::print_sexp(printer, module_);
+  printer.write("\n");
+  return printer.finish();
+}
+}  // namespace
+
+bool write_sexp(std::ostream& out_, Module const& module_, int indent_) {
+  return stream_module(detail::Sexp_Sink{.stream = &out_}, module_, indent_);
+}
+
+bool write_sexp(int fd_, Module const& module_, int indent_) {
+  return stream_module(detail::Sexp_Sink{.fd = fd_}, module_, indent_);
 }
 
 // Explicit template instantiations for commonly used types
@@ -1,13 +1,19 @@
 #pragma once
 
+#include <cstddef>
+#include <iosfwd>
 #include <memory>
-#include <sstream>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
 
 #include "ast.hpp"
 
+namespace life_lang {
+class Thread_Pool;
+}
+
 namespace life_lang::ast {
 
 // ============================================================================
@@ -32,13 +38,37 @@ namespace life_lang::ast {
 
 namespace detail {
 
+// Appends str_ to out_ as a quoted S-expression string; runs without escapes are copied whole
+void append_escaped(std::string& out_, std::string_view str_);
+
 std::string escape_string(std::string_view str_);
 
+// Where a streaming printer sends its bytes (see Sexp_Printer)
+struct Sexp_Sink {
+  std::ostream* stream{};  // Used if set
+  int fd{-1};              // Otherwise, if not negative
+};
+
+// Builds the document in a byte buffer. With a sink, the buffer is handed over in
+// chunks of about k_flush_bytes as it fills, so memory stays bounded however large
+// the tree; without one, str()/take() return the whole document.
 class Sexp_Printer {
 public:
+  static constexpr std::size_t k_flush_bytes = std::size_t{64} << 10;
+
   explicit Sexp_Printer(int indent_ = 2) : m_indent_size(indent_) {}
+  Sexp_Printer(Sexp_Sink sink_, int indent_);
+
+  [[nodiscard]] std::string const& str() const { return m_buffer; }
+  [[nodiscard]] std::string take() && { return std::move(m_buffer); }
 
-  [[nodiscard]] std::string str() const { return m_oss.str(); }
+  // Hands the rest of the buffer to the sink; false if any write to it failed
+  [[nodiscard]] bool finish();
+
+  // An empty, sink-less printer at this one's position: what it renders can be
+  // spliced back here byte for byte (lets subtrees render on other threads)
+  [[nodiscard]] Sexp_Printer fork() const;
+  void splice(Sexp_Printer&& fork_);
 
   void write(std::string_view text_);
   void maybe_indent();
@@ -65,14 +95,14 @@ public:
       return;
     }
     maybe_indent();
-    m_oss << "(";
+    put('(');
     for (std::size_t i = 0; i < vec_.size(); ++i) {
       if (i > 0) {
         space();
       }
       print_fn_(vec_[i]);
     }
-    m_oss << ")";
+    put(')');
   }
 
   template <typename T>
@@ -83,7 +113,7 @@ public:
       return;
     }
     maybe_indent();
-    m_oss << "(";
+    put('(');
     for (std::size_t i = 0; i < vec_.size(); ++i) {
       if (i > 0) {
         space();
@@ -92,14 +122,32 @@ public:
         print_fn_(*vec_[i]);
       } else {
         maybe_indent();
-        m_oss << "nil";
+        write("nil");
       }
     }
-    m_oss << ")";
+    put(')');
   }
 
 private:
-  std::ostringstream m_oss;
+  void put(char ch_) {
+    m_buffer.push_back(ch_);
+    maybe_flush();
+  }
+  void put(std::string_view text_) {
+    m_buffer.append(text_);
+    maybe_flush();
+  }
+  void maybe_flush() {
+    if (m_streaming && m_buffer.size() >= k_flush_bytes) {
+      flush();
+    }
+  }
+  void flush();
+
+  std::string m_buffer;
+  Sexp_Sink m_sink;
+  bool m_streaming{false};
+  bool m_sink_ok{true};
   int m_indent_size{2};
   int m_depth{0};
   bool m_needs_indent{false};
@@ -112,6 +160,24 @@ private:
 template <typename T>
 std::string to_sexp_string(T const& node_, int indent_ = 2);
 
+// Streams a module's S-expression, plus a trailing newline, to out_ or to the file
+// descriptor fd_ in fixed-size chunks instead of building it in memory first.
+// Output is byte-identical to to_sexp_string(); false if a write failed.
+//
+// Example:
+//   write_sexp(STDOUT_FILENO, module);  // What `lifec -` does
+[[nodiscard]] bool write_sexp(std::ostream& out_, Module const& module_, int indent_ = 2);
+[[nodiscard]] bool write_sexp(int fd_, Module const& module_, int indent_ = 2);
+
+// Same output as to_sexp_string(module_, indent_), with the top-level items rendered
+// concurrently on pool_ and concatenated in order. Waits on pool_, so call it from
+// outside the pool.
+//
+// Example:
+//   Thread_Pool pool;
+//   std::string const golden = to_sexp_string(module, 2, pool);
+[[nodiscard]] std::string to_sexp_string(Module const& module_, int indent_, Thread_Pool& pool_);
+
 // Explicit instantiation declarations (defined in sexp.cpp)
 extern template std::string to_sexp_string(Module const&, int);
 extern template std::string to_sexp_string(Item const&, int);
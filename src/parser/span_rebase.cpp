@@ -0,0 +1,395 @@
+#include "span_rebase.hpp"
+
+#include <variant>
+
+namespace life_lang::ast {
+
+namespace {
+
+// Clone-on-write walker: every operator() rewrites the spans of the node it is given,
+// replacing shared children with rebased copies before descending into them
+struct Span_Rebaser {
+  std::ptrdiff_t line_delta;
+  File_Id file;
+
+  void span(Source_Range& range_) const {
+    if (range_.file == k_invalid_file_id) {
+      return;  // Node without a source location (e.g. statement wrappers) - keep it that way
+    }
+    range_.file = file;
+    range_.start.line = shift(range_.start.line);
+    range_.end.line = shift(range_.end.line);
+  }
+
+  [[nodiscard]] std::size_t shift(std::size_t line_) const {
+    return static_cast<std::size_t>(static_cast<std::ptrdiff_t>(line_) + line_delta);
+  }
+
+  // Containers
+  template <typename T>
+  void operator()(std::shared_ptr<T>& node_) const {
+    if (node_) {
+      node_ = std::make_shared<T>(*node_);
+      (*this)(*node_);
+    }
+  }
+
+  template <typename T>
+  void operator()(std::optional<T>& node_) const {
+    if (node_) {
+      (*this)(*node_);
+    }
+  }
+
+  template <typename T>
+  void operator()(std::vector<T>& nodes_) const {
+    for (auto& node: nodes_) {
+      (*this)(node);
+    }
+  }
+
+  void operator()(std::string& /*text_*/) const {}
+
+  // Variants
+  void operator()(Type_Name& node_) const { std::visit(*this, static_cast<Type_Name::Base_Type&>(node_)); }
+  void operator()(String_Interp_Part& node_) const {
+    std::visit(*this, static_cast<String_Interp_Part::Base_Type&>(node_));
+  }
+  void operator()(Expr& node_) const { std::visit(*this, static_cast<Expr::Base_Type&>(node_)); }
+  void operator()(Statement& node_) const { std::visit(*this, static_cast<Statement::Base_Type&>(node_)); }
+  void operator()(Pattern& node_) const { std::visit(*this, static_cast<Pattern::Base_Type&>(node_)); }
+  void operator()(Enum_Variant& node_) const { std::visit(*this, static_cast<Enum_Variant::Base_Type&>(node_)); }
+
+  // Type names
+  void operator()(Function_Type& node_) const {
+    span(node_.span);
+    (*this)(node_.param_types);
+    (*this)(node_.return_type);
+  }
+  void operator()(Path_Type& node_) const {
+    span(node_.span);
+    (*this)(node_.segments);
+  }
+  void operator()(Array_Type& node_) const {
+    span(node_.span);
+    (*this)(node_.element_type);
+  }
+  void operator()(Tuple_Type& node_) const {
+    span(node_.span);
+    (*this)(node_.element_types);
+  }
+  void operator()(Type_Name_Segment& node_) const {
+    span(node_.span);
+    (*this)(node_.type_params);
+  }
+
+  // Generics
+  void operator()(Trait_Bound& node_) const {
+    span(node_.span);
+    (*this)(node_.trait_name);
+  }
+  void operator()(Type_Param& node_) const {
+    span(node_.span);
+    (*this)(node_.name);
+    (*this)(node_.bounds);
+  }
+  void operator()(Where_Predicate& node_) const {
+    span(node_.span);
+    (*this)(node_.type_name);
+    (*this)(node_.bounds);
+  }
+  void operator()(Where_Clause& node_) const {
+    span(node_.span);
+    (*this)(node_.predicates);
+  }
+
+  // Variable names
+  void operator()(Var_Name& node_) const {
+    span(node_.span);
+    (*this)(node_.segments);
+  }
+  void operator()(Var_Name_Segment& node_) const {
+    span(node_.span);
+    (*this)(node_.type_params);
+  }
+
+  // Literals
+  void operator()(String& node_) const { span(node_.span); }
+  void operator()(String_Interpolation& node_) const {
+    span(node_.span);
+    (*this)(node_.parts);
+  }
+  void operator()(Integer& node_) const { span(node_.span); }
+  void operator()(Float& node_) const { span(node_.span); }
+  void operator()(Char& node_) const { span(node_.span); }
+  void operator()(Bool_Literal& node_) const { span(node_.span); }
+  void operator()(Unit_Literal& node_) const { span(node_.span); }
+  void operator()(Field_Initializer& node_) const {
+    span(node_.span);
+    (*this)(node_.value);
+  }
+  void operator()(Struct_Literal& node_) const {
+    span(node_.span);
+    (*this)(node_.fields);
+  }
+  void operator()(Array_Literal& node_) const {
+    span(node_.span);
+    (*this)(node_.elements);
+  }
+  void operator()(Tuple_Literal& node_) const {
+    span(node_.span);
+    (*this)(node_.elements);
+  }
+
+  // Expressions
+  void operator()(Binary_Expr& node_) const {
+    span(node_.span);
+    (*this)(node_.lhs);
+    (*this)(node_.rhs);
+  }
+  void operator()(Unary_Expr& node_) const {
+    span(node_.span);
+    (*this)(node_.operand);
+  }
+  void operator()(Range_Expr& node_) const {
+    span(node_.span);
+    (*this)(node_.start);
+    (*this)(node_.end);
+  }
+  void operator()(Cast_Expr& node_) const {
+    span(node_.span);
+    (*this)(node_.expr);
+    (*this)(node_.target_type);
+  }
+  void operator()(Func_Call_Expr& node_) const {
+    span(node_.span);
+    (*this)(node_.name);
+    (*this)(node_.params);
+  }
+  void operator()(Field_Access_Expr& node_) const {
+    span(node_.span);
+    (*this)(node_.object);
+  }
+  void operator()(Index_Expr& node_) const {
+    span(node_.span);
+    (*this)(node_.object);
+    (*this)(node_.index);
+  }
+  void operator()(Block& node_) const {
+    span(node_.span);
+    (*this)(node_.statements);
+    (*this)(node_.trailing_expr);
+  }
+  void operator()(Else_If_Clause& node_) const {
+    span(node_.span);
+    (*this)(node_.condition);
+    (*this)(node_.then_block);
+  }
+  void operator()(If_Expr& node_) const {
+    span(node_.span);
+    (*this)(node_.condition);
+    (*this)(node_.then_block);
+    (*this)(node_.else_ifs);
+    (*this)(node_.else_block);
+  }
+  void operator()(While_Expr& node_) const {
+    span(node_.span);
+    (*this)(node_.condition);
+    (*this)(node_.body);
+  }
+  void operator()(For_Expr& node_) const {
+    span(node_.span);
+    (*this)(node_.pattern);
+    (*this)(node_.iterator);
+    (*this)(node_.body);
+  }
+  void operator()(Match_Arm& node_) const {
+    span(node_.span);
+    (*this)(node_.pattern);
+    (*this)(node_.guard);
+    (*this)(node_.result);
+  }
+  void operator()(Match_Expr& node_) const {
+    span(node_.span);
+    (*this)(node_.scrutinee);
+    (*this)(node_.arms);
+  }
+
+  // Statements
+  void operator()(Assignment_Statement& node_) const {
+    span(node_.span);
+    (*this)(node_.target);
+    (*this)(node_.value);
+  }
+  void operator()(Func_Call_Statement& node_) const {
+    span(node_.span);
+    (*this)(node_.expr);
+  }
+  void operator()(Expr_Statement& node_) const {
+    span(node_.span);
+    (*this)(node_.expr);
+  }
+  void operator()(Return_Statement& node_) const {
+    span(node_.span);
+    (*this)(node_.expr);
+  }
+  void operator()(Break_Statement& node_) const {
+    span(node_.span);
+    (*this)(node_.value);
+  }
+  void operator()(Continue_Statement& node_) const { span(node_.span); }
+  void operator()(If_Statement& node_) const {
+    span(node_.span);
+    (*this)(node_.expr);
+  }
+  void operator()(While_Statement& node_) const {
+    span(node_.span);
+    (*this)(node_.expr);
+  }
+  void operator()(For_Statement& node_) const {
+    span(node_.span);
+    (*this)(node_.expr);
+  }
+  void operator()(Let_Statement& node_) const {
+    span(node_.span);
+    (*this)(node_.pattern);
+    (*this)(node_.type);
+    (*this)(node_.value);
+  }
+
+  // Patterns
+  void operator()(Wildcard_Pattern& node_) const { span(node_.span); }
+  void operator()(Literal_Pattern& node_) const {
+    span(node_.span);
+    (*this)(node_.value);
+  }
+  void operator()(Simple_Pattern& node_) const { span(node_.span); }
+  void operator()(Field_Pattern& node_) const {
+    span(node_.span);
+    (*this)(node_.pattern);
+  }
+  void operator()(Struct_Pattern& node_) const {
+    span(node_.span);
+    (*this)(node_.type_name);
+    (*this)(node_.fields);
+  }
+  void operator()(Tuple_Pattern& node_) const {
+    span(node_.span);
+    (*this)(node_.elements);
+  }
+  void operator()(Enum_Pattern& node_) const {
+    span(node_.span);
+    (*this)(node_.type_name);
+    (*this)(node_.patterns);
+  }
+  void operator()(Or_Pattern& node_) const {
+    span(node_.span);
+    (*this)(node_.alternatives);
+  }
+
+  // Declarations
+  void operator()(Func_Param& node_) const {
+    span(node_.span);
+    (*this)(node_.type);
+  }
+  void operator()(Func_Decl& node_) const {
+    span(node_.span);
+    (*this)(node_.type_params);
+    (*this)(node_.func_params);
+    (*this)(node_.return_type);
+    (*this)(node_.where_clause);
+  }
+  void operator()(Func_Def& node_) const {
+    span(node_.span);
+    (*this)(node_.declaration);
+    (*this)(node_.body);
+  }
+  void operator()(Struct_Field& node_) const {
+    span(node_.span);
+    (*this)(node_.type);
+  }
+  void operator()(Struct_Def& node_) const {
+    span(node_.span);
+    (*this)(node_.type_params);
+    (*this)(node_.fields);
+    (*this)(node_.where_clause);
+  }
+  void operator()(Unit_Variant& node_) const { span(node_.span); }
+  void operator()(Tuple_Variant& node_) const {
+    span(node_.span);
+    (*this)(node_.tuple_fields);
+  }
+  void operator()(Struct_Variant& node_) const {
+    span(node_.span);
+    (*this)(node_.struct_fields);
+  }
+  void operator()(Enum_Def& node_) const {
+    span(node_.span);
+    (*this)(node_.type_params);
+    (*this)(node_.variants);
+    (*this)(node_.where_clause);
+  }
+  void operator()(Impl_Block& node_) const {
+    span(node_.span);
+    (*this)(node_.type_name);
+    (*this)(node_.type_params);
+    (*this)(node_.methods);
+    (*this)(node_.where_clause);
+  }
+  void operator()(Assoc_Type_Decl& node_) const {
+    span(node_.span);
+    (*this)(node_.bounds);
+  }
+  void operator()(Assoc_Type_Impl& node_) const {
+    span(node_.span);
+    (*this)(node_.type_value);
+  }
+  void operator()(Trait_Def& node_) const {
+    span(node_.span);
+    (*this)(node_.type_params);
+    (*this)(node_.assoc_types);
+    (*this)(node_.methods);
+    (*this)(node_.where_clause);
+  }
+  void operator()(Trait_Impl& node_) const {
+    span(node_.span);
+    (*this)(node_.trait_name);
+    (*this)(node_.type_name);
+    (*this)(node_.type_params);
+    (*this)(node_.assoc_type_impls);
+    (*this)(node_.methods);
+    (*this)(node_.where_clause);
+  }
+  void operator()(Type_Alias& node_) const {
+    span(node_.span);
+    (*this)(node_.type_params);
+    (*this)(node_.aliased_type);
+  }
+
+  // Module level
+  void operator()(Import_Item& node_) const { span(node_.span); }
+  void operator()(Import_Statement& node_) const {
+    span(node_.span);
+    (*this)(node_.items);
+  }
+  void operator()(Item& node_) const {
+    span(node_.span);
+    (*this)(node_.item);
+  }
+};
+
+}  // namespace
+
+Item rebase_spans(Item const& item_, std::ptrdiff_t line_delta_, File_Id file_) {
+  Item result = item_;
+  Span_Rebaser{.line_delta = line_delta_, .file = file_}(result);
+  return result;
+}
+
+Import_Statement rebase_spans(Import_Statement const& import_, std::ptrdiff_t line_delta_, File_Id file_) {
+  Import_Statement result = import_;
+  Span_Rebaser{.line_delta = line_delta_, .file = file_}(result);
+  return result;
+}
+
+}  // namespace life_lang::ast
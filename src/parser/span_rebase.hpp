@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstddef>
+
+#include "ast.hpp"
+
+namespace life_lang::ast {
+
+// ============================================================================
+// Span rebasing - reuse parsed subtrees after an edit elsewhere in the file
+// ============================================================================
+// Returns a copy of the node with every span moved by line_delta_ lines and
+// re-targeted to file_. Columns are left untouched, so only nodes that start on
+// a line after the edited region can be rebased this way.
+//
+// AST nodes share children through std::shared_ptr; rebasing clones each node on
+// the way down, so the original tree (possibly still referenced by an older
+// module) is never modified.
+
+[[nodiscard]] Item rebase_spans(Item const& item_, std::ptrdiff_t line_delta_, File_Id file_);
+[[nodiscard]] Import_Statement rebase_spans(Import_Statement const& import_, std::ptrdiff_t line_delta_, File_Id file_);
+
+}  // namespace life_lang::ast
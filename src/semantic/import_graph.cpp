@@ -0,0 +1,146 @@
+#include "import_graph.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+
+namespace life_lang::semantic {
+
+namespace {
+
+constexpr std::uint32_t k_unvisited = std::numeric_limits<std::uint32_t>::max();
+
+}  // namespace
+
+Import_Graph::Import_Graph(std::size_t node_count_, std::vector<Edge> edges_)
+    : m_offsets(node_count_ + 1, 0), m_edges(std::move(edges_)) {
+  // Stable: parallel edges keep their input order, so the first import statement stays first
+  std::ranges::stable_sort(m_edges, {}, &Edge::from);
+  for (auto const& edge: m_edges) {
+    ++m_offsets[edge.from + 1];
+  }
+  for (std::size_t i = 1; i < m_offsets.size(); ++i) {
+    m_offsets[i] += m_offsets[i - 1];
+  }
+}
+
+std::span<Import_Graph::Edge const> Import_Graph::out_edges(Node node_) const {
+  return std::span<Edge const>(m_edges).subspan(m_offsets[node_], m_offsets[node_ + 1] - m_offsets[node_]);
+}
+
+Import_Graph::Components Import_Graph::strongly_connected_components() const {
+  std::size_t const count = node_count();
+  Components result;
+  result.component_of.assign(count, k_unvisited);
+
+  std::vector<std::uint32_t> index(count, k_unvisited);  // DFS discovery order
+  std::vector<std::uint32_t> low_link(count, 0);
+  std::vector<bool> on_stack(count, false);
+  std::vector<Node> stack;  // Tarjan's node stack
+
+  // Explicit DFS call stack: node and the position of the next out-edge to follow
+  struct Frame {
+    Node node;
+    std::uint32_t next_edge;
+  };
+  std::vector<Frame> call_stack;
+  std::uint32_t next_index = 0;
+
+  auto const visit = [&](Node node_) {
+    index[node_] = next_index;
+    low_link[node_] = next_index;
+    ++next_index;
+    stack.push_back(node_);
+    on_stack[node_] = true;
+    call_stack.push_back(Frame{.node = node_, .next_edge = m_offsets[node_]});
+  };
+
+  for (Node root = 0; root < count; ++root) {
+    if (index[root] != k_unvisited) {
+      continue;
+    }
+    visit(root);
+
+    while (!call_stack.empty()) {
+      auto& frame = call_stack.back();
+      Node const node = frame.node;
+
+      if (frame.next_edge < m_offsets[node + 1]) {
+        Node const target = m_edges[frame.next_edge++].to;
+        if (index[target] == k_unvisited) {
+          visit(target);  // Invalidates frame
+        } else if (on_stack[target]) {
+          low_link[node] = std::min(low_link[node], index[target]);
+        }
+        continue;
+      }
+
+      // All edges followed: node is done
+      call_stack.pop_back();
+      if (!call_stack.empty()) {
+        Node const parent = call_stack.back().node;
+        low_link[parent] = std::min(low_link[parent], low_link[node]);
+      }
+
+      if (low_link[node] == index[node]) {
+        // node is the root of a component: pop it off the node stack
+        auto const component_index = static_cast<std::uint32_t>(result.components.size());
+        auto& component = result.components.emplace_back();
+        Node member = 0;
+        do {
+          member = stack.back();
+          stack.pop_back();
+          on_stack[member] = false;
+          result.component_of[member] = component_index;
+          component.push_back(member);
+        } while (member != node);
+      }
+    }
+  }
+
+  return result;
+}
+
+bool Import_Graph::is_cyclic(std::span<Node const> component_) const {
+  if (component_.size() > 1) {
+    return true;
+  }
+  if (component_.empty()) {
+    return false;
+  }
+  Node const node = component_.front();
+  return std::ranges::any_of(out_edges(node), [node](Edge const& edge_) { return edge_.to == node; });
+}
+
+std::vector<Import_Graph::Edge> Import_Graph::find_cycle(Node start_, Components const& components_) const {
+  std::uint32_t const component = components_.component_of[start_];
+
+  // BFS from start_ over edges inside the component; the first edge back to start_ closes a shortest cycle
+  std::vector<std::uint32_t> reached_by(node_count(), k_unvisited);  // Node -> index of the edge that reached it
+  std::vector<Node> queue{start_};
+  for (std::size_t head = 0; head < queue.size(); ++head) {
+    Node const node = queue[head];
+    for (std::uint32_t e = m_offsets[node]; e < m_offsets[node + 1]; ++e) {
+      Node const target = m_edges[e].to;
+      if (components_.component_of[target] != component) {
+        continue;
+      }
+      if (target == start_) {
+        // Walk the BFS tree back from node to start_
+        std::vector<Edge> cycle{m_edges[e]};
+        for (Node at = node; at != start_; at = m_edges[reached_by[at]].from) {
+          cycle.push_back(m_edges[reached_by[at]]);
+        }
+        std::ranges::reverse(cycle);
+        return cycle;
+      }
+      if (reached_by[target] == k_unvisited) {
+        reached_by[target] = e;
+        queue.push_back(target);
+      }
+    }
+  }
+  return {};
+}
+
+}  // namespace life_lang::semantic
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace life_lang::semantic {
+
+// ============================================================================
+// Import_Graph - Module dependency graph in compressed sparse row form
+// ============================================================================
+// Nodes are dense module ids; an edge from -> to means "from imports to".
+// Out-edges of node n are edges()[offsets[n] .. offsets[n + 1]), so the whole
+// graph is two flat arrays no matter how many modules there are.
+//
+// Each edge carries a caller-chosen label (e.g. the index of the import
+// statement) so that findings can be mapped back to source spans.
+//
+// Example:
+//   Import_Graph const graph(3, {{.from = 0, .to = 1, .label = 0}, {.from = 1, .to = 0, .label = 0}});
+//   auto const sccs = graph.strongly_connected_components();
+//   // sccs.components == {{1, 0}, {2}}: the cycle 0 <-> 1, then the isolated node 2
+
+class Import_Graph {
+public:
+  using Node = std::uint32_t;
+
+  struct Edge {
+    Node from{};
+    Node to{};
+    std::uint32_t label{};
+
+    [[nodiscard]] bool operator==(Edge const&) const = default;
+  };
+
+  struct Components {
+    // Dependencies first: a component comes after every component it has an edge to,
+    // so this is a valid processing order (reverse topological order of the graph)
+    std::vector<std::vector<Node>> components;
+    std::vector<std::uint32_t> component_of;  // Node -> index into components
+  };
+
+  // Edges may come in any order; parallel edges are kept (the first one per (from, to) wins in find_cycle)
+  Import_Graph(std::size_t node_count_, std::vector<Edge> edges_);
+
+  [[nodiscard]] std::size_t node_count() const { return m_offsets.size() - 1; }
+  [[nodiscard]] std::span<Edge const> out_edges(Node node_) const;
+
+  // Tarjan's algorithm, iterative (no recursion depth limit on long import chains), O(V + E)
+  [[nodiscard]] Components strongly_connected_components() const;
+
+  // True if the component is a cycle: more than one node, or a single node importing itself
+  [[nodiscard]] bool is_cyclic(std::span<Node const> component_) const;
+
+  // A shortest cycle through start_ that stays inside start_'s component, as the edges taken
+  // (edges.front().from == edges.back().to == start_); empty if start_ is on no cycle
+  [[nodiscard]] std::vector<Edge> find_cycle(Node start_, Components const& components_) const;
+
+private:
+  std::vector<std::uint32_t> m_offsets;  // node_count + 1 entries
+  std::vector<Edge> m_edges;             // Sorted by (from, input order)
+};
+
+}  // namespace life_lang::semantic
@@ -0,0 +1,345 @@
+#include "module_interface.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <variant>
+#include <vector>
+
+#include "content_hash.hpp"
+#include "mapped_file.hpp"
+#include "module_loader.hpp"
+#include "parser/ast.hpp"
+#include "parser/ast_binary.hpp"
+
+namespace life_lang::semantic {
+
+namespace {
+
+// Per-thread random suffix for temporaries: unique across threads and processes
+std::uint64_t temp_suffix() {
+  thread_local std::mt19937_64 engine{[] {
+    std::random_device device;
+    return (std::uint64_t{device()} << 32) | device();
+  }()};
+  return engine();
+}
+
+// The signature of a function: the body is replaced by an empty block at the same place
+ast::Func_Def signature_of(ast::Func_Def const& func_) {
+  return ast::Func_Def{
+      .span = func_.span,
+      .is_pub = func_.is_pub,
+      .declaration = func_.declaration,
+      .body = ast::Block{.span = func_.body.span, .statements = {}, .trailing_expr = std::nullopt},
+  };
+}
+
+// Methods other modules can call: the pub ones of an inherent impl, all of a trait impl's
+std::vector<ast::Func_Def> method_signatures(std::vector<ast::Func_Def> const& methods_, bool pub_only_) {
+  std::vector<ast::Func_Def> signatures;
+  for (auto const& method: methods_) {
+    if (!pub_only_ || method.is_pub) {
+      signatures.push_back(signature_of(method));
+    }
+  }
+  return signatures;
+}
+
+// What dependents see of a private definition: its name, generic parameters and (for a function)
+// signature, so that importing it fails with "not marked pub" as it does against the sources
+ast::Statement private_stub(ast::Func_Def const& func_) {
+  return std::make_shared<ast::Func_Def>(signature_of(func_));
+}
+
+ast::Statement private_stub(ast::Struct_Def const& struct_) {
+  return std::make_shared<ast::Struct_Def>(ast::Struct_Def{
+      .span = struct_.span,
+      .name = struct_.name,
+      .type_params = struct_.type_params,
+      .fields = {},
+      .where_clause = std::nullopt,
+  });
+}
+
+ast::Statement private_stub(ast::Enum_Def const& enum_) {
+  return std::make_shared<ast::Enum_Def>(ast::Enum_Def{
+      .span = enum_.span,
+      .name = enum_.name,
+      .type_params = enum_.type_params,
+      .variants = {},
+      .where_clause = std::nullopt,
+  });
+}
+
+ast::Statement private_stub(ast::Trait_Def const& trait_) {
+  return std::make_shared<ast::Trait_Def>(ast::Trait_Def{
+      .span = trait_.span,
+      .name = trait_.name,
+      .type_params = trait_.type_params,
+      .assoc_types = {},
+      .methods = {},
+      .where_clause = std::nullopt,
+  });
+}
+
+ast::Statement private_stub(ast::Type_Alias const& alias_) {
+  return std::make_shared<ast::Type_Alias>(alias_);  // Nothing more than a name and the aliased type
+}
+
+// The interface part of one item, or std::nullopt if dependents can't see it
+std::optional<ast::Statement> interface_item(ast::Item const& item_) {
+  return std::visit(
+      [&item_](auto const& node_) -> std::optional<ast::Statement> {
+        using T = std::decay_t<decltype(node_)>;
+        if constexpr (std::is_same_v<T, std::shared_ptr<ast::Func_Def>>) {
+          if (!item_.is_pub) {
+            return private_stub(*node_);
+          }
+          return std::make_shared<ast::Func_Def>(signature_of(*node_));
+        } else if constexpr (
+            std::is_same_v<T, std::shared_ptr<ast::Struct_Def>> || std::is_same_v<T, std::shared_ptr<ast::Enum_Def>> ||
+            std::is_same_v<T, std::shared_ptr<ast::Trait_Def>> || std::is_same_v<T, std::shared_ptr<ast::Type_Alias>>
+        ) {
+          if (!item_.is_pub) {
+            return private_stub(*node_);
+          }
+          return std::make_shared<typename T::element_type>(*node_);
+        } else if constexpr (std::is_same_v<T, std::shared_ptr<ast::Impl_Block>>) {
+          auto impl = std::make_shared<ast::Impl_Block>(ast::Impl_Block{
+              .span = node_->span,
+              .type_name = node_->type_name,
+              .type_params = node_->type_params,
+              .methods = method_signatures(node_->methods, true),
+              .where_clause = node_->where_clause,
+          });
+          if (impl->methods.empty()) {
+            return std::nullopt;
+          }
+          return impl;
+        } else if constexpr (std::is_same_v<T, std::shared_ptr<ast::Trait_Impl>>) {
+          return std::make_shared<ast::Trait_Impl>(ast::Trait_Impl{
+              .span = node_->span,
+              .trait_name = node_->trait_name,
+              .type_name = node_->type_name,
+              .type_params = node_->type_params,
+              .assoc_type_impls = node_->assoc_type_impls,
+              .methods = method_signatures(node_->methods, false),
+              .where_clause = node_->where_clause,
+          });
+        } else {
+          return std::nullopt;  // Not a module-level definition
+        }
+      },
+      static_cast<ast::Statement::Base_Type const&>(item_.item)
+  );
+}
+
+// The File_Id each of descriptor_'s files was loaded under, found through the spans of module_
+// (k_invalid_file_id for a file that contributed nothing to it)
+std::vector<File_Id> loaded_file_ids(
+    Module_Descriptor const& descriptor_,
+    ast::Module const& module_,
+    Source_File_Registry const& registry_
+) {
+  std::vector<File_Id> files(descriptor_.files.size(), k_invalid_file_id);
+  auto const note = [&](Source_Range const& span_) {
+    if (std::ranges::find(files, span_.file) != files.end()) {
+      return;
+    }
+    auto const path = registry_.get_path(span_.file);
+    for (std::size_t i = 0; i < files.size(); ++i) {
+      if (files[i] == k_invalid_file_id && descriptor_.files[i].string() == path) {
+        files[i] = span_.file;
+        return;
+      }
+    }
+  };
+  for (auto const& import: module_.imports) {
+    note(import.span);
+  }
+  for (auto const& item: module_.items) {
+    note(item.span);
+  }
+  return files;
+}
+
+}  // namespace
+
+std::optional<std::uint64_t> module_content_hash(Module_Descriptor const& descriptor_) {
+  std::uint64_t hash = hash_bytes({}, descriptor_.files.size());
+  for (auto const& path: descriptor_.files) {
+    auto const file = Mapped_File::open(path);
+    if (!file) {
+      return std::nullopt;
+    }
+    // Names too: the same text under another file name is another module layout
+    hash = hash_bytes(path.filename().string(), hash);
+    hash = hash_bytes(file->bytes(), hash);
+  }
+  return hash;
+}
+
+ast::Module module_interface(ast::Module const& module_) {
+  ast::Module interface{.span = module_.span, .imports = module_.imports, .items = {}};
+  for (auto const& item: module_.items) {
+    if (auto node = interface_item(item)) {
+      interface.items.push_back(ast::Item{.span = item.span, .is_pub = item.is_pub, .item = std::move(*node)});
+    }
+  }
+  return interface;
+}
+
+std::filesystem::path interface_file_path(std::filesystem::path const& directory_, std::string_view module_path_) {
+  return directory_ / (std::string{module_path_} + std::string{k_interface_extension});
+}
+
+bool write_interface_file(
+    std::filesystem::path const& path_,
+    ast::Module const& module_,
+    std::span<File_Id const> files_,
+    std::uint64_t content_hash_
+) {
+  // One encoded module per source file, in descriptor order, each holding what came from that file
+  ast::Module const interface = module_interface(module_);
+  std::vector<ast::Module> parts(files_.size());
+  auto const part_of = [&](Source_Range const& span_) -> ast::Module* {
+    auto const file = std::ranges::find(files_, span_.file);
+    return file == files_.end() ? nullptr : &parts[static_cast<std::size_t>(file - files_.begin())];
+  };
+  for (auto const& import: interface.imports) {
+    auto* const part = part_of(import.span);
+    if (part == nullptr) {
+      return false;  // Not from any of the module's files
+    }
+    part->imports.push_back(import);
+  }
+  for (auto const& item: interface.items) {
+    auto* const part = part_of(item.span);
+    if (part == nullptr) {
+      return false;
+    }
+    part->items.push_back(item);
+  }
+  std::string bytes;
+  for (auto const& part: parts) {
+    bytes += ast::encode_module(part, content_hash_);
+  }
+
+  // Readers never see a half-written interface: write to a private temporary (concurrent emits into
+  // one directory each get their own), then rename over the old one
+  auto const temp_path = std::filesystem::path{path_}.concat(std::format(".{:016x}.tmp", temp_suffix()));
+  std::error_code ec;
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out || !out.write(bytes.data(), static_cast<std::streamsize>(bytes.size())) || !out.flush()) {
+      out.close();
+      std::filesystem::remove(temp_path, ec);
+      return false;
+    }
+  }
+  std::filesystem::rename(temp_path, path_, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return false;
+  }
+  return true;
+}
+
+bool interface_file_is_current(std::filesystem::path const& path_, std::uint64_t content_hash_) {
+  auto const file = Mapped_File::open(path_);
+  if (!file) {
+    return false;
+  }
+  auto const header = ast::read_header(file->bytes());
+  return header.has_value() && header->source_hash == content_hash_;
+}
+
+std::optional<ast::Module> read_interface_file(
+    std::filesystem::path const& path_,
+    std::uint64_t content_hash_,
+    std::span<File_Id const> files_
+) {
+  auto const file = Mapped_File::open(path_);
+  if (!file) {
+    return std::nullopt;
+  }
+  ast::Module interface;
+  std::string_view rest = file->bytes();
+  for (File_Id const file_id: files_) {
+    auto const header = ast::read_header(rest);
+    if (!header || header->source_hash != content_hash_) {
+      return std::nullopt;  // Written for other sources (or by another compiler build)
+    }
+    auto const size = ast::encoded_size(rest);
+    if (!size) {
+      return std::nullopt;
+    }
+    auto part = ast::decode_module(rest.substr(0, *size), file_id);
+    if (!part) {
+      return std::nullopt;
+    }
+    std::ranges::move(part->imports, std::back_inserter(interface.imports));
+    std::ranges::move(part->items, std::back_inserter(interface.items));
+    rest.remove_prefix(*size);
+  }
+  if (!rest.empty()) {
+    return std::nullopt;  // Written for a module with more files
+  }
+  return interface;
+}
+
+bool emit_module_interfaces(
+    std::filesystem::path const& src_root_,
+    std::filesystem::path const& out_dir_,
+    Diagnostic_Manager& diagnostics_,
+    Thread_Pool& pool_
+) {
+  auto const descriptors =
+      Module_Loader::discover_modules(src_root_, Discovery_Options{.pool = &pool_, .manifest_path = {}});
+
+  // Hashed before parsing: a file edited while we parse leaves a stale (never a wrongly fresh) interface
+  std::vector<std::optional<std::uint64_t>> hashes;
+  hashes.reserve(descriptors.size());
+  for (auto const& descriptor: descriptors) {
+    hashes.push_back(module_content_hash(descriptor));
+  }
+
+  auto const modules = Module_Loader::load_modules(descriptors, diagnostics_, pool_);
+
+  std::error_code ec;
+  std::filesystem::create_directories(out_dir_, ec);
+  if (ec) {
+    diagnostics_.add_error(
+        Source_Range{}, std::format("cannot create interface directory '{}': {}", out_dir_.string(), ec.message())
+    );
+    return false;
+  }
+
+  bool ok = true;
+  for (std::size_t i = 0; i < descriptors.size(); ++i) {
+    if (!modules[i].has_value()) {
+      return false;  // Load errors are already reported
+    }
+    if (!hashes[i].has_value()) {
+      continue;  // A file vanished before it was parsed; dependents will parse the module instead
+    }
+    auto const path = interface_file_path(out_dir_, descriptors[i].module_path_string());
+    auto const files = loaded_file_ids(descriptors[i], *modules[i], diagnostics_.registry());
+    if (!write_interface_file(path, *modules[i], files, *hashes[i])) {
+      diagnostics_.add_error(Source_Range{}, std::format("cannot write interface file '{}'", path.string()));
+      ok = false;
+    }
+  }
+  return ok;
+}
+
+}  // namespace life_lang::semantic
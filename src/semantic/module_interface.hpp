@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <string_view>
+
+#include "../diagnostics.hpp"
+
+namespace life_lang {
+class Thread_Pool;
+namespace ast {
+struct Module;
+}
+}  // namespace life_lang
+
+namespace life_lang::semantic {
+
+struct Module_Descriptor;
+
+// ============================================================================
+// Module interface files - the surface of a module, without its bodies
+// ============================================================================
+// An interface holds what dependents of a module can see: its imports, its pub
+// structs, enums, traits, type aliases and function signatures, and its impl
+// blocks and trait impls reduced to the method signatures other modules can call.
+// Function bodies are dropped. Private items keep only their names, generic
+// parameters and function signatures, so importing one is still reported as
+// "not marked pub" rather than "not found".
+//
+// Interfaces are files named after the module path ("Std.Collections.lli"),
+// holding one binary AST (ast_binary.hpp) per .life file of the module, in
+// descriptor order. Every header's source hash is the module's content hash
+// (module_content_hash), taken before the module was parsed: an interface is up
+// to date exactly when the module's .life files still hash to it. Spans keep
+// the line/column they had in the sources, and each part is read with the
+// File_Id of its own .life file, so diagnostics point into the real sources.
+//
+// Example:
+//   lifec --emit-interfaces src/ build/interfaces/
+//   context.set_interface_dir("build/interfaces/");  // Dependencies now load from interfaces
+
+inline constexpr std::string_view k_interface_extension = ".lli";
+
+// Hash of the names and bytes of a module's files, in descriptor order;
+// std::nullopt if any of them can't be read
+[[nodiscard]] std::optional<std::uint64_t> module_content_hash(Module_Descriptor const& descriptor_);
+
+// The interface of a loaded module (module_ itself is left untouched)
+[[nodiscard]] ast::Module module_interface(ast::Module const& module_);
+
+// Where the interface of module_path_ ("Std.Collections") lives under directory_
+[[nodiscard]] std::filesystem::path
+interface_file_path(std::filesystem::path const& directory_, std::string_view module_path_);
+
+// Write module_interface(module_) to path_, replacing any older file. files_ holds the File_Id each
+// of the module's files was loaded under, in descriptor order (k_invalid_file_id for one that added
+// nothing). false if it can't be written or module_ has spans outside those files.
+[[nodiscard]] bool write_interface_file(
+    std::filesystem::path const& path_,
+    ast::Module const& module_,
+    std::span<File_Id const> files_,
+    std::uint64_t content_hash_
+);
+
+// Whether path_ holds an interface written for content_hash_ by this compiler build (reads the first header only)
+[[nodiscard]] bool interface_file_is_current(std::filesystem::path const& path_, std::uint64_t content_hash_);
+
+// The interface stored at path_ if it was written for content_hash_ by this compiler build, with
+// the spans of the module's i-th file stamped with files_[i]; std::nullopt if it is missing, stale,
+// corrupt or written for another number of files
+[[nodiscard]] std::optional<ast::Module> read_interface_file(
+    std::filesystem::path const& path_,
+    std::uint64_t content_hash_,
+    std::span<File_Id const> files_
+);
+
+// Load every module under src_root_ and write its interface into out_dir_ (created if needed).
+// Parse and duplicate-definition errors are reported to diagnostics_ and nothing is written for
+// the failing module or the ones after it. Returns false if any module failed or any write failed.
+[[nodiscard]] bool emit_module_interfaces(
+    std::filesystem::path const& src_root_,
+    std::filesystem::path const& out_dir_,
+    Diagnostic_Manager& diagnostics_,
+    Thread_Pool& pool_
+);
+
+}  // namespace life_lang::semantic
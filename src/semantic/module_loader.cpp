@@ -1,15 +1,22 @@
 #include "module_loader.hpp"
 
 #include <algorithm>
-#include <cctype>
+#include <charconv>
 #include <format>
 #include <fstream>
-#include <map>
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <unordered_map>
 
+#include "cancellation.hpp"
+#include "char_class.hpp"
 #include "diagnostics.hpp"
 #include "parser/ast.hpp"
 #include "parser/parser.hpp"
+#include "parse_cache.hpp"
+#include "thread_pool.hpp"
 
 namespace life_lang::semantic {
 
@@ -51,10 +58,10 @@ std::string Module_Loader::dir_name_to_module_name(std::string_view dir_name_) {
       result += '_';
       capitalize_next = true;
     } else if (capitalize_next) {
-      result += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+      result += to_upper(c);
       capitalize_next = false;
     } else {
-      result += static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+      result += to_lower(c);
     }
   }
 
@@ -78,20 +85,167 @@ Module_Loader::derive_module_path(std::filesystem::path const& src_root_, std::f
   auto canonical_module_dir = std::filesystem::canonical(module_dir_);
 
   // Get path relative to src/ root
-  auto relative = canonical_module_dir.lexically_relative(canonical_src_root);
+  return module_path_from_relative(canonical_module_dir.lexically_relative(canonical_src_root));
+}
 
+std::vector<std::string> Module_Loader::module_path_from_relative(std::filesystem::path const& relative_) {
   // Build module path from directory structure
   std::vector<std::string> path_components;
-  for (auto const& component: relative) {
+  for (auto const& component: relative_) {
     if (component != ".") {
       path_components.push_back(dir_name_to_module_name(component.string()));
     }
   }
-
   return path_components;
 }
 
+namespace {
+
+// One directory under src/ as seen by the walk (or recorded in the manifest)
+struct Scanned_Dir {
+  std::filesystem::path path;
+  std::filesystem::file_time_type::rep mtime{};
+  std::vector<std::filesystem::path> files;  // .life files, sorted
+};
+
+// List one directory: its .life files and its subdirectories (symlinked directories are not
+// followed, like recursive_directory_iterator's default)
+Scanned_Dir scan_dir(std::filesystem::path const& dir_, std::vector<std::filesystem::path>& subdirs_) {
+  Scanned_Dir result{.path = dir_, .mtime = {}, .files = {}};
+  std::error_code ec;
+  result.mtime = std::filesystem::last_write_time(dir_, ec).time_since_epoch().count();
+  for (std::filesystem::directory_iterator it{dir_, ec}, end; !ec && it != end; it.increment(ec)) {
+    auto const& entry = *it;
+    if (entry.is_directory(ec) && !entry.is_symlink(ec)) {
+      subdirs_.push_back(entry.path());
+    } else if (entry.is_regular_file(ec) && entry.path().extension() == ".life") {
+      result.files.push_back(entry.path());
+    }
+  }
+  std::ranges::sort(result.files);
+  return result;
+}
+
+// Walk the tree below root_, one task per directory when a pool is given
+std::vector<Scanned_Dir> walk_tree(std::filesystem::path const& root_, Thread_Pool* pool_) {
+  std::vector<Scanned_Dir> dirs;
+  if (pool_ == nullptr) {
+    std::vector<std::filesystem::path> pending{root_};
+    while (!pending.empty()) {
+      auto const dir = std::move(pending.back());
+      pending.pop_back();
+      dirs.push_back(scan_dir(dir, pending));
+    }
+    return dirs;
+  }
+
+  std::mutex mutex;
+  std::function<void(std::filesystem::path)> visit = [&](std::filesystem::path dir_) {
+    std::vector<std::filesystem::path> subdirs;
+    auto scanned = scan_dir(dir_, subdirs);
+    for (auto& subdir: subdirs) {
+      pool_->submit([&visit, subdir = std::move(subdir)] { visit(subdir); });
+    }
+    std::lock_guard const lock(mutex);
+    dirs.push_back(std::move(scanned));
+  };
+  pool_->submit([&] { visit(root_); });
+  pool_->wait();
+  return dirs;
+}
+
+// Manifest format (text, one record per line):
+//   life-lang-manifest 1
+//   root <canonical src root>
+//   dir <mtime> <directory>
+//   file <name>              (belongs to the preceding dir)
+constexpr std::string_view k_manifest_header = "life-lang-manifest 1";
+
+std::optional<std::vector<Scanned_Dir>>
+read_manifest(std::filesystem::path const& manifest_path_, std::filesystem::path const& root_) {
+  std::ifstream in(manifest_path_);
+  std::string line;
+  if (!in || !std::getline(in, line) || line != k_manifest_header) {
+    return std::nullopt;
+  }
+  if (!std::getline(in, line) || line != std::format("root {}", root_.string())) {
+    return std::nullopt;
+  }
+
+  std::vector<Scanned_Dir> dirs;
+  while (std::getline(in, line)) {
+    if (line.starts_with("dir ")) {
+      auto const space = line.find(' ', 4);
+      if (space == std::string::npos) {
+        return std::nullopt;
+      }
+      Scanned_Dir dir{.path = line.substr(space + 1), .mtime = {}, .files = {}};
+      if (std::from_chars(line.data() + 4, line.data() + space, dir.mtime).ec != std::errc{}) {
+        return std::nullopt;
+      }
+      dirs.push_back(std::move(dir));
+    } else if (line.starts_with("file ") && !dirs.empty()) {
+      dirs.back().files.push_back(dirs.back().path / line.substr(5));
+    } else {
+      return std::nullopt;
+    }
+  }
+
+  // Valid only if no directory changed since it was recorded
+  for (auto const& dir: dirs) {
+    std::error_code ec;
+    auto const mtime = std::filesystem::last_write_time(dir.path, ec);
+    if (ec || mtime.time_since_epoch().count() != dir.mtime) {
+      return std::nullopt;
+    }
+  }
+  return dirs;
+}
+
+// Best effort: the manifest is a cache, failing to write it only costs the next walk
+void write_manifest(
+    std::filesystem::path const& manifest_path_,
+    std::filesystem::path const& root_,
+    std::vector<Scanned_Dir> const& dirs_
+) {
+  auto const has_newline = [](std::filesystem::path const& path_) {
+    return path_.string().find('\n') != std::string::npos;
+  };
+  if (has_newline(root_)) {
+    return;  // Not representable in the line-based format
+  }
+
+  std::string text = std::format("{}\nroot {}\n", k_manifest_header, root_.string());
+  for (auto const& dir: dirs_) {
+    if (has_newline(dir.path) || std::ranges::any_of(dir.files, has_newline)) {
+      return;
+    }
+    text += std::format("dir {} {}\n", dir.mtime, dir.path.string());
+    for (auto const& file: dir.files) {
+      text += std::format("file {}\n", file.filename().string());
+    }
+  }
+
+  // Write to a temporary and rename, so concurrent readers never see a torn manifest
+  auto const temp_path = std::filesystem::path{manifest_path_}.concat(".tmp");
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out || !(out << text)) {
+      return;
+    }
+  }
+  std::error_code ec;
+  std::filesystem::rename(temp_path, manifest_path_, ec);
+}
+
+}  // namespace
+
 std::vector<Module_Descriptor> Module_Loader::discover_modules(std::filesystem::path const& src_root_) {
+  return discover_modules(src_root_, Discovery_Options{});
+}
+
+std::vector<Module_Descriptor>
+Module_Loader::discover_modules(std::filesystem::path const& src_root_, Discovery_Options const& options_) {
   std::vector<Module_Descriptor> modules;
 
   if (!std::filesystem::exists(src_root_) || !std::filesystem::is_directory(src_root_)) {
@@ -99,51 +253,145 @@ std::vector<Module_Descriptor> Module_Loader::discover_modules(std::filesystem::
   }
 
   // Canonicalize src_root to absolute path for consistent comparisons
-  auto canonical_src_root = std::filesystem::canonical(src_root_);
+  auto const canonical_src_root = std::filesystem::canonical(src_root_);
+
+  std::optional<std::vector<Scanned_Dir>> cached;
+  if (!options_.manifest_path.empty()) {
+    cached = read_manifest(options_.manifest_path, canonical_src_root);
+  }
+  std::vector<Scanned_Dir> dirs = cached ? std::move(*cached) : walk_tree(canonical_src_root, options_.pool);
+  std::ranges::sort(dirs, {}, &Scanned_Dir::path);
+  if (!cached && !options_.manifest_path.empty()) {
+    write_manifest(options_.manifest_path, canonical_src_root, dirs);
+  }
 
-  // Recursively scan src/ directory
-  for (auto const& entry: std::filesystem::recursive_directory_iterator(canonical_src_root)) {
-    if (!entry.is_regular_file()) {
+  // Directory -> module index; each directory is walked once, so this also guards the
+  // manifest against a directory recorded twice
+  std::unordered_map<std::string, std::size_t> module_index;
+  module_index.reserve(dirs.size());
+  for (auto& dir: dirs) {
+    if (dir.files.empty()) {
       continue;
     }
-
-    // Check if it's a .life file
-    if (entry.path().extension() != ".life") {
+    auto const [it, inserted] = module_index.try_emplace(dir.path.string(), modules.size());
+    if (!inserted) {
+      auto& files = modules[it->second].files;
+      files.insert(files.end(), dir.files.begin(), dir.files.end());
       continue;
     }
+    // The walk stays below the canonical root without following symlinks, so the relative
+    // path needs no further canonicalization
+    modules.push_back(
+        Module_Descriptor{
+            .path = module_path_from_relative(dir.path.lexically_relative(canonical_src_root)),
+            .directory = dir.path,
+            .files = std::move(dir.files),
+        }
+    );
+  }
 
-    auto const& file_path = entry.path();
-    auto const parent_dir = file_path.parent_path();
+  return modules;
+}
 
-    // Check if we already have a module for this directory
-    auto it = std::ranges::find_if(modules, [&](auto const& mod_) { return mod_.directory == parent_dir; });
+std::optional<std::filesystem::path>
+Module_Loader::find_module_dir(std::filesystem::path const& parent_, std::string const& component_) {
+  std::error_code ec;
+  auto const is_plain_dir = [&ec](std::filesystem::path const& path_) {
+    return std::filesystem::is_directory(std::filesystem::symlink_status(path_, ec));
+  };
+
+  // Fast path: the conventional directory name, a single stat
+  std::string lowered(component_.size(), '\0');
+  std::ranges::transform(component_, lowered.begin(), to_lower);
+  auto candidate = parent_ / lowered;
+  if (is_plain_dir(candidate) && dir_name_to_module_name(lowered) == component_) {
+    return candidate;
+  }
 
-    if (it != modules.end()) {
-      // Add file to existing module
-      it->files.push_back(file_path);
-    } else {
-      // Create new module descriptor
-      // Derive module path components from directory relative to src/
-      auto path_components = derive_module_path(canonical_src_root, parent_dir);
-
-      modules.push_back(
-          Module_Descriptor{
-              .path = std::move(path_components),
-              .directory = parent_dir,
-              .files = {file_path},
-          }
-      );
+  // Any other spelling that maps to the same module name (smallest path wins, as in the walk order)
+  std::optional<std::filesystem::path> found;
+  for (std::filesystem::directory_iterator it{parent_, ec}, end; !ec && it != end; it.increment(ec)) {
+    auto const& path = it->path();
+    if (is_plain_dir(path) && dir_name_to_module_name(path.filename().string()) == component_ &&
+        (!found || path < *found)) {
+      found = path;
     }
   }
+  return found;
+}
 
-  return modules;
+std::optional<Module_Descriptor>
+Module_Loader::locate_module(std::filesystem::path const& src_root_, std::vector<std::string> const& module_path_) {
+  if (module_path_.empty()) {
+    return std::nullopt;
+  }
+  std::error_code ec;
+  auto dir = std::filesystem::canonical(src_root_, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+
+  for (auto const& component: module_path_) {
+    auto next = find_module_dir(dir, component);
+    if (!next) {
+      return std::nullopt;
+    }
+    dir = std::move(*next);
+  }
+
+  std::vector<std::filesystem::path> subdirs;  // Submodules are separate modules
+  auto scanned = scan_dir(dir, subdirs);
+  if (scanned.files.empty()) {
+    return std::nullopt;
+  }
+  return Module_Descriptor{.path = module_path_, .directory = std::move(dir), .files = std::move(scanned.files)};
+}
+
+std::optional<Module_Descriptor>
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+Module_Loader::describe_directory(std::filesystem::path const& src_root_, std::filesystem::path const& directory_) {
+  std::error_code ec;
+  auto const root = std::filesystem::canonical(src_root_, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  auto dir = std::filesystem::canonical(directory_, ec);
+  if (ec || !std::filesystem::is_directory(dir, ec)) {
+    return std::nullopt;
+  }
+  auto const relative = dir.lexically_relative(root);
+  if (relative.empty() || *relative.begin() == "..") {
+    return std::nullopt;
+  }
+
+  std::vector<std::filesystem::path> subdirs;
+  auto scanned = scan_dir(dir, subdirs);
+  if (scanned.files.empty()) {
+    return std::nullopt;
+  }
+  return Module_Descriptor{
+      .path = module_path_from_relative(relative), .directory = std::move(dir), .files = std::move(scanned.files)
+  };
 }
 
 namespace {
+// Parsers are recycled per thread: each file rebinds the thread's parser with reset()
+// instead of constructing and tearing down a fresh one
+parser::Parser& thread_parser(Diagnostic_Engine& diagnostics_) {
+  thread_local std::unique_ptr<parser::Parser> parser;
+  if (parser == nullptr) {
+    parser = std::make_unique<parser::Parser>(diagnostics_);
+  } else {
+    parser->reset(diagnostics_);
+  }
+  return *parser;
+}
+
 // Helper to extract the name from an Item (function, struct, enum, trait, type alias)
-std::optional<std::string> get_item_name(ast::Item const& item_) {
+// The view points into the item's node, which is shared and never moves with the Item
+std::optional<std::string_view> get_item_name(ast::Item const& item_) {
   return std::visit(
-      [](auto const& stmt_) -> std::optional<std::string> {
+      [](auto const& stmt_) -> std::optional<std::string_view> {
         using T = std::decay_t<decltype(stmt_)>;
         if constexpr (std::same_as<T, std::shared_ptr<ast::Func_Def>>) {
           return stmt_->declaration.name;
@@ -159,67 +407,140 @@ std::optional<std::string> get_item_name(ast::Item const& item_) {
       item_.item
   );
 }
-}  // namespace
 
-std::optional<ast::Module>
-Module_Loader::load_module(Module_Descriptor const& descriptor_, Diagnostic_Manager& diagnostics_) {
-  ast::Module merged_module;
+// Outcome of reading and parsing one file of a module
+struct Parsed_File {
+  bool opened = false;
+  bool cancelled = false;
+  std::optional<ast::Module> module;
+  std::vector<Diagnostic> diagnostics;  // Parser diagnostics, merged into the manager in file order
+};
+
+// Read and parse one file. A valid file_id_ is a slot from reserve_files(), or the earlier
+// registration of a file being reparsed, that receives the text; otherwise the file is
+// registered once read. Safe to call from several threads at once.
+// With a cache, a clean earlier parse of the same bytes is reused instead of parsing again.
+Parsed_File parse_file(
+    std::filesystem::path const& file_path_,
+    File_Id file_id_,
+    Source_File_Registry& registry_,
+    Cancellation_Token const* cancel_,
+    Parse_Cache* cache_
+) {
+  Parsed_File result;
+  if (cancel_ != nullptr && cancel_->is_cancelled()) {
+    result.cancelled = true;
+    return result;
+  }
 
-  // Track defined names: name -> (file_path, span) for error reporting
-  std::map<std::string, std::pair<std::filesystem::path, Source_Range>> defined_names;
-  bool has_duplicate = false;
+  std::ifstream file(file_path_);
+  if (!file) {
+    return result;  // File doesn't exist or can't be opened
+  }
+  result.opened = true;
+  std::string source(std::istreambuf_iterator<char>(file), {});
+  std::uint64_t const cache_key = cache_ != nullptr ? Parse_Cache::key_for(source) : 0;
+
+  // The text is registered either way: diagnostics of later passes quote it
+  File_Id file_id = file_id_;
+  if (file_id == k_invalid_file_id) {
+    file_id = registry_.register_file(file_path_.string(), std::move(source));
+  } else {
+    registry_.set_source(file_id, std::move(source));
+  }
 
-  // Parse each file in the module
-  for (auto const& file_path: descriptor_.files) {
-    // Read file contents
-    std::ifstream file(file_path);
-    if (!file) {
-      // File doesn't exist or can't be opened
-      return std::nullopt;
+  if (cache_ != nullptr) {
+    if (auto cached = cache_->load(cache_key, file_id)) {
+      result.module = std::move(cached);
+      return result;  // Only clean parses are cached, so there is nothing to report
     }
+  }
 
-    std::string source(std::istreambuf_iterator<char>(file), {});
-    std::string const path_str = file_path.string();
+  Diagnostic_Engine file_diagnostics(registry_, file_id);
+  auto& parser = thread_parser(file_diagnostics);
+  parser.set_cancellation_token(cancel_);
+  result.module = parser.parse_module();
+  result.cancelled = parser.cancelled();
+  result.diagnostics = file_diagnostics.take_diagnostics();
+  if (cache_ != nullptr && result.module && !result.cancelled && result.diagnostics.empty()) {
+    cache_->store(cache_key, *result.module);
+  }
+  return result;
+}
 
-    // Register file with the shared registry and get its File_Id
-    File_Id const file_id = diagnostics_.register_file(path_str, std::move(source));
+// Merge the parsed files of one module in file order, reporting their diagnostics and any
+// duplicate definitions. Mirrors a sequential load: stops at the first file that failed.
+std::optional<ast::Module> merge_module(
+    Module_Descriptor const& descriptor_,
+    std::vector<Parsed_File>& files_,
+    Diagnostic_Manager& diagnostics_
+) {
+  ast::Module merged_module;
 
-    // Create diagnostics engine for this file
-    Diagnostic_Engine file_diagnostics(diagnostics_.registry(), file_id);
+  // Size the merged vectors once; items are moved in, never copied
+  std::size_t import_count = 0;
+  std::size_t item_count = 0;
+  for (auto const& parsed: files_) {
+    if (parsed.module) {
+      import_count += parsed.module->imports.size();
+      item_count += parsed.module->items.size();
+    }
+  }
+  merged_module.imports.reserve(import_count);
+  merged_module.items.reserve(item_count);
+
+  // Defined names -> index of the defining file. Keys view the names inside the AST nodes,
+  // so checking an item costs one hash and no string copy
+  std::unordered_map<std::string_view, std::size_t> defined_names;
+  defined_names.reserve(item_count);
+
+  // Duplicate errors are reported after the parse errors of the files they span
+  std::vector<std::pair<Source_Range, std::string>> duplicate_errors;
+  auto const flush_duplicate_errors = [&] {
+    for (auto& [span, message]: duplicate_errors) {
+      diagnostics_.add_error(span, std::move(message));
+    }
+  };
 
-    // Parse the file
-    parser::Parser parser(file_diagnostics);
-    auto const module_opt = parser.parse_module();
+  for (std::size_t i = 0; i < files_.size(); ++i) {
+    auto& parsed = files_[i];
+    if (!parsed.opened) {
+      flush_duplicate_errors();
+      return std::nullopt;
+    }
 
-    if (!module_opt || file_diagnostics.has_errors()) {
-      // Parsing failed
+    bool const has_errors = std::ranges::any_of(parsed.diagnostics, [](Diagnostic const& diag_) {
+      return diag_.level == Diagnostic_Level::Error;
+    });
+    diagnostics_.add_diagnostics(std::move(parsed.diagnostics));
+    if (!parsed.module || has_errors) {
+      flush_duplicate_errors();
       return std::nullopt;
     }
 
     // Check for duplicate definitions before merging
-    auto const& file_module = *module_opt;
+    auto& file_module = *parsed.module;
     for (auto const& item: file_module.items) {
       auto const name_opt = get_item_name(item);
       if (!name_opt.has_value()) {
         continue;  // Item has no name (e.g., impl block)
       }
 
-      auto const& name = *name_opt;
-      auto const existing_it = defined_names.find(name);
-      if (existing_it != defined_names.end()) {
+      auto const [existing_it, inserted] = defined_names.try_emplace(*name_opt, i);
+      if (!inserted) {
         // Duplicate definition found
-        auto const& [original_file, original_span] = existing_it->second;
-        diagnostics_.add_error(
+        duplicate_errors.emplace_back(
             item.span,
-            std::format("duplicate definition of '{}' - first defined in {}", name, original_file.filename().string())
+            std::format(
+                "duplicate definition of '{}' - first defined in {}",
+                *name_opt,
+                descriptor_.files[existing_it->second].filename().string()
+            )
         );
-        has_duplicate = true;
-      } else {
-        defined_names[name] = {file_path, item.span};
       }
     }
 
-    // Merge imports and items into the merged module
+    // Merge imports and items into the merged module (the parsed file is consumed)
     merged_module.imports.insert(
         merged_module.imports.end(),
         std::make_move_iterator(file_module.imports.begin()),
@@ -232,11 +553,130 @@ Module_Loader::load_module(Module_Descriptor const& descriptor_, Diagnostic_Mana
     );
   }
 
-  if (has_duplicate) {
+  if (!duplicate_errors.empty()) {
+    flush_duplicate_errors();
     return std::nullopt;
   }
 
   return merged_module;
 }
+}  // namespace
+
+std::optional<ast::Module> Module_Loader::load_module(
+    Module_Descriptor const& descriptor_,
+    Diagnostic_Manager& diagnostics_,
+    Cancellation_Token const* cancel_,
+    Parse_Cache* cache_
+) {
+  // Parse each file in the module, stopping at the first one that fails
+  std::vector<Parsed_File> files;
+  files.reserve(descriptor_.files.size());
+  for (auto const& file_path: descriptor_.files) {
+    files.push_back(parse_file(file_path, k_invalid_file_id, diagnostics_.registry(), cancel_, cache_));
+    if (files.back().cancelled) {
+      return std::nullopt;  // No diagnostics for a module that was never fully seen
+    }
+    if (!files.back().opened || !files.back().module) {
+      break;
+    }
+  }
+  return merge_module(descriptor_, files, diagnostics_);
+}
+
+std::optional<ast::Module> Module_Loader::reload_module(
+    Module_Descriptor const& descriptor_,
+    ast::Module const& previous_,
+    std::span<std::filesystem::path const> changed_files_,
+    Diagnostic_Manager& diagnostics_,
+    Cancellation_Token const* cancel_,
+    Parse_Cache* cache_
+) {
+  auto const& registry = diagnostics_.registry();
+
+  // The previous File_Id, imports and items of each file, keyed by the path its File_Id was registered under
+  struct Previous_File {
+    File_Id file_id = k_invalid_file_id;
+    ast::Module module;
+  };
+  std::unordered_map<std::string_view, Previous_File> previous_files;
+  auto const previous_file = [&](File_Id file_) -> ast::Module& {
+    auto& previous = previous_files[registry.get_path(file_)];
+    previous.file_id = file_;
+    return previous.module;
+  };
+  for (auto const& import_stmt: previous_.imports) {
+    previous_file(import_stmt.span.file).imports.push_back(import_stmt);
+  }
+  for (auto const& item: previous_.items) {
+    previous_file(item.span.file).items.push_back(item);
+  }
+
+  std::vector<Parsed_File> files;
+  files.reserve(descriptor_.files.size());
+  for (auto const& file_path: descriptor_.files) {
+    auto const previous = previous_files.find(file_path.string());
+    if (previous != previous_files.end() && std::ranges::find(changed_files_, file_path) == changed_files_.end()) {
+      files.push_back(
+          Parsed_File{.opened = true, .cancelled = false, .module = previous->second.module, .diagnostics = {}}
+      );
+      continue;
+    }
+    // A changed file's new text replaces the old one under its File_Id; a new file is registered once read
+    File_Id const file_id = previous != previous_files.end() ? previous->second.file_id : k_invalid_file_id;
+    files.push_back(parse_file(file_path, file_id, diagnostics_.registry(), cancel_, cache_));
+    if (files.back().cancelled) {
+      return std::nullopt;
+    }
+    if (!files.back().opened || !files.back().module) {
+      break;
+    }
+  }
+  return merge_module(descriptor_, files, diagnostics_);
+}
+
+std::vector<std::optional<ast::Module>> Module_Loader::load_modules(
+    std::vector<Module_Descriptor> const& descriptors_,
+    Diagnostic_Manager& diagnostics_,
+    Thread_Pool& pool_,
+    Cancellation_Token const* cancel_,
+    Parse_Cache* cache_
+) {
+  // File_Ids are handed out up front in descriptor and file order
+  std::vector<std::string> paths;
+  for (auto const& descriptor: descriptors_) {
+    for (auto const& file_path: descriptor.files) {
+      paths.push_back(file_path.string());
+    }
+  }
+  File_Id next_id = diagnostics_.registry().reserve_files(std::move(paths));
+
+  // Read and parse every file of every module concurrently; each task writes only its own slot
+  std::vector<std::vector<Parsed_File>> parsed(descriptors_.size());
+  for (std::size_t module = 0; module < descriptors_.size(); ++module) {
+    parsed[module].resize(descriptors_[module].files.size());
+    for (std::size_t file = 0; file < descriptors_[module].files.size(); ++file) {
+      pool_.submit([&, module, file, file_id = next_id++] {
+        parsed[module][file] =
+            parse_file(descriptors_[module].files[file], file_id, diagnostics_.registry(), cancel_, cache_);
+      });
+    }
+  }
+  pool_.wait();
+
+  std::vector<std::optional<ast::Module>> modules(descriptors_.size());
+  if (cancel_ != nullptr && cancel_->is_cancelled()) {
+    return modules;
+  }
+
+  // Deterministic merge: same modules, items and diagnostics as a sequential load_module loop
+  // (only the registry differs after a failure: it already holds the files of later modules)
+  for (std::size_t module = 0; module < descriptors_.size(); ++module) {
+    modules[module] = merge_module(descriptors_[module], parsed[module], diagnostics_);
+    if (!modules[module]) {
+      break;
+    }
+  }
+  return modules;
+}
 
 }  // namespace life_lang::semantic
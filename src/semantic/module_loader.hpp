@@ -2,11 +2,14 @@
 
 #include <filesystem>
 #include <optional>
+#include <span>
 #include <string>
 #include <vector>
 
 namespace life_lang {
+class Cancellation_Token;
 class Diagnostic_Manager;
+class Thread_Pool;
 namespace ast {
 struct Module;
 }
@@ -14,6 +17,8 @@ struct Module;
 
 namespace life_lang::semantic {
 
+class Parse_Cache;
+
 // Describes a module discovered from the filesystem
 struct Module_Descriptor {
   std::vector<std::string> path;             // Module path components: {"Std", "Collections"}
@@ -30,27 +35,106 @@ struct Module_Descriptor {
   [[nodiscard]] std::string to_string() const;
 };
 
+// Options for Module_Loader::discover_modules
+struct Discovery_Options {
+  // Walk directories in parallel (each directory is one task); nullptr walks on the calling thread
+  Thread_Pool* pool = nullptr;
+
+  // Cached manifest of (directory, mtime, .life files). When every recorded directory still has
+  // its recorded mtime the walk is skipped; otherwise the tree is walked and the manifest
+  // rewritten. Adding, removing or renaming a file or subdirectory bumps its parent's mtime.
+  // Empty path: no manifest
+  std::filesystem::path manifest_path;
+};
+
 // Module loader for filesystem-based module discovery
 class Module_Loader {
 public:
   // Scan src/ directory recursively to find all modules
-  // Returns list of all discovered modules (both file-modules and folder-modules)
+  // Returns list of all discovered modules (both file-modules and folder-modules), sorted by
+  // directory, with each module's files sorted by name
   // src_root: Path to "src/" directory (can be relative or absolute, will be canonicalized)
   [[nodiscard]] static std::vector<Module_Descriptor> discover_modules(std::filesystem::path const& src_root_);
+  [[nodiscard]] static std::vector<Module_Descriptor>
+  discover_modules(std::filesystem::path const& src_root_, Discovery_Options const& options_);
+
+  // Find a single module without walking the tree: descends from src_root_ one directory per
+  // path component (trying the lowercase name first, e.g. "User_Profile" -> "user_profile") and
+  // lists the .life files of the last one. Only directories on the way are read.
+  // Returns the same descriptor discover_modules would produce, or std::nullopt if no directory
+  // maps to module_path_ or it holds no .life files
+  [[nodiscard]] static std::optional<Module_Descriptor>
+  locate_module(std::filesystem::path const& src_root_, std::vector<std::string> const& module_path_);
+
+  // The module whose files live directly in directory_, described as discover_modules would
+  // (files sorted by name); std::nullopt if directory_ holds no .life files or isn't under src_root_
+  [[nodiscard]] static std::optional<Module_Descriptor>
+  describe_directory(std::filesystem::path const& src_root_, std::filesystem::path const& directory_);
 
   // Load and parse all files in a module
   // Parses each .life file and merges all top-level items into a single Module AST
   // diagnostics_: Diagnostic manager for error reporting (also provides the file registry)
   // Returns the merged module on success, or std::nullopt if any file fails to parse
   // Reports duplicate definition errors if the same name is defined in multiple files
-  [[nodiscard]] static std::optional<ast::Module>
-  load_module(Module_Descriptor const& descriptor_, Diagnostic_Manager& diagnostics_);
+  // cancel_: Optional token polled between files and inside the parser; when it fires the
+  //          load returns std::nullopt without reporting any diagnostics for this module
+  // cache_: Optional parse cache; a file whose bytes have a cached tree is not parsed, and every
+  //         clean parse is stored. Eviction (cache_->evict()) is left to the caller.
+  [[nodiscard]] static std::optional<ast::Module> load_module(
+      Module_Descriptor const& descriptor_,
+      Diagnostic_Manager& diagnostics_,
+      Cancellation_Token const* cancel_ = nullptr,
+      Parse_Cache* cache_ = nullptr
+  );
+
+  // Load a module again after some of its files changed. previous_ is the module as loaded
+  // before (its spans carry the File_Ids of its files); a file of descriptor_ that isn't in
+  // changed_files_ and whose registered path previous_ still has items or imports from keeps
+  // those, every other file is read and parsed. Merge, duplicate checks and diagnostics are
+  // those of load_module, and so is the result.
+  // A reparsed file keeps its File_Id: its new text replaces the old one in the registry, so
+  // repeated updates don't accumulate file versions (after a failed reload, the spans of the
+  // previous module's items in that file refer to the new text).
+  [[nodiscard]] static std::optional<ast::Module> reload_module(
+      Module_Descriptor const& descriptor_,
+      ast::Module const& previous_,
+      std::span<std::filesystem::path const> changed_files_,
+      Diagnostic_Manager& diagnostics_,
+      Cancellation_Token const* cancel_ = nullptr,
+      Parse_Cache* cache_ = nullptr
+  );
+
+  // Load several modules at once: every file of every module is read and parsed on pool_,
+  // then each module is merged in descriptor order (files in descriptor file order). When every
+  // module loads, File_Ids, item order and diagnostics are the same as calling load_module on
+  // each descriptor in turn.
+  // Returns one entry per descriptor; like that loop, merging stops at the first module that
+  // fails, so the failed entry and every later one are std::nullopt. Unlike the loop, every file
+  // of every descriptor has been registered (File_Ids are reserved up front) and parsed by then,
+  // so the files of the modules after the failing one stay in the registry.
+  // cancel_: when it fires, every entry is std::nullopt and no diagnostics are reported (the
+  // reserved File_Ids stay registered)
+  // cache_: as for load_module; shared by all workers
+  [[nodiscard]] static std::vector<std::optional<ast::Module>> load_modules(
+      std::vector<Module_Descriptor> const& descriptors_,
+      Diagnostic_Manager& diagnostics_,
+      Thread_Pool& pool_,
+      Cancellation_Token const* cancel_ = nullptr,
+      Parse_Cache* cache_ = nullptr
+  );
 
 private:
   // Convert lowercase_snake_case directory name to Camel_Snake_Case module name
   // Examples: "geometry" -> "Geometry", "user_profile" -> "User_Profile"
   [[nodiscard]] static std::string dir_name_to_module_name(std::string_view dir_name_);
 
+  // Subdirectory of parent_ whose module name is component_ (symlinked directories are skipped)
+  [[nodiscard]] static std::optional<std::filesystem::path>
+  find_module_dir(std::filesystem::path const& parent_, std::string const& component_);
+
+  // Module path components for a directory given relative to src/ (no filesystem access)
+  [[nodiscard]] static std::vector<std::string> module_path_from_relative(std::filesystem::path const& relative_);
+
   // Derive module path components from directory relative to src/ root
   // Both paths are canonicalized (absolute + symlinks resolved) to ensure comparability
   // Examples:
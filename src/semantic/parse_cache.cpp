@@ -0,0 +1,156 @@
+#include "parse_cache.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <format>
+#include <fstream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "content_hash.hpp"
+#include "mapped_file.hpp"
+#include "parser/ast.hpp"
+#include "parser/ast_binary.hpp"
+
+namespace life_lang::semantic {
+
+namespace {
+
+constexpr std::string_view k_entry_extension = ".ast";
+constexpr std::string_view k_temp_extension = ".tmp";
+
+// A temporary this old belongs to a writer that died before renaming it
+constexpr auto k_stale_temp_age = std::chrono::hours{1};
+
+// Per-thread random suffix for temporaries: unique across threads and processes
+std::uint64_t temp_suffix() {
+  thread_local std::mt19937_64 engine{[] {
+    std::random_device device;
+    return (std::uint64_t{device()} << 32) | device();
+  }()};
+  return engine();
+}
+
+}  // namespace
+
+Parse_Cache::Parse_Cache(std::filesystem::path directory_, std::uintmax_t max_bytes_)
+    : m_directory(std::move(directory_)), m_max_bytes(max_bytes_) {}
+
+std::uint64_t Parse_Cache::key_for(std::string_view source_) {
+  // Salted: trees from another compiler build or format version never share a file name
+  return hash_bytes(source_, ast::ast_binary_compiler_hash() ^ ast::k_ast_binary_version);
+}
+
+std::filesystem::path Parse_Cache::entry_path(std::uint64_t key_) const {
+  return m_directory / std::format("{:016x}{}", key_, k_entry_extension);
+}
+
+std::optional<ast::Module> Parse_Cache::load(std::uint64_t key_, File_Id file_) {
+  auto const path = entry_path(key_);
+  auto const entry = Mapped_File::open(path);
+  if (!entry) {
+    return std::nullopt;
+  }
+  // The file name is the key, but a stray or half-replaced file must not be taken for it
+  auto const header = ast::read_header(entry->bytes());
+  if (!header || header->source_hash != key_) {
+    return std::nullopt;
+  }
+  auto module = ast::decode_module(entry->bytes(), file_);
+  if (!module) {
+    return std::nullopt;
+  }
+
+  // Recently used: eviction goes by mtime
+  std::error_code ec;
+  std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), ec);
+  m_hits.fetch_add(1, std::memory_order_relaxed);
+  return module;
+}
+
+void Parse_Cache::store(std::uint64_t key_, ast::Module const& module_) {
+  std::string const entry = ast::encode_module(module_, key_);
+
+  std::error_code ec;
+  std::filesystem::create_directories(m_directory, ec);
+  if (ec) {
+    return;
+  }
+
+  // Write to a private temporary and rename, so concurrent readers and writers of the
+  // same key never see a torn entry (both writers produce the same bytes anyway)
+  auto const path = entry_path(key_);
+  auto const temp_path = std::filesystem::path{path}.concat(std::format(".{:016x}{}", temp_suffix(), k_temp_extension));
+  {
+    std::ofstream out(temp_path, std::ios::binary | std::ios::trunc);
+    if (!out || !out.write(entry.data(), static_cast<std::streamsize>(entry.size())) || !out.flush()) {
+      out.close();
+      std::filesystem::remove(temp_path, ec);
+      return;
+    }
+  }
+  std::filesystem::rename(temp_path, path, ec);
+  if (ec) {
+    std::filesystem::remove(temp_path, ec);
+    return;
+  }
+  m_stores.fetch_add(1, std::memory_order_relaxed);
+  m_stored_since_evict.store(true, std::memory_order_relaxed);
+}
+
+void Parse_Cache::evict() {
+  if (!m_stored_since_evict.exchange(false, std::memory_order_relaxed)) {
+    return;  // Loads alone never grow the cache
+  }
+
+  struct Entry {
+    std::filesystem::path path;
+    std::filesystem::file_time_type mtime;
+    std::uintmax_t size;
+  };
+  std::vector<Entry> entries;
+  std::uintmax_t total = 0;
+  auto const now = std::filesystem::file_time_type::clock::now();
+
+  std::error_code ec;
+  for (std::filesystem::directory_iterator it{m_directory, ec}, end; !ec && it != end; it.increment(ec)) {
+    std::error_code entry_ec;
+    auto const& path = it->path();
+    auto const mtime = it->last_write_time(entry_ec);
+    if (entry_ec || !it->is_regular_file(entry_ec)) {
+      continue;
+    }
+    if (path.extension() == k_temp_extension) {
+      if (now - mtime > k_stale_temp_age) {
+        std::filesystem::remove(path, entry_ec);
+      }
+      continue;
+    }
+    if (path.extension() != k_entry_extension) {
+      continue;  // Not ours
+    }
+    auto const size = it->file_size(entry_ec);
+    if (entry_ec) {
+      continue;
+    }
+    entries.push_back(Entry{.path = path, .mtime = mtime, .size = size});
+    total += size;
+  }
+  if (total <= m_max_bytes) {
+    return;
+  }
+
+  // Least recently used first; entries vanishing under a concurrent evict() are simply skipped
+  std::ranges::sort(entries, {}, &Entry::mtime);
+  for (auto const& entry: entries) {
+    if (total <= m_max_bytes) {
+      break;
+    }
+    std::error_code remove_ec;
+    std::filesystem::remove(entry.path, remove_ec);
+    total -= entry.size;
+  }
+}
+
+}  // namespace life_lang::semantic
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string_view>
+
+#include "../diagnostics.hpp"
+
+namespace life_lang::ast {
+struct Module;
+}  // namespace life_lang::ast
+
+namespace life_lang::semantic {
+
+// ============================================================================
+// Parse_Cache - On-disk cache of parsed files, keyed by content hash
+// ============================================================================
+// One file per parsed source, named after the XXH64 hash of the source bytes
+// salted with the compiler version and AST encoding version, so a compiler
+// upgrade never reads an older compiler's trees. Only clean parses (no
+// diagnostics at all) are stored: a cache hit reports nothing, exactly like
+// re-parsing the same text would.
+//
+// Each entry is a binary AST file (ast_binary.hpp) whose source hash is the key,
+// read through a memory mapping. A truncated, corrupt or foreign entry is a
+// miss, never an error.
+//
+// Safe for concurrent use by several threads and several processes sharing one
+// directory: entries are written to a unique temporary and renamed into place,
+// so readers see either the whole entry or none. Every hit refreshes the entry's
+// mtime; evict() removes the least recently used entries once the directory
+// grows past max_bytes.
+//
+// Example:
+//   Parse_Cache cache(".life-cache");
+//   std::uint64_t const key = Parse_Cache::key_for(source);
+//   if (auto module = cache.load(key, file_id)) { ... } else { ...parse...; cache.store(key, parsed); }
+//   cache.evict();
+
+class Parse_Cache {
+public:
+  static constexpr std::uintmax_t k_default_max_bytes = std::uintmax_t{256} << 20;
+
+  explicit Parse_Cache(std::filesystem::path directory_, std::uintmax_t max_bytes_ = k_default_max_bytes);
+
+  // Cache key for a file's bytes (a pure function of the text and the compiler build)
+  [[nodiscard]] static std::uint64_t key_for(std::string_view source_);
+
+  // The cached tree for key_ with every located span stamped with file_, or std::nullopt
+  [[nodiscard]] std::optional<ast::Module> load(std::uint64_t key_, File_Id file_);
+
+  // Best effort: a failed write only costs a parse on the next run
+  void store(std::uint64_t key_, ast::Module const& module_);
+
+  // If anything was stored since the last call and the entries exceed max_bytes, delete
+  // entries oldest mtime first until they fit. Call once per batch of loads, not per file.
+  void evict();
+
+  [[nodiscard]] std::filesystem::path const& directory() const { return m_directory; }
+  [[nodiscard]] std::size_t hits() const { return m_hits.load(std::memory_order_relaxed); }
+  [[nodiscard]] std::size_t stores() const { return m_stores.load(std::memory_order_relaxed); }
+
+private:
+  std::filesystem::path m_directory;
+  std::uintmax_t m_max_bytes;
+  std::atomic<std::size_t> m_hits{0};
+  std::atomic<std::size_t> m_stores{0};
+  std::atomic<bool> m_stored_since_evict{false};
+
+  [[nodiscard]] std::filesystem::path entry_path(std::uint64_t key_) const;
+};
+
+}  // namespace life_lang::semantic
@@ -0,0 +1,29 @@
+#include "query_engine.hpp"
+
+namespace life_lang::semantic {
+
+namespace {
+
+// Dependency lists of the derived values being computed on this thread, innermost last
+thread_local std::vector<std::vector<Query_Dependency>*> t_executions;
+
+}  // namespace
+
+void Query_Table::record_read(std::uint32_t slot_) {
+  if (t_executions.empty()) {
+    return;  // Read from outside any query
+  }
+  auto& dependencies = *t_executions.back();
+  Query_Dependency const dependency{.table = this, .slot = slot_};
+  if (std::ranges::find(dependencies, dependency) == dependencies.end()) {
+    dependencies.push_back(dependency);
+  }
+}
+
+void Query_Table::begin_execution(std::vector<Query_Dependency>& dependencies_) {
+  t_executions.push_back(&dependencies_);
+}
+
+void Query_Table::end_execution() { t_executions.pop_back(); }
+
+}  // namespace life_lang::semantic
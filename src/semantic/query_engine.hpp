@@ -0,0 +1,376 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace life_lang::semantic {
+
+// ============================================================================
+// Query_Engine - Memoized queries with dependency tracking
+// ============================================================================
+// Semantic facts are queries: functions of a key whose results are memoized
+// per key. An Input_Query holds values set from outside (e.g. the parsed items
+// of a module); a Derived_Query computes its values from other queries, and
+// every get() it makes while computing is recorded as a dependency.
+//
+// Setting an input to a new value starts a new revision, and nothing else:
+// a derived value is revalidated when it is next asked for. If none of its
+// dependencies changed since it was last verified it is green and reused;
+// otherwise it is red and computed again. A recomputed value equal to the old
+// one keeps its old change revision, so whatever depends on it stays green
+// (an edit inside a function body changes the module's items but not the
+// names it defines, so resolutions that only looked at the names survive).
+// Values without operator== always count as changed when recomputed.
+//
+// Threads: set() must not overlap anything else. get() may be called from any
+// number of threads: a value that is current is read under a shared lock of
+// its table. A stale value is claimed by the first thread to ask for it, which
+// revalidates or computes it while threads asking for the same value wait and
+// threads asking for other values go ahead in parallel. Queries must not depend
+// on themselves, directly or through others: get() throws Query_Cycle_Error when
+// a thread asks for a value it is itself updating (the values it was updating
+// are left stale, not wrong). A cycle split across threads, each updating one
+// value of it, deadlocks. References returned by get() stay valid until the
+// next set().
+//
+// Example:
+//   Query_Engine engine;
+//   Input_Query<std::string, std::string> text{engine};
+//   Derived_Query<std::string, std::size_t> lines{engine, [&](std::string const& file_) {
+//     return static_cast<std::size_t>(std::ranges::count(*text.get(file_), '\n'));
+//   }};
+//   text.set("a.life", "fn f(): I32 {\n  return 0;\n}\n");
+//   lines.get("a.life");  // Computed: 3
+//   text.set("a.life", "fn f(): I32 {\n  return 1;\n}\n");
+//   lines.get("a.life");  // Computed again, still 3: queries that read it stay green
+
+using Revision = std::uint64_t;
+
+class Query_Table;
+
+// Thrown by Derived_Query::get() for a value that depends on itself
+class Query_Cycle_Error : public std::logic_error {
+public:
+  using std::logic_error::logic_error;
+};
+
+// A read of one memoized value: slot of a query table
+struct Query_Dependency {
+  Query_Table* table = nullptr;
+  std::uint32_t slot{};
+
+  [[nodiscard]] bool operator==(Query_Dependency const&) const = default;
+};
+
+class Query_Engine {
+public:
+  Query_Engine() = default;
+
+  // Non-copyable, non-movable (tables refer back to their engine)
+  Query_Engine(Query_Engine const&) = delete;
+  Query_Engine& operator=(Query_Engine const&) = delete;
+  Query_Engine(Query_Engine&&) = delete;
+  Query_Engine& operator=(Query_Engine&&) = delete;
+  ~Query_Engine() = default;
+
+  [[nodiscard]] Revision revision() const { return m_revision.load(std::memory_order_acquire); }
+
+  // Derived values computed so far, recomputations included
+  [[nodiscard]] std::uint64_t execution_count() const { return m_executions.load(std::memory_order_relaxed); }
+
+private:
+  friend class Query_Table;
+
+  std::atomic<Revision> m_revision{1};
+  std::atomic<std::uint64_t> m_executions{0};
+};
+
+// Type-erased base of Input_Query and Derived_Query: what a dependent needs to revalidate
+class Query_Table {
+public:
+  explicit Query_Table(Query_Engine& engine_) : m_engine(&engine_) {}
+
+  // Non-copyable, non-movable (dependencies point at tables)
+  Query_Table(Query_Table const&) = delete;
+  Query_Table& operator=(Query_Table const&) = delete;
+  Query_Table(Query_Table&&) = delete;
+  Query_Table& operator=(Query_Table&&) = delete;
+  virtual ~Query_Table() = default;
+
+  // Bring slot_ up to date and return the revision its value last changed in
+  [[nodiscard]] virtual Revision refresh(std::uint32_t slot_) = 0;
+
+protected:
+  [[nodiscard]] Revision revision() const { return m_engine->revision(); }
+  [[nodiscard]] Revision start_revision() { return m_engine->m_revision.fetch_add(1, std::memory_order_acq_rel) + 1; }
+
+  // Record a read of slot_ as a dependency of the derived value being computed on this thread, if any
+  void record_read(std::uint32_t slot_);
+
+  // Run compute_ as a derived value, collecting the reads it makes into dependencies_
+  template <typename Compute>
+  [[nodiscard]] auto execute(Compute&& compute_, std::vector<Query_Dependency>& dependencies_) {
+    Execution const execution{dependencies_};
+    auto value = std::forward<Compute>(compute_)();
+    m_engine->m_executions.fetch_add(1, std::memory_order_relaxed);
+    return value;
+  }
+
+private:
+  Query_Engine* m_engine;
+
+  static void begin_execution(std::vector<Query_Dependency>& dependencies_);
+  static void end_execution();
+
+  // The innermost execution of this thread while alive, so a compute that throws doesn't leave it behind
+  struct Execution {
+    explicit Execution(std::vector<Query_Dependency>& dependencies_) { begin_execution(dependencies_); }
+    Execution(Execution const&) = delete;
+    Execution& operator=(Execution const&) = delete;
+    Execution(Execution&&) = delete;
+    Execution& operator=(Execution&&) = delete;
+    ~Execution() { end_execution(); }
+  };
+};
+
+// ============================================================================
+// Input_Query - Values set from outside the engine
+// ============================================================================
+// Reading a key that was never set yields nullptr, and is a dependency like any
+// other read: setting the key later reaches the values computed from the miss.
+// Misses share one slot per table, changed whenever a key is set for the first
+// time, so reading unknown keys never grows the table.
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<>>
+class Input_Query final : public Query_Table {
+public:
+  using Query_Table::Query_Table;
+
+  // Starts a new revision unless value_ equals the current value
+  void set(Key const& key_, Value value_) {
+    auto const [id, inserted] = slot_for(key_);
+    auto& slot = slot_at(id);
+    if (!inserted && *slot.value == value_) {
+      return;
+    }
+    slot.value = std::move(value_);
+    slot.changed_at = start_revision();
+    if (inserted) {
+      slot_at(k_absent_slot).changed_at = slot.changed_at;  // Reads that missed the key now find it
+    }
+  }
+
+  template <typename Lookup = Key>
+  [[nodiscard]] Value const* get(Lookup const& key_) {
+    std::uint32_t id = k_absent_slot;
+    {
+      std::shared_lock const lock{m_mutex};
+      if (auto const it = m_slot_ids.find(key_); it != m_slot_ids.end()) {
+        id = it->second;
+      }
+    }
+    record_read(id);
+    auto const& value = slot_at(id).value;
+    return value.has_value() ? &*value : nullptr;
+  }
+
+  // Keys that have been set
+  [[nodiscard]] std::size_t size() const {
+    std::shared_lock const lock{m_mutex};
+    return m_slot_ids.size();
+  }
+
+  [[nodiscard]] Revision refresh(std::uint32_t slot_) override { return slot_at(slot_).changed_at; }
+
+private:
+  struct Slot {
+    std::optional<Value> value;
+    Revision changed_at{};
+  };
+
+  static constexpr std::uint32_t k_absent_slot = 0;  // Read by every miss; never holds a value
+
+  mutable std::shared_mutex m_mutex;  // Guards the key map and the slot list, not the slots (set() writes those)
+  std::unordered_map<Key, std::uint32_t, Hash, Equal> m_slot_ids;
+  std::deque<Slot> m_slots = std::deque<Slot>(1);  // Index = slot id; a deque so that slots never move
+
+  // The slot of key_, and whether it was created by this call
+  [[nodiscard]] std::pair<std::uint32_t, bool> slot_for(Key const& key_) {
+    std::unique_lock const lock{m_mutex};
+    auto const [it, inserted] = m_slot_ids.try_emplace(key_, static_cast<std::uint32_t>(m_slots.size()));
+    if (inserted) {
+      m_slots.emplace_back();
+    }
+    return {it->second, inserted};
+  }
+
+  [[nodiscard]] Slot& slot_at(std::uint32_t id_) {
+    std::shared_lock const lock{m_mutex};
+    return m_slots[id_];
+  }
+};
+
+// ============================================================================
+// Derived_Query - Values computed from other queries, memoized per key
+// ============================================================================
+
+template <typename Key, typename Value, typename Hash = std::hash<Key>, typename Equal = std::equal_to<>>
+class Derived_Query final : public Query_Table {
+public:
+  using Compute = std::function<Value(Key const&)>;
+
+  Derived_Query(Query_Engine& engine_, Compute compute_) : Query_Table(engine_), m_compute(std::move(compute_)) {}
+
+  template <typename Lookup = Key>
+  [[nodiscard]] Value const& get(Lookup const& key_) {
+    bool executed = false;
+    return get(key_, executed);
+  }
+
+  // As above; executed_ tells whether this call computed the value (as opposed to reusing it)
+  template <typename Lookup = Key>
+  [[nodiscard]] Value const& get(Lookup const& key_, bool& executed_) {
+    executed_ = false;
+    {
+      std::shared_lock const lock{m_mutex};
+      if (auto const it = m_slot_ids.find(key_); it != m_slot_ids.end()) {
+        auto const& slot = m_slots[it->second];
+        if (slot.verified_at == revision()) {
+          record_read(it->second);
+          return *slot.value;
+        }
+      }
+    }
+
+    auto const id = slot_for(key_);
+    executed_ = update(id);
+    record_read(id);
+    return *slot_at(id).value;
+  }
+
+  [[nodiscard]] Revision refresh(std::uint32_t slot_) override {
+    (void)update(slot_);
+    return slot_at(slot_).changed_at;
+  }
+
+private:
+  struct Slot {
+    Key key;
+    std::optional<Value> value;
+    Revision verified_at{};  // Last revision the value was known to be current in
+    Revision changed_at{};   // Last revision the value changed in
+    std::vector<Query_Dependency> dependencies;
+    std::thread::id updating_on{};  // Thread bringing the slot up to date, if any
+  };
+
+  Compute m_compute;
+  std::shared_mutex m_mutex;  // Guards the key map and slot list, and slot writes against lock-free readers
+  std::condition_variable_any m_updated;  // Notified whenever a thread stops updating a slot
+  std::unordered_map<Key, std::uint32_t, Hash, Equal> m_slot_ids;
+  std::deque<Slot> m_slots;  // Index = slot id; a deque so that slots never move
+
+  template <typename Lookup>
+  [[nodiscard]] std::uint32_t slot_for(Lookup const& key_) {
+    {
+      std::shared_lock const lock{m_mutex};
+      if (auto const it = m_slot_ids.find(key_); it != m_slot_ids.end()) {
+        return it->second;
+      }
+    }
+    std::unique_lock const lock{m_mutex};
+    auto const [it, inserted] = m_slot_ids.try_emplace(Key{key_}, static_cast<std::uint32_t>(m_slots.size()));
+    if (inserted) {
+      m_slots.push_back(Slot{
+          .key = it->first, .value = {}, .verified_at = 0, .changed_at = 0, .dependencies = {}, .updating_on = {}
+      });
+    }
+    return it->second;
+  }
+
+  [[nodiscard]] Slot& slot_at(std::uint32_t id_) {
+    std::shared_lock const lock{m_mutex};
+    return m_slots[id_];
+  }
+
+  // The right to update one slot, held by one thread at a time; giving it up (also when the
+  // compute throws) wakes the threads waiting for the slot
+  class Claim {
+  public:
+    Claim(Derived_Query& query_, Slot& slot_) : m_query(&query_), m_slot(&slot_) {}
+    Claim(Claim const&) = delete;
+    Claim& operator=(Claim const&) = delete;
+    Claim(Claim&&) = delete;
+    Claim& operator=(Claim&&) = delete;
+    ~Claim() {
+      std::unique_lock const lock{m_query->m_mutex};
+      m_slot->updating_on = std::thread::id{};
+      m_query->m_updated.notify_all();
+    }
+
+  private:
+    Derived_Query* m_query;
+    Slot* m_slot;
+  };
+
+  // Make the slot current; returns whether its value was computed
+  // A slot another thread is updating is waited for, then reused if that made it current
+  bool update(std::uint32_t id_) {
+    auto& slot = slot_at(id_);
+    auto const current = revision();
+    auto const self = std::this_thread::get_id();
+    {
+      std::unique_lock lock{m_mutex};
+      m_updated.wait(lock, [&] { return slot.updating_on == std::thread::id{} || slot.updating_on == self; });
+      if (slot.updating_on == self) {
+        throw Query_Cycle_Error("cyclic query: a value depends on itself");
+      }
+      if (slot.verified_at == current) {
+        return false;
+      }
+      slot.updating_on = self;
+    }
+    Claim const claim{*this, slot};
+
+    // Green: every dependency, revalidated in the order it was read, is unchanged since the last verification
+    bool const green = slot.value.has_value() && std::ranges::all_of(slot.dependencies, [&](auto const& dependency_) {
+                         return dependency_.table->refresh(dependency_.slot) <= slot.verified_at;
+                       });
+    if (green) {
+      std::unique_lock const lock{m_mutex};
+      slot.verified_at = current;
+      return false;
+    }
+
+    std::vector<Query_Dependency> dependencies;
+    auto value = execute([&] { return m_compute(slot.key); }, dependencies);
+
+    bool unchanged = false;
+    if constexpr (std::equality_comparable<Value>) {
+      unchanged = slot.value.has_value() && *slot.value == value;
+    }
+    std::unique_lock const lock{m_mutex};
+    if (!unchanged) {
+      slot.value = std::move(value);
+      slot.changed_at = current;
+    }
+    slot.dependencies = std::move(dependencies);
+    slot.verified_at = current;
+    return true;
+  }
+};
+
+}  // namespace life_lang::semantic
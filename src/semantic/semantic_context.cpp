@@ -1,13 +1,22 @@
 #include "semantic_context.hpp"
 
+#include "../cancellation.hpp"
 #include "../diagnostics.hpp"
+#include "../flat_string_map.hpp"
+#include "../mapped_file.hpp"
+#include "../thread_pool.hpp"
+#include "import_graph.hpp"
+#include "module_interface.hpp"
 #include "module_loader.hpp"
+#include "parse_cache.hpp"
+#include "query_engine.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <format>
-#include <functional>
-#include <map>
-#include <set>
+#include <ranges>
+#include <span>
+#include <tuple>
 
 namespace life_lang::semantic {
 
@@ -18,56 +27,269 @@ namespace life_lang::semantic {
 struct Semantic_Context::Impl {
   Diagnostic_Manager* diagnostics = nullptr;
 
-  // Module path (dot-separated like "Std.Collections") -> parsed AST
-  std::map<std::string, ast::Module> modules;
+  // Workers for parallel discovery and file loading, started on first use
+  std::unique_ptr<Thread_Pool> pool;
+
+  // Cached directory listing for discover_modules (empty: always walk)
+  std::filesystem::path manifest_path;
+
+  // Parsed files reused across runs (nullptr: always parse)
+  std::unique_ptr<Parse_Cache> parse_cache;
+
+  // Interface files of dependency modules (empty: always parse dependencies)
+  std::filesystem::path interface_dir;
+
+  // The module's up-to-date interface from interface_dir, or std::nullopt if it has none
+  [[nodiscard]] std::optional<ast::Module> load_interface(Module_Descriptor const& descriptor_) const;
+
+  // Dense module number, assigned in load order and never reused
+  using Module_Id = std::uint32_t;
+
+  enum class Name_Kind : std::uint8_t { Type, Func };
+
+  struct Module_Entry {
+    Module_Id id{};
+    std::string path;                 // Dot-separated like "Std.Collections"
+    std::filesystem::path directory;  // Canonical directory of the module's files
+    ast::Module module;
+    std::uint64_t version{};  // Bumped whenever module is replaced; what the module_versions input holds
+  };
+
+  // Indexed by Module_Id; boxed so that get_module() pointers survive later loads
+  std::vector<std::unique_ptr<Module_Entry>> modules;
+  Flat_String_Map<Module_Id> module_ids;
+
+  // Lookup by module path without building a key string
+  [[nodiscard]] Module_Entry const* find_module(std::string_view module_path_) const {
+    Module_Id const* id = module_ids.find(module_path_);
+    return id == nullptr ? nullptr : modules[*id].get();
+  }
+
+  // Lookup by canonical module directory (a scan: only update() needs it, once per changed directory)
+  [[nodiscard]] Module_Entry const* find_module_by_directory(std::filesystem::path const& directory_) const {
+    auto const it = std::ranges::find(modules, directory_, [](auto const& entry_) { return entry_->directory; });
+    return it == modules.end() ? nullptr : it->get();
+  }
+
+  // Remember the root update() rescans against
+  void set_src_root(std::filesystem::path const& src_root_) {
+    std::error_code ec;
+    src_root = std::filesystem::canonical(src_root_, ec);
+  }
+
+  // Registry and diagnostic sizes before a load, so that a cancelled load can be undone
+  struct Load_Checkpoint {
+    std::size_t file_count;
+    std::size_t diagnostic_count;
+  };
+
+  [[nodiscard]] Load_Checkpoint checkpoint() const {
+    return Load_Checkpoint{
+        .file_count = diagnostics->registry().file_count(), .diagnostic_count = diagnostics->diagnostic_count()
+    };
+  }
+
+  // Forget the files a cancelled load registered and the diagnostics it reported
+  [[nodiscard]] Load_Status cancel_load(Load_Checkpoint checkpoint_) {
+    diagnostics->registry().truncate(checkpoint_.file_count);
+    diagnostics->truncate_diagnostics(checkpoint_.diagnostic_count);
+    return Load_Status::Cancelled;
+  }
+
+  // A loaded module waiting for the load to finish before it replaces anything
+  struct Staged_Module {
+    std::string path;
+    std::filesystem::path directory;
+    ast::Module module;
+  };
+
+  // Canonical src/ root of the last load (what update() rescans directories against)
+  std::filesystem::path src_root;
+
+  // Add or replace a module; returns its entry
+  Module_Entry& store_module(Staged_Module staged_);
+
+  // Store staged modules, then (unless load_failed_) check imports
+  [[nodiscard]] Load_Status commit_modules(std::vector<Staged_Module> staged_, bool load_failed_);
+
+  // Store the modules reloaded by update() and check imports again
+  [[nodiscard]] Load_Status commit_update(std::vector<Staged_Module> staged_);
+
+  // Modules with every module after the modules it imports (filled by check_circular_imports)
+  std::vector<Module_Id> dependency_order;
+
+  // Check for circular import dependencies between modules and compute dependency_order
+  // Reports every cycle (one error per strongly connected component, with a note per import involved)
+  // Returns true if any cycle is detected
+  [[nodiscard]] bool check_circular_imports();
+
+  // Report one cycle; cycle_ is the import edges in order, starting and ending at the same module
+  void report_import_cycle(std::span<Import_Graph::Edge const> cycle_) const;
+
+  // ==========================================================================
+  // Queries (see query_engine.hpp)
+  // ==========================================================================
+  // Everything derived from the loaded modules is computed on demand and memoized: a load or update
+  // only sets module_versions, and the next lookup revalidates just what it reads. Derived values
+  // name definitions instead of pointing at them wherever that lets them outlive an edit.
+
+  // Transparent, so that string-keyed queries can be probed with a std::string_view
+  struct String_Hash {
+    using is_transparent = void;
+    [[nodiscard]] std::size_t operator()(std::string_view text_) const { return std::hash<std::string_view>{}(text_); }
+  };
+
+  // Methods implemented for one self type, from inherent and trait impls (generic impls included)
+  struct Type_Methods {
+    std::vector<ast::Func_Def const*> all;           // Inherent impls first, then trait impls, each in item order
+    Flat_String_Map<ast::Func_Def const*> by_name;  // First definition wins, so inherent methods shadow trait ones
+  };
+
+  // Name-to-item indices of one module for O(1) lookups; they point into the module's items, so
+  // they change with every edit of it
+  struct Module_Index {
+    Flat_String_Map<ast::Item const*> types;
+    Flat_String_Map<ast::Item const*> funcs;
+
+    // Self type name -> methods (e.g., "Point" for "impl Point" and "impl Display for Point")
+    Flat_String_Map<Type_Methods> methods;
+  };
+
+  struct Defined_Name {
+    std::string name;
+    Name_Kind kind{};
+    bool is_pub = false;
+
+    [[nodiscard]] bool operator==(Defined_Name const&) const = default;
+  };
+
+  // The names a module defines, sorted by kind and name: equal across edits that don't add, remove,
+  // rename or (un)export a definition, so what only depends on the names isn't computed again
+  struct Module_Names {
+    std::vector<Defined_Name> names;
+
+    [[nodiscard]] Defined_Name const* find(std::string_view name_, Name_Kind kind_) const;
+    [[nodiscard]] bool operator==(Module_Names const&) const = default;
+  };
+
+  // An imported name, bound to what the source module defines under it
+  // Visibility is decided at bind time: a non-pub definition is never bound, only remembered to explain the failure
+  struct Import_Binding {
+    std::string local_name;  // The alias, or item_name
+    std::string source_module;
+    std::string item_name;
+    bool type = false;          // Source exports a type named item_name
+    bool func = false;          // Source exports a function named item_name
+    bool type_not_pub = false;  // Source defines item_name as a type but doesn't export it
+    bool func_not_pub = false;
+
+    [[nodiscard]] bool operator==(Import_Binding const&) const = default;
+  };
 
-  // Import resolution: module_path -> (local_name -> (source_module, item_name))
   // Example: For "import Geometry.{ Point, Circle as C }" in module "Main"
-  //   import_maps["Main"]["Point"] = ("Geometry", "Point")
-  //   import_maps["Main"]["C"] = ("Geometry", "Circle")
-  std::map<std::string, std::map<std::string, std::pair<std::string, std::string>>> import_maps;
+  //   find("Point") -> Geometry's Point
+  //   find("C") -> Geometry's Circle
+  struct Import_Bindings {
+    std::vector<Import_Binding> bindings;  // Sorted by local name; of two imports of one name the later wins
+
+    [[nodiscard]] Import_Binding const* find(std::string_view local_name_) const;
+    [[nodiscard]] bool operator==(Import_Bindings const&) const = default;
+  };
+
+  struct Resolution_Key {
+    std::string module;  // Module the path is written in
+    Name_Kind kind{};
+    std::string path;  // Dot-joined, without type arguments: "Std.Collections.Vec" for Std.Collections.Vec<T>
+
+    [[nodiscard]] bool operator==(Resolution_Key const&) const = default;
+  };
+
+  struct Resolution_Key_Hash {
+    [[nodiscard]] std::size_t operator()(Resolution_Key const& key_) const;
+  };
+
+  // Outcome of resolving one path from one module, misses included
+  // Names the definition, which resolve_name then looks up in the defining module's index
+  struct Resolution {
+    bool found = false;
+    std::string module;     // Module defining the item
+    std::string item_name;  // Name it is defined under (not the alias it was imported as)
+    std::string error;      // Diagnostic of a miss
+
+    [[nodiscard]] bool operator==(Resolution const&) const = default;
+  };
+
+  Query_Engine queries;
+
+  // The const lookups read through the tables, and the derived ones memoize what they compute, hence mutable
+
+  // Input: Module_Entry::version by module path, set by store_module; unset for modules that don't exist
+  mutable Input_Query<std::string, std::uint64_t, String_Hash> module_versions{queries};
+
+  mutable Derived_Query<std::string, Module_Index, String_Hash> module_indices{
+      queries, [this](std::string const& module_path_) { return compute_module_index(module_path_); }
+  };
+  mutable Derived_Query<std::string, Module_Names, String_Hash> module_names{
+      queries, [this](std::string const& module_path_) { return compute_module_names(module_path_); }
+  };
+  mutable Derived_Query<std::string, Import_Bindings, String_Hash> import_bindings{
+      queries, [this](std::string const& module_path_) { return compute_import_bindings(module_path_); }
+  };
+  mutable Derived_Query<Resolution_Key, Resolution, Resolution_Key_Hash> resolutions{
+      queries, [this](Resolution_Key const& key_) { return compute_resolution(key_); }
+  };
 
-  // Name-to-item indices for O(1) lookups (built after modules loaded)
-  // Key: (module_path, item_name), Value: pointer to Item in module
-  std::map<std::pair<std::string, std::string>, ast::Item const*> type_index;
-  std::map<std::pair<std::string, std::string>, ast::Item const*> func_index;
+  // The module as of the current revision; the query calling this depends on its version
+  [[nodiscard]] Module_Entry const* read_module(std::string_view module_path_) const;
 
-  // Build import map for all loaded modules
-  void build_import_maps();
+  [[nodiscard]] Module_Index compute_module_index(std::string const& module_path_) const;
+  [[nodiscard]] Module_Names compute_module_names(std::string const& module_path_) const;
+  [[nodiscard]] Import_Bindings compute_import_bindings(std::string const& module_path_) const;
+  [[nodiscard]] Resolution compute_resolution(Resolution_Key const& key_) const;
 
-  // Build name indices for fast lookups
-  void build_name_indices();
+  // The index of a loaded module (nullptr if there is no such module)
+  [[nodiscard]] Module_Index const* find_index(std::string_view module_path_) const;
 
-  // Check for circular import dependencies between modules
-  // Returns true if a cycle is detected (and reports error)
-  [[nodiscard]] bool check_circular_imports() const;
+  [[nodiscard]] ast::Item const*
+  find_item(std::string_view module_path_, std::string_view name_, Name_Kind kind_) const;
 
-  // Report a semantic error with source position
-  // The span.file contains the File_Id for proper error location
-  void error(Source_Range span_, std::string message_) const { diagnostics->add_error(span_, std::move(message_)); }
+  // Helper: Name of the self type of an impl ("Array" for "impl<T> Array<T>"), nullopt for structural types
+  [[nodiscard]] static std::optional<std::string_view> impl_self_type_name(ast::Type_Name const& type_name_);
 
   // Helper: Check if a name matches an item
   [[nodiscard]] static bool item_matches_name(ast::Item const& item_, std::string_view name_);
 
   // Helper: Get the name of an item (function name, struct name, etc.)
-  [[nodiscard]] static std::optional<std::string> get_item_name(ast::Item const& item_);
+  [[nodiscard]] static std::optional<std::string_view> get_item_name(ast::Item const& item_);
 
-  // Helper methods for resolve_type_name - handle each Type_Name variant
-  // These take the parent context to call public methods like find_type_def()
-  [[nodiscard]] std::optional<std::pair<std::string, ast::Item const*>> resolve_path_type(
-      Semantic_Context const& ctx_,
+  // Shared by resolve_type_name and resolve_var_name: memoized lookup of a (possibly qualified) name
+  // Type arguments on the segments are not part of the key - callers resolve them separately
+  // sink_ == nullptr reports to the context's manager, and only when the result is computed
+  template <typename Segment>
+  [[nodiscard]] std::optional<std::pair<std::string, ast::Item const*>> resolve_name(
       std::string const& current_module_,
-      ast::Path_Type const& type_
+      std::vector<Segment> const& segments_,
+      Name_Kind kind_,
+      Source_Range span_,
+      Diagnostic_Sink* sink_
   ) const;
-  static void resolve_function_type(
-      Semantic_Context const& ctx_,
-      std::string const& current_module_,
-      ast::Function_Type const& type_
-  );
-  static void
-  resolve_array_type(Semantic_Context const& ctx_, std::string const& current_module_, ast::Array_Type const& type_);
-  static void
-  resolve_tuple_type(Semantic_Context const& ctx_, std::string const& current_module_, ast::Tuple_Type const& type_);
+
+  // resolve_type_name and resolve_var_name, reporting like resolve_name
+  [[nodiscard]] std::optional<std::pair<std::string, ast::Item const*>>
+  resolve_type(std::string const& current_module_, ast::Type_Name const& name_, Diagnostic_Sink* sink_) const;
+  [[nodiscard]] std::optional<std::pair<std::string, ast::Item const*>>
+  resolve_var(std::string const& current_module_, ast::Var_Name const& name_, Diagnostic_Sink* sink_) const;
+
+  // Helper methods for resolve_type - handle each Type_Name variant
+  [[nodiscard]] std::optional<std::pair<std::string, ast::Item const*>>
+  resolve_path_type(std::string const& current_module_, ast::Path_Type const& type_, Diagnostic_Sink* sink_) const;
+  void
+  resolve_function_type(std::string const& current_module_, ast::Function_Type const& type_, Diagnostic_Sink* sink_)
+      const;
+  void resolve_array_type(std::string const& current_module_, ast::Array_Type const& type_, Diagnostic_Sink* sink_)
+      const;
+  void resolve_tuple_type(std::string const& current_module_, ast::Tuple_Type const& type_, Diagnostic_Sink* sink_)
+      const;
 };
 
 // ============================================================================
@@ -83,138 +305,380 @@ Semantic_Context& Semantic_Context::operator=(Semantic_Context&&) noexcept = def
 Semantic_Context::~Semantic_Context() = default;
 
 bool Semantic_Context::load_modules(std::filesystem::path const& src_root_) {
+  Cancellation_Token const never_cancelled;
+  return load_modules(src_root_, never_cancelled) == Load_Status::Ok;
+}
+
+void Semantic_Context::set_module_manifest(std::filesystem::path manifest_path_) {
+  m_impl->manifest_path = std::move(manifest_path_);
+}
+
+void Semantic_Context::set_parse_cache(std::filesystem::path directory_, std::uintmax_t max_bytes_) {
+  m_impl->parse_cache =
+      directory_.empty() ? nullptr : std::make_unique<Parse_Cache>(std::move(directory_), max_bytes_);
+}
+
+void Semantic_Context::set_interface_dir(std::filesystem::path directory_) {
+  m_impl->interface_dir = std::move(directory_);
+}
+
+Load_Status Semantic_Context::load_modules(std::filesystem::path const& src_root_, Cancellation_Token const& cancel_) {
+  if (m_impl->pool == nullptr) {
+    m_impl->pool = std::make_unique<Thread_Pool>();
+  }
+  auto const checkpoint = m_impl->checkpoint();
+
   // Discover all modules in src/ directory
-  auto const descriptors = Module_Loader::discover_modules(src_root_);
+  auto const descriptors = Module_Loader::discover_modules(
+      src_root_, Discovery_Options{.pool = m_impl->pool.get(), .manifest_path = m_impl->manifest_path}
+  );
 
-  // Load and parse each module (files are registered with the shared registry)
-  for (auto const& desc: descriptors) {
-    auto module_opt = Module_Loader::load_module(desc, *m_impl->diagnostics);
-    if (!module_opt.has_value()) {
-      return false;  // Parse error or duplicate definition
+  // Read and parse all files of all modules in parallel (files are registered with the shared registry)
+  // Modules are staged locally: nothing touches m_impl until we know the load wasn't cancelled
+  auto loaded = Module_Loader::load_modules(
+      descriptors, *m_impl->diagnostics, *m_impl->pool, &cancel_, m_impl->parse_cache.get()
+  );
+  if (m_impl->parse_cache != nullptr) {
+    m_impl->parse_cache->evict();
+  }
+  if (cancel_.is_cancelled()) {
+    return m_impl->cancel_load(checkpoint);
+  }
+  m_impl->set_src_root(src_root_);
+
+  std::vector<Impl::Staged_Module> staged;
+  staged.reserve(descriptors.size());
+  bool load_failed = false;
+  for (std::size_t i = 0; i < descriptors.size(); ++i) {
+    if (!loaded[i].has_value()) {
+      load_failed = true;  // Parse error or duplicate definition
+      break;
     }
+    staged.push_back(Impl::Staged_Module{
+        .path = descriptors[i].module_path_string(),
+        .directory = descriptors[i].directory,
+        .module = std::move(*loaded[i]),
+    });
+  }
+
+  return m_impl->commit_modules(std::move(staged), load_failed);
+}
+
+bool Semantic_Context::load_reachable_modules(
+    std::filesystem::path const& src_root_,
+    std::vector<std::string> const& entry_modules_
+) {
+  Cancellation_Token const never_cancelled;
+  return load_reachable_modules(src_root_, entry_modules_, never_cancelled) == Load_Status::Ok;
+}
 
-    std::string const module_path = desc.module_path_string();
+Load_Status Semantic_Context::load_reachable_modules(
+    std::filesystem::path const& src_root_,
+    std::vector<std::string> const& entry_modules_,
+    Cancellation_Token const& cancel_
+) {
+  if (m_impl->pool == nullptr) {
+    m_impl->pool = std::make_unique<Thread_Pool>();
+  }
+  auto const checkpoint = m_impl->checkpoint();
 
-    // Store the module
-    m_impl->modules[module_path] = std::move(*module_opt);
+  // Module paths already scheduled (value unused), so that each module is located and parsed once
+  Flat_String_Map<bool> seen;
+  std::vector<Module_Descriptor> wave;
+  bool load_failed = false;
+
+  for (auto const& entry_module: entry_modules_) {
+    if (!seen.try_emplace(entry_module, true).second) {
+      continue;
+    }
+    std::vector<std::string> path;
+    for (auto const segment: std::views::split(entry_module, '.')) {
+      path.emplace_back(segment.begin(), segment.end());
+    }
+    if (auto descriptor = Module_Loader::locate_module(src_root_, path)) {
+      wave.push_back(std::move(*descriptor));
+    } else {
+      m_impl->diagnostics->add_error(Source_Range{}, std::format("entry module '{}' not found", entry_module));
+      load_failed = true;
+    }
   }
 
-  // Check for circular imports before building import maps
-  if (m_impl->check_circular_imports()) {
-    return false;  // Circular import detected
+  // Breadth-first over imports: every module of a wave is read and parsed in parallel, and the
+  // imports they declare form the next wave. Unknown imported modules are left to name resolution.
+  // Modules past the first wave are dependencies: an up-to-date interface stands in for their sources.
+  std::vector<Impl::Staged_Module> staged;
+  bool entry_wave = true;
+  while (!wave.empty() && !load_failed) {
+    std::vector<std::optional<ast::Module>> loaded(wave.size());
+    std::vector<Module_Descriptor> to_parse;
+    std::vector<std::size_t> parsed_index;  // Wave position of each of to_parse
+    for (std::size_t i = 0; i < wave.size(); ++i) {
+      if (!entry_wave && !m_impl->interface_dir.empty()) {
+        loaded[i] = m_impl->load_interface(wave[i]);
+        if (loaded[i].has_value()) {
+          continue;
+        }
+      }
+      to_parse.push_back(wave[i]);
+      parsed_index.push_back(i);
+    }
+    entry_wave = false;
+
+    auto parsed = Module_Loader::load_modules(
+        to_parse, *m_impl->diagnostics, *m_impl->pool, &cancel_, m_impl->parse_cache.get()
+    );
+    if (cancel_.is_cancelled()) {
+      return m_impl->cancel_load(checkpoint);
+    }
+    for (std::size_t i = 0; i < parsed.size(); ++i) {
+      loaded[parsed_index[i]] = std::move(parsed[i]);
+    }
+
+    std::vector<Module_Descriptor> next_wave;
+    std::string import_path;
+    for (std::size_t i = 0; i < wave.size(); ++i) {
+      if (!loaded[i].has_value()) {
+        load_failed = true;  // Parse error or duplicate definition
+        break;
+      }
+      for (auto const& import_stmt: loaded[i]->imports) {
+        import_path.clear();
+        for (size_t j = 0; j < import_stmt.module_path.size(); ++j) {
+          if (j > 0) {
+            import_path += '.';
+          }
+          import_path += import_stmt.module_path[j];
+        }
+        if (!seen.try_emplace(import_path, true).second) {
+          continue;
+        }
+        if (auto descriptor = Module_Loader::locate_module(src_root_, import_stmt.module_path)) {
+          next_wave.push_back(std::move(*descriptor));
+        }
+      }
+      staged.push_back(Impl::Staged_Module{
+          .path = wave[i].module_path_string(), .directory = wave[i].directory, .module = std::move(*loaded[i])
+      });
+    }
+    wave = std::move(next_wave);
+  }
+  if (m_impl->parse_cache != nullptr) {
+    m_impl->parse_cache->evict();
   }
+  m_impl->set_src_root(src_root_);
 
-  // Build import maps for cross-module name resolution
-  m_impl->build_import_maps();
+  return m_impl->commit_modules(std::move(staged), load_failed);
+}
 
-  // Build name indices for O(1) lookups
-  m_impl->build_name_indices();
+std::optional<ast::Module> Semantic_Context::Impl::load_interface(Module_Descriptor const& descriptor_) const {
+  auto const path = interface_file_path(interface_dir, descriptor_.module_path_string());
+  std::error_code ec;
+  if (!std::filesystem::is_regular_file(path, ec)) {
+    return std::nullopt;
+  }
+  auto const content_hash = module_content_hash(descriptor_);
+  if (!content_hash || !interface_file_is_current(path, *content_hash)) {
+    return std::nullopt;  // Checked first: a stale interface registers nothing
+  }
+  // Diagnostics about the module's definitions point into its own .life files, registered with the
+  // text the content hash was taken over
+  std::vector<File_Id> files;
+  files.reserve(descriptor_.files.size());
+  for (auto const& file_path: descriptor_.files) {
+    auto const source = Mapped_File::open(file_path);
+    files.push_back(
+        diagnostics->register_file(file_path.string(), source ? std::string{source->bytes()} : std::string{})
+    );
+  }
+  return read_interface_file(path, *content_hash, files);
+}
 
-  return true;
+bool Semantic_Context::update(std::vector<std::filesystem::path> const& changed_paths_) {
+  Cancellation_Token const never_cancelled;
+  return update(changed_paths_, never_cancelled) == Load_Status::Ok;
 }
 
-ast::Module const* Semantic_Context::get_module(std::string const& module_path_) const {
-  auto const it = m_impl->modules.find(module_path_);
-  if (it == m_impl->modules.end()) {
-    return nullptr;
+Load_Status
+Semantic_Context::update(std::vector<std::filesystem::path> const& changed_paths_, Cancellation_Token const& cancel_) {
+  if (m_impl->src_root.empty()) {
+    m_impl->diagnostics->add_error(Source_Range{}, "nothing to update: no modules were loaded from a src/ directory");
+    return Load_Status::Failed;
+  }
+
+  // Changed .life files, canonical like the descriptors' (deleted files included), and their directories
+  std::vector<std::filesystem::path> files;
+  std::vector<std::filesystem::path> directories;
+  for (auto const& path: changed_paths_) {
+    std::error_code ec;
+    auto file = std::filesystem::weakly_canonical(path, ec);
+    if (ec || file.extension() != ".life") {
+      continue;
+    }
+    directories.push_back(file.parent_path());
+    files.push_back(std::move(file));
+  }
+  std::ranges::sort(directories);
+  directories.erase(std::ranges::unique(directories).begin(), directories.end());
+
+  // Each directory is one module: reload it keeping the items of its unchanged files, load it if
+  // it is new, or empty it if its last file is gone. Staged like a load, so that a failed or
+  // cancelled update leaves the context as it was.
+  std::vector<Impl::Staged_Module> staged;
+  bool load_failed = false;
+  auto const checkpoint = m_impl->checkpoint();
+  for (auto const& directory: directories) {
+    auto const* entry = m_impl->find_module_by_directory(directory);
+    auto descriptor = Module_Loader::describe_directory(m_impl->src_root, directory);
+    if (!descriptor) {
+      if (entry != nullptr) {
+        staged.push_back(Impl::Staged_Module{.path = entry->path, .directory = directory, .module = {}});
+      }
+      continue;  // Otherwise not a module directory
+    }
+
+    auto module = entry != nullptr
+                      ? Module_Loader::reload_module(
+                            *descriptor, entry->module, files, *m_impl->diagnostics, &cancel_, m_impl->parse_cache.get()
+                        )
+                      : Module_Loader::load_module(
+                            *descriptor, *m_impl->diagnostics, &cancel_, m_impl->parse_cache.get()
+                        );
+    if (cancel_.is_cancelled()) {
+      return m_impl->cancel_load(checkpoint);
+    }
+    if (!module) {
+      load_failed = true;  // Parse error or duplicate definition
+      break;
+    }
+    staged.push_back(Impl::Staged_Module{
+        .path = descriptor->module_path_string(), .directory = directory, .module = std::move(*module)
+    });
+  }
+  if (m_impl->parse_cache != nullptr) {
+    m_impl->parse_cache->evict();
   }
-  return &it->second;
+  if (load_failed) {
+    return Load_Status::Failed;
+  }
+
+  return m_impl->commit_update(std::move(staged));
+}
+
+ast::Module const* Semantic_Context::get_module(std::string_view module_path_) const {
+  auto const* entry = m_impl->find_module(module_path_);
+  return entry == nullptr ? nullptr : &entry->module;
+}
+
+std::vector<std::string> Semantic_Context::dependency_order() const {
+  std::vector<std::string> paths;
+  paths.reserve(m_impl->dependency_order.size());
+  std::ranges::transform(m_impl->dependency_order, std::back_inserter(paths), [this](Impl::Module_Id id_) {
+    return m_impl->modules[id_]->path;
+  });
+  return paths;
 }
 
 std::vector<std::string> Semantic_Context::module_paths() const {
   std::vector<std::string> paths;
   paths.reserve(m_impl->modules.size());
-  std::ranges::transform(m_impl->modules, std::back_inserter(paths), [](auto const& pair_) { return pair_.first; });
+  std::ranges::transform(m_impl->modules, std::back_inserter(paths), [](auto const& entry_) { return entry_->path; });
+  std::ranges::sort(paths);
   return paths;
 }
 
-ast::Item const* Semantic_Context::find_type_def(std::string const& module_path_, std::string_view type_name_) const {
-  // O(1) lookup using pre-built index
-  auto const key = std::make_pair(module_path_, std::string(type_name_));
-  auto const it = m_impl->type_index.find(key);
-  if (it != m_impl->type_index.end()) {
-    return it->second;
-  }
-  return nullptr;
+ast::Item const* Semantic_Context::find_type_def(std::string_view module_path_, std::string_view type_name_) const {
+  // O(1) lookup in the module's memoized index, no allocation once it is current
+  return m_impl->find_item(module_path_, type_name_, Impl::Name_Kind::Type);
 }
 
-ast::Item const* Semantic_Context::find_func_def(std::string const& module_path_, std::string_view func_name_) const {
-  // O(1) lookup using pre-built index
-  auto const key = std::make_pair(module_path_, std::string(func_name_));
-  auto const it = m_impl->func_index.find(key);
-  if (it != m_impl->func_index.end()) {
-    return it->second;
-  }
-  return nullptr;
+ast::Item const* Semantic_Context::find_func_def(std::string_view module_path_, std::string_view func_name_) const {
+  // O(1) lookup in the module's memoized index, no allocation once it is current
+  return m_impl->find_item(module_path_, func_name_, Impl::Name_Kind::Func);
 }
 
 ast::Func_Def const* Semantic_Context::find_method_def(
-    std::string const& module_path_,
+    std::string_view module_path_,
     // NOLINTNEXTLINE(bugprone-easily-swappable-parameters) - semantically distinct: type vs method
     std::string_view type_name_,
     std::string_view method_name_
 ) const {
-  auto const* module = get_module(module_path_);
-  if (module == nullptr) {
+  // Two probes into the module's index: type, then method
+  auto const* index = m_impl->find_index(module_path_);
+  if (index == nullptr) {
     return nullptr;
   }
+  auto const* type_methods = index->methods.find(type_name_);
+  if (type_methods == nullptr) {
+    return nullptr;
+  }
+  auto const* method = type_methods->by_name.find(method_name_);
+  return method == nullptr ? nullptr : *method;
+}
 
-  // Search module-level items for impl blocks
-  for (auto const& item: module->items) {
-    // Check if this is an impl block
-    auto const* impl_ptr = std::get_if<std::shared_ptr<ast::Impl_Block>>(&item.item);
-    if (impl_ptr == nullptr) {
-      continue;
-    }
-
-    auto const& impl_block = **impl_ptr;
+std::span<ast::Func_Def const* const>
+Semantic_Context::type_methods(std::string_view module_path_, std::string_view type_name_) const {
+  auto const* index = m_impl->find_index(module_path_);
+  if (index == nullptr) {
+    return {};
+  }
+  auto const* type_methods = index->methods.find(type_name_);
+  if (type_methods == nullptr) {
+    return {};
+  }
+  return type_methods->all;
+}
 
-    // Check if impl block is for the requested type
-    // The type_name in Impl_Block is a Type_Name variant - for simple types it's Path_Type
-    auto const* path_type =
-        std::get_if<ast::Path_Type>(&static_cast<ast::Type_Name::Base_Type const&>(impl_block.type_name));
-    if (path_type == nullptr || path_type->segments.empty()) {
-      continue;  // Not a simple path type (e.g., impl for function type - unlikely)
-    }
+std::optional<std::pair<std::string, ast::Item const*>>
+Semantic_Context::resolve_type_name(std::string const& current_module_, ast::Type_Name const& name_) const {
+  return m_impl->resolve_type(current_module_, name_, nullptr);
+}
 
-    // For simple impl like "impl Point", segments[0].value is "Point"
-    // For generic impl like "impl Array<T>", segments[0].value is "Array"
-    if (path_type->segments[0].value != type_name_) {
-      continue;
-    }
+std::optional<std::pair<std::string, ast::Item const*>> Semantic_Context::resolve_type_name(
+    std::string const& current_module_,
+    ast::Type_Name const& name_,
+    Diagnostic_Sink& sink_
+) const {
+  return m_impl->resolve_type(current_module_, name_, &sink_);
+}
 
-    // Found matching impl block - search for the method
-    for (auto const& method: impl_block.methods) {
-      if (method.declaration.name == method_name_) {
-        return &method;
-      }
-    }
-  }
+std::optional<std::pair<std::string, ast::Item const*>>
+Semantic_Context::resolve_var_name(std::string const& current_module_, ast::Var_Name const& name_) const {
+  return m_impl->resolve_var(current_module_, name_, nullptr);
+}
 
-  return nullptr;
+std::optional<std::pair<std::string, ast::Item const*>> Semantic_Context::resolve_var_name(
+    std::string const& current_module_,
+    ast::Var_Name const& name_,
+    Diagnostic_Sink& sink_
+) const {
+  return m_impl->resolve_var(current_module_, name_, &sink_);
 }
 
-std::optional<std::pair<std::string, ast::Item const*>>
-Semantic_Context::resolve_type_name(std::string const& current_module_, ast::Type_Name const& name_) const {
+std::optional<std::pair<std::string, ast::Item const*>> Semantic_Context::Impl::resolve_type(
+    std::string const& current_module_,
+    ast::Type_Name const& name_,
+    Diagnostic_Sink* sink_
+) const {
   // Type_Name is a variant: Path_Type, Function_Type, Array_Type, Tuple_Type
   // Path_Type resolves to a type definition (struct, enum, etc.)
   // Compound types (Function_Type, Array_Type, Tuple_Type) recursively validate inner types
   // and return nullopt (they're structural, not named definitions)
 
   return std::visit(
-      [this, &current_module_](auto const& type_variant_) -> std::optional<std::pair<std::string, ast::Item const*>> {
+      [this, &current_module_, sink_](auto const& type_variant_
+      ) -> std::optional<std::pair<std::string, ast::Item const*>> {
         using T = std::decay_t<decltype(type_variant_)>;
 
         if constexpr (std::is_same_v<T, ast::Path_Type>) {
-          return m_impl->resolve_path_type(*this, current_module_, type_variant_);
+          return resolve_path_type(current_module_, type_variant_, sink_);
         } else if constexpr (std::is_same_v<T, ast::Function_Type>) {
-          Impl::resolve_function_type(*this, current_module_, type_variant_);
+          resolve_function_type(current_module_, type_variant_, sink_);
           return std::nullopt;
         } else if constexpr (std::is_same_v<T, ast::Array_Type>) {
-          Impl::resolve_array_type(*this, current_module_, type_variant_);
+          resolve_array_type(current_module_, type_variant_, sink_);
           return std::nullopt;
         } else if constexpr (std::is_same_v<T, ast::Tuple_Type>) {
-          Impl::resolve_tuple_type(*this, current_module_, type_variant_);
+          resolve_tuple_type(current_module_, type_variant_, sink_);
           return std::nullopt;
         }
       },
@@ -223,353 +687,499 @@ Semantic_Context::resolve_type_name(std::string const& current_module_, ast::Typ
 }
 
 std::optional<std::pair<std::string, ast::Item const*>> Semantic_Context::Impl::resolve_path_type(
-    Semantic_Context const& ctx_,
     std::string const& current_module_,
-    ast::Path_Type const& path_type_
+    ast::Path_Type const& path_type_,
+    Diagnostic_Sink* sink_
 ) const {
   if (path_type_.segments.empty()) {
     return std::nullopt;  // Invalid type name
   }
 
-  auto const& first_segment = path_type_.segments[0].value;
-
-  // Case 1: Single-segment name (e.g., "Point", "Vec<T>")
-  if (path_type_.segments.size() == 1) {
-    // Also resolve type parameters recursively
-    for (auto const& type_param: path_type_.segments[0].type_params) {
-      // Recursively resolve each type parameter - validate they resolve
-      (void)ctx_.resolve_type_name(current_module_, type_param);
-    }
-
-    // Try local module first
-    if (auto const* item = ctx_.find_type_def(current_module_, first_segment)) {
-      return std::make_pair(current_module_, item);
-    }
-
-    // Try imports
-    auto const module_it = import_maps.find(current_module_);
-    if (module_it != import_maps.end()) {
-      auto const& import_map = module_it->second;
-      auto const import_it = import_map.find(first_segment);
-      if (import_it != import_map.end()) {
-        auto const& [source_module, item_name] = import_it->second;
-        if (auto const* item = ctx_.find_type_def(source_module, item_name)) {
-          if (item->is_pub) {
-            return std::make_pair(source_module, item);
-          }
-          error(
-              path_type_.span,
-              std::format("cannot import '{}' from module '{}' - not marked pub", item_name, source_module)
-          );
-          return std::nullopt;
-        }
-      }
-    }
-  }
-  // Case 2: Multi-segment name (e.g., "Std.Collections.Vec")
-  else {
-    // Build module path from all segments except the last
-    std::string module_path;
-    for (size_t i = 0; i < path_type_.segments.size() - 1; ++i) {
-      if (i > 0) {
-        module_path += '.';
-      }
-      module_path += path_type_.segments[i].value;
-    }
-
-    auto const& type_name = path_type_.segments.back().value;
-
-    // Also resolve type parameters recursively on the last segment
-    for (auto const& type_param: path_type_.segments.back().type_params) {
-      (void)ctx_.resolve_type_name(current_module_, type_param);
-    }
-
-    if (auto const* item = ctx_.find_type_def(module_path, type_name)) {
-      if (module_path != current_module_ && !item->is_pub) {
-        error(
-            path_type_.span,
-            std::format("cannot access type '{}' from module '{}' - not marked pub", type_name, module_path)
-        );
-        return std::nullopt;
-      }
-      return std::make_pair(module_path, item);
-    }
+  // Also resolve type parameters recursively: "Vec<T>" or the last segment of "Std.Collections.Vec<T>"
+  for (auto const& type_param: path_type_.segments.back().type_params) {
+    (void)resolve_type(current_module_, type_param, sink_);
   }
 
-  // Type not found - report error
-  error(path_type_.span, std::format("type '{}' not found in current module or imports", first_segment));
-  return std::nullopt;
+  return resolve_name(current_module_, path_type_.segments, Name_Kind::Type, path_type_.span, sink_);
 }
 
 void Semantic_Context::Impl::resolve_function_type(
-    Semantic_Context const& ctx_,
     std::string const& current_module_,
-    ast::Function_Type const& type_
-) {
+    ast::Function_Type const& type_,
+    Diagnostic_Sink* sink_
+) const {
   // Function types are structural - recursively validate inner types
   // fn(I32, String): Bool - validate I32, String, and Bool types
 
   for (auto const& param_type: type_.param_types) {
     if (param_type) {
-      (void)ctx_.resolve_type_name(current_module_, *param_type);
+      (void)resolve_type(current_module_, *param_type, sink_);
     }
   }
 
   if (type_.return_type) {
-    (void)ctx_.resolve_type_name(current_module_, *type_.return_type);
+    (void)resolve_type(current_module_, *type_.return_type, sink_);
   }
 }
 
 void Semantic_Context::Impl::resolve_array_type(
-    Semantic_Context const& ctx_,
     std::string const& current_module_,
-    ast::Array_Type const& type_
-) {
+    ast::Array_Type const& type_,
+    Diagnostic_Sink* sink_
+) const {
   // Array types are structural - validate the element type
   // [I32; 5] - validate I32 type
 
   if (type_.element_type) {
-    (void)ctx_.resolve_type_name(current_module_, *type_.element_type);
+    (void)resolve_type(current_module_, *type_.element_type, sink_);
   }
 }
 
 void Semantic_Context::Impl::resolve_tuple_type(
-    Semantic_Context const& ctx_,
     std::string const& current_module_,
-    ast::Tuple_Type const& type_
-) {
+    ast::Tuple_Type const& type_,
+    Diagnostic_Sink* sink_
+) const {
   // Tuple types are structural - validate all element types
   // (I32, String, Bool) - validate each element type
 
   for (auto const& element_type: type_.element_types) {
-    (void)ctx_.resolve_type_name(current_module_, element_type);
+    (void)resolve_type(current_module_, element_type, sink_);
   }
 }
 
-std::optional<std::pair<std::string, ast::Item const*>>
-Semantic_Context::resolve_var_name(std::string const& current_module_, ast::Var_Name const& name_) const {
+std::optional<std::pair<std::string, ast::Item const*>> Semantic_Context::Impl::resolve_var(
+    std::string const& current_module_,
+    ast::Var_Name const& name_,
+    Diagnostic_Sink* sink_
+) const {
   if (name_.segments.empty()) {
     return std::nullopt;  // Invalid name
   }
 
-  auto const& first_segment = name_.segments[0].value;
-
   // Validate type parameters on all segments
   for (auto const& segment: name_.segments) {
     for (auto const& type_param: segment.type_params) {
-      (void)resolve_type_name(current_module_, type_param);
+      (void)resolve_type(current_module_, type_param, sink_);
     }
   }
 
-  // Case 1: Single-segment name (e.g., "calculate", "println", "Vec::<I32>::new")
-  if (name_.segments.size() == 1) {
-    // Try local module first
-    if (auto const* item = find_func_def(current_module_, first_segment)) {
-      return std::make_pair(current_module_, item);
-    }
+  return resolve_name(current_module_, name_.segments, Name_Kind::Func, name_.span, sink_);
+}
 
-    // Try imports
-    auto const module_it = m_impl->import_maps.find(current_module_);
-    if (module_it != m_impl->import_maps.end()) {
-      auto const& import_map = module_it->second;
-      auto const import_it = import_map.find(first_segment);
-      if (import_it != import_map.end()) {
-        auto const& [source_module, item_name] = import_it->second;
-        if (auto const* item = find_func_def(source_module, item_name)) {
-          if (item->is_pub) {
-            return std::make_pair(source_module, item);
-          }
-          m_impl->error(
-              name_.span,
-              std::format("cannot import function '{}' from module '{}' - not marked pub", item_name, source_module)
-          );
-          return std::nullopt;
+// ============================================================================
+// Impl helpers
+// ============================================================================
+
+Load_Status Semantic_Context::Impl::commit_modules(std::vector<Staged_Module> staged_, bool load_failed_) {
+  // Commit: store the modules; indices and bindings are computed when first looked up
+  for (auto& staged: staged_) {
+    store_module(std::move(staged));
+  }
+
+  if (load_failed_) {
+    return Load_Status::Failed;
+  }
+
+  if (check_circular_imports()) {
+    return Load_Status::Failed;  // Circular import detected
+  }
+
+  return Load_Status::Ok;
+}
+
+Load_Status Semantic_Context::Impl::commit_update(std::vector<Staged_Module> staged_) {
+  // Storing a module sets its version; what was derived from it is revalidated on the next lookup
+  for (auto& staged: staged_) {
+    store_module(std::move(staged));
+  }
+
+  // Linear in modules and imports, no parsing: cheap enough to run over the whole graph
+  if (check_circular_imports()) {
+    return Load_Status::Failed;
+  }
+
+  return Load_Status::Ok;
+}
+
+bool Semantic_Context::Impl::check_circular_imports() {
+  // One edge per import statement of a loaded module, labelled with the statement's index
+  std::vector<Import_Graph::Edge> edges;
+  std::string source_module;
+  for (auto const& entry: modules) {
+    auto const& imports = entry->module.imports;
+    for (std::uint32_t i = 0; i < imports.size(); ++i) {
+      source_module.clear();
+      for (size_t j = 0; j < imports[i].module_path.size(); ++j) {
+        if (j > 0) {
+          source_module += '.';
         }
+        source_module += imports[i].module_path[j];
       }
-    }
-  }
-  // Case 2: Multi-segment name (e.g., "Std.IO.println")
-  else {
-    std::string module_path;
-    for (size_t i = 0; i < name_.segments.size() - 1; ++i) {
-      if (i > 0) {
-        module_path += '.';
+      if (auto const* source = find_module(source_module)) {
+        edges.push_back(Import_Graph::Edge{.from = entry->id, .to = source->id, .label = i});
       }
-      module_path += name_.segments[i].value;
     }
+  }
 
-    auto const& func_name = name_.segments.back().value;
+  Import_Graph const graph(modules.size(), std::move(edges));
+  auto const sccs = graph.strongly_connected_components();
 
-    if (auto const* item = find_func_def(module_path, func_name)) {
-      if (module_path != current_module_ && !item->is_pub) {
-        m_impl->error(
-            name_.span,
-            std::format("cannot access function '{}' from module '{}' - not marked pub", func_name, module_path)
-        );
-        return std::nullopt;
-      }
-      return std::make_pair(module_path, item);
+  dependency_order.clear();
+  dependency_order.reserve(modules.size());
+  bool found_cycle = false;
+  for (auto const& component: sccs.components) {
+    dependency_order.insert(dependency_order.end(), component.begin(), component.end());
+    if (!graph.is_cyclic(component)) {
+      continue;
     }
+    found_cycle = true;
+
+    // Start the cycle at the module with the smallest path, so the report doesn't depend on load order
+    auto const start = *std::ranges::min_element(component, {}, [this](Module_Id id_) -> std::string_view {
+      return modules[id_]->path;
+    });
+    report_import_cycle(graph.find_cycle(start, sccs));
+  }
+
+  return found_cycle;
+}
+
+void Semantic_Context::Impl::report_import_cycle(std::span<Import_Graph::Edge const> cycle_) const {
+  auto const import_span = [this](Import_Graph::Edge const& edge_) {
+    return modules[edge_.from]->module.imports[edge_.label].span;
+  };
+
+  // "A -> B -> C -> A"
+  std::string cycle_desc = modules[cycle_.front().from]->path;
+  for (auto const& edge: cycle_) {
+    cycle_desc += " -> ";
+    cycle_desc += modules[edge.to]->path;
+  }
+
+  // Error at the first import of the cycle, a note at each of the others
+  Diagnostic diag{
+      .level = Diagnostic_Level::Error,
+      .range = import_span(cycle_.front()),
+      .message = std::format("circular import detected: {}", cycle_desc),
+      .notes = {},
+  };
+  for (auto const& edge: cycle_.subspan(1)) {
+    diag.notes.push_back(Diagnostic{
+        .level = Diagnostic_Level::Note,
+        .range = import_span(edge),
+        .message = std::format("'{}' imports '{}' here", modules[edge.from]->path, modules[edge.to]->path),
+        .notes = {},
+    });
   }
+  diagnostics->add_diagnostics({std::move(diag)});
+}
 
-  // Function not found - report error
-  m_impl->error(name_.span, std::format("function '{}' not found in current module or imports", first_segment));
-  return std::nullopt;
+Semantic_Context::Impl::Module_Entry& Semantic_Context::Impl::store_module(Staged_Module staged_) {
+  auto const [id, inserted] = module_ids.try_emplace(staged_.path, static_cast<Module_Id>(modules.size()));
+  if (inserted) {
+    modules.push_back(std::make_unique<Module_Entry>());
+    modules.back()->id = *id;
+    modules.back()->path = std::move(staged_.path);
+  }
+  auto& entry = *modules[*id];
+  entry.directory = std::move(staged_.directory);
+  entry.module = std::move(staged_.module);
+
+  // Also reaches what was computed while the module didn't exist yet (misses of qualified paths into it)
+  module_versions.set(entry.path, ++entry.version);
+  return entry;
 }
 
 // ============================================================================
-// Impl helpers
+// Queries
 // ============================================================================
 
-bool Semantic_Context::Impl::check_circular_imports() const {
-  // Build dependency graph: module -> set of modules it imports from
-  std::map<std::string, std::set<std::string>> dependencies;
+Semantic_Context::Impl::Defined_Name const*
+Semantic_Context::Impl::Module_Names::find(std::string_view name_, Name_Kind kind_) const {
+  auto const it = std::ranges::partition_point(names, [&](Defined_Name const& defined_) {
+    return defined_.kind != kind_ ? defined_.kind < kind_ : defined_.name < name_;
+  });
+  return it != names.end() && it->kind == kind_ && it->name == name_ ? &*it : nullptr;
+}
 
-  for (auto const& [module_path, module]: modules) {
-    auto& deps = dependencies[module_path];  // Create entry even if no imports
+Semantic_Context::Impl::Import_Binding const*
+Semantic_Context::Impl::Import_Bindings::find(std::string_view local_name_) const {
+  auto const it = std::ranges::lower_bound(bindings, local_name_, {}, &Import_Binding::local_name);
+  return it != bindings.end() && it->local_name == local_name_ ? &*it : nullptr;
+}
 
-    for (auto const& import_stmt: module.imports) {
-      // Build source module path string
-      std::string source_module;
-      for (size_t i = 0; i < import_stmt.module_path.size(); ++i) {
-        if (i > 0) {
-          source_module += '.';
-        }
-        source_module += import_stmt.module_path[i];
-      }
-      deps.insert(source_module);
-    }
-  }
+std::size_t Semantic_Context::Impl::Resolution_Key_Hash::operator()(Resolution_Key const& key_) const {
+  std::size_t const module_hash = std::hash<std::string>{}(key_.module);
+  std::size_t const path_hash = std::hash<std::string>{}(key_.path);
+  return (module_hash * 31 + path_hash) * 2 + static_cast<std::size_t>(key_.kind);
+}
 
-  // DFS to detect cycles
-  // States: 0 = unvisited, 1 = visiting (in current path), 2 = visited (done)
-  std::map<std::string, int> visit_state;
-  std::vector<std::string> current_path;
+Semantic_Context::Impl::Module_Entry const* Semantic_Context::Impl::read_module(std::string_view module_path_) const {
+  (void)module_versions.get(module_path_);
+  return find_module(module_path_);
+}
 
-  // Recursive DFS lambda
-  std::function<bool(std::string const&)> has_cycle = [&](std::string const& module_) -> bool {
-    auto const state_it = visit_state.find(module_);
-    if (state_it != visit_state.end()) {
-      if (state_it->second == 1) {
-        // Found cycle - build cycle path for error message
-        current_path.push_back(module_);
-        return true;
-      }
-      if (state_it->second == 2) {
-        return false;  // Already fully explored, no cycle through this node
-      }
+Semantic_Context::Impl::Module_Index Semantic_Context::Impl::compute_module_index(std::string const& module_path_
+) const {
+  Module_Index index;
+  auto const* entry = read_module(module_path_);
+  if (entry == nullptr) {
+    return index;
+  }
+  index.types.reserve(entry->module.items.size());
+  index.funcs.reserve(entry->module.items.size());
+
+  for (auto const& item: entry->module.items) {
+    auto const name_opt = get_item_name(item);
+    if (!name_opt.has_value()) {
+      continue;  // Skip items without names (e.g., impl blocks)
     }
 
-    visit_state[module_] = 1;  // Mark as visiting
-    current_path.push_back(module_);
+    auto const name = *name_opt;
 
-    // Visit dependencies
-    auto const deps_it = dependencies.find(module_);
-    if (deps_it != dependencies.end()) {
-      for (auto const& dep: deps_it->second) {
-        if (has_cycle(dep)) {
-          return true;
-        }
-      }
+    // Categorize by item type
+    bool const is_type_def = std::visit(
+        [](auto const& stmt_) -> bool {
+          using T = std::decay_t<decltype(stmt_)>;
+          return std::same_as<T, std::shared_ptr<ast::Struct_Def>> ||
+                 std::same_as<T, std::shared_ptr<ast::Enum_Def>> ||
+                 std::same_as<T, std::shared_ptr<ast::Trait_Def>> ||
+                 std::same_as<T, std::shared_ptr<ast::Type_Alias>>;
+        },
+        item.item
+    );
+
+    bool const is_func_def = std::holds_alternative<std::shared_ptr<ast::Func_Def>>(item.item);
+
+    if (is_type_def) {
+      index.types[name] = &item;
     }
+    if (is_func_def) {
+      index.funcs[name] = &item;
+    }
+  }
 
-    current_path.pop_back();
-    visit_state[module_] = 2;  // Mark as fully visited
-    return false;
+  auto const add_methods = [&index](ast::Type_Name const& self_type_, std::vector<ast::Func_Def> const& methods_) {
+    auto const self_name = impl_self_type_name(self_type_);
+    if (!self_name.has_value()) {
+      return;  // Impl for a structural type (function, array, tuple) - not addressable by name
+    }
+    auto& table = index.methods[*self_name];
+    table.all.reserve(table.all.size() + methods_.size());
+    for (auto const& method: methods_) {
+      table.all.push_back(&method);
+      table.by_name.try_emplace(method.declaration.name, &method);
+    }
   };
 
-  // Check all modules
-  for (auto const& [module_path, _]: modules) {
-    current_path.clear();
-    if (has_cycle(module_path)) {
-      // Build cycle description
-      // Find where the cycle starts in current_path
-      auto const& cycle_start = current_path.back();
-      std::string cycle_desc;
-      bool in_cycle = false;
-      for (auto const& m: current_path) {
-        if (m == cycle_start) {
-          in_cycle = true;
-        }
-        if (in_cycle) {
-          if (!cycle_desc.empty()) {
-            cycle_desc += " -> ";
-          }
-          cycle_desc += m;
-        }
+  // Inherent impls first so that their methods take precedence over trait methods of the same name
+  for (auto const& item: entry->module.items) {
+    if (auto const* impl_ptr = std::get_if<std::shared_ptr<ast::Impl_Block>>(&item.item)) {
+      add_methods((*impl_ptr)->type_name, (*impl_ptr)->methods);
+    }
+  }
+  for (auto const& item: entry->module.items) {
+    if (auto const* impl_ptr = std::get_if<std::shared_ptr<ast::Trait_Impl>>(&item.item)) {
+      add_methods((*impl_ptr)->type_name, (*impl_ptr)->methods);
+    }
+  }
+
+  return index;
+}
+
+Semantic_Context::Impl::Module_Names Semantic_Context::Impl::compute_module_names(std::string const& module_path_
+) const {
+  // Taken from the index, so that a name defined twice means the same definition everywhere
+  auto const& index = module_indices.get(module_path_);
+  Module_Names result;
+  result.names.reserve(index.types.size() + index.funcs.size());
+  for (auto const& [name, item]: index.types) {
+    result.names.push_back({.name = std::string{name}, .kind = Name_Kind::Type, .is_pub = item->is_pub});
+  }
+  for (auto const& [name, item]: index.funcs) {
+    result.names.push_back({.name = std::string{name}, .kind = Name_Kind::Func, .is_pub = item->is_pub});
+  }
+  std::ranges::sort(result.names, {}, [](Defined_Name const& defined_) {
+    return std::tie(defined_.kind, defined_.name);
+  });
+  return result;
+}
+
+Semantic_Context::Impl::Import_Bindings
+Semantic_Context::Impl::compute_import_bindings(std::string const& module_path_) const {
+  Import_Bindings result;
+  auto const* entry = read_module(module_path_);
+  if (entry == nullptr) {
+    return result;
+  }
+
+  for (auto const& import_stmt: entry->module.imports) {
+    // Build source module path string
+    std::string source_module;
+    for (size_t i = 0; i < import_stmt.module_path.size(); ++i) {
+      if (i > 0) {
+        source_module += '.';
       }
+      source_module += import_stmt.module_path[i];
+    }
 
-      // Report error using the first import statement in the cycle
-      auto const& module = modules.at(module_path);
-      if (!module.imports.empty()) {
-        error(module.imports[0].span, std::format("circular import detected: {}", cycle_desc));
-      } else {
-        // Fallback: use module span
-        error(module.span, std::format("circular import detected: {}", cycle_desc));
+    // Empty for an unknown module, which is still a dependency: binding again once it is loaded
+    auto const& source = module_names.get(source_module);
+
+    // Bind each imported item; an unknown module or name stays unbound and fails at use sites
+    for (auto const& item: import_stmt.items) {
+      Import_Binding binding{
+          .local_name = item.alias.value_or(item.name),
+          .source_module = source_module,
+          .item_name = item.name,
+          .type = false,
+          .func = false,
+          .type_not_pub = false,
+          .func_not_pub = false,
+      };
+      if (auto const* type = source.find(item.name, Name_Kind::Type)) {
+        (type->is_pub ? binding.type : binding.type_not_pub) = true;
+      }
+      if (auto const* func = source.find(item.name, Name_Kind::Func)) {
+        (func->is_pub ? binding.func : binding.func_not_pub) = true;
       }
-      return true;
+      result.bindings.push_back(std::move(binding));
     }
   }
 
-  return false;
+  // Of two imports of one name the later wins: latest first, then a stable sort keeps it first among equals
+  std::ranges::reverse(result.bindings);
+  std::ranges::stable_sort(result.bindings, {}, &Import_Binding::local_name);
+  auto const duplicates = std::ranges::unique(result.bindings, {}, &Import_Binding::local_name);
+  result.bindings.erase(duplicates.begin(), duplicates.end());
+  return result;
 }
 
-void Semantic_Context::Impl::build_import_maps() {
-  for (auto const& [module_path, module]: modules) {
-    auto& import_map = import_maps[module_path];
+Semantic_Context::Impl::Resolution Semantic_Context::Impl::compute_resolution(Resolution_Key const& key_) const {
+  bool const is_type = key_.kind == Name_Kind::Type;
+  std::string_view const path = key_.path;
+  auto const last_dot = path.rfind('.');
 
-    for (auto const& import_stmt: module.imports) {
-      // Build source module path string
-      std::string source_module;
-      for (size_t i = 0; i < import_stmt.module_path.size(); ++i) {
-        if (i > 0) {
-          source_module += '.';
-        }
-        source_module += import_stmt.module_path[i];
+  auto const found = [](std::string_view module_, std::string_view name_) {
+    return Resolution{.found = true, .module = std::string{module_}, .item_name = std::string{name_}, .error = {}};
+  };
+  auto const miss = [](std::string message_) {
+    return Resolution{.found = false, .module = {}, .item_name = {}, .error = std::move(message_)};
+  };
+
+  // Case 1: Single-segment name (e.g., "Point", "Vec<T>", "println")
+  if (last_dot == std::string_view::npos) {
+    // Try local module first
+    if (module_names.get(key_.module).find(path, key_.kind) != nullptr) {
+      return found(key_.module, path);
+    }
+
+    // Try imports: a single probe, the binding already knows what the source module exports
+    if (auto const* binding = import_bindings.get(key_.module).find(path)) {
+      if (is_type ? binding->type : binding->func) {
+        return found(binding->source_module, binding->item_name);
       }
+      if (is_type ? binding->type_not_pub : binding->func_not_pub) {
+        auto const& source_module = binding->source_module;
+        auto const& item_name = binding->item_name;
+        return miss(
+            is_type ? std::format("cannot import '{}' from module '{}' - not marked pub", item_name, source_module)
+                    : std::format(
+                          "cannot import function '{}' from module '{}' - not marked pub", item_name, source_module
+                      )
+        );
+      }
+    }
+  }
+  // Case 2: Multi-segment name (e.g., "Std.Collections.Vec", "Std.IO.println")
+  else {
+    auto const module_path = path.substr(0, last_dot);
+    auto const name = path.substr(last_dot + 1);
 
-      // Add each imported item to the map
-      for (auto const& item: import_stmt.items) {
-        std::string const local_name = item.alias.value_or(item.name);
-        import_map[local_name] = {source_module, item.name};
+    if (auto const* defined = module_names.get(module_path).find(name, key_.kind)) {
+      if (module_path != key_.module && !defined->is_pub) {
+        auto const noun = is_type ? "type" : "function";
+        return miss(std::format("cannot access {} '{}' from module '{}' - not marked pub", noun, name, module_path));
       }
+      return found(module_path, name);
     }
   }
+
+  // Not found
+  auto const first_segment = path.substr(0, path.find('.'));
+  auto const noun = is_type ? "type" : "function";
+  return miss(std::format("{} '{}' not found in current module or imports", noun, first_segment));
 }
 
-void Semantic_Context::Impl::build_name_indices() {
-  for (auto const& [module_path, module]: modules) {
-    for (auto const& item: module.items) {
-      auto const name_opt = get_item_name(item);
-      if (!name_opt.has_value()) {
-        continue;  // Skip items without names (e.g., impl blocks)
-      }
+Semantic_Context::Impl::Module_Index const* Semantic_Context::Impl::find_index(std::string_view module_path_) const {
+  // Unknown modules get no slot: a lookup of a typo shouldn't be remembered
+  return find_module(module_path_) == nullptr ? nullptr : &module_indices.get(module_path_);
+}
 
-      auto const& name = *name_opt;
-      auto const key = std::make_pair(module_path, name);
-
-      // Categorize by item type
-      bool const is_type_def = std::visit(
-          [](auto const& stmt_) -> bool {
-            using T = std::decay_t<decltype(stmt_)>;
-            return std::same_as<T, std::shared_ptr<ast::Struct_Def>> ||
-                   std::same_as<T, std::shared_ptr<ast::Enum_Def>> ||
-                   std::same_as<T, std::shared_ptr<ast::Trait_Def>> ||
-                   std::same_as<T, std::shared_ptr<ast::Type_Alias>>;
-          },
-          item.item
-      );
+ast::Item const*
+Semantic_Context::Impl::find_item(std::string_view module_path_, std::string_view name_, Name_Kind kind_) const {
+  auto const* index = find_index(module_path_);
+  if (index == nullptr) {
+    return nullptr;
+  }
+  auto const* item = (kind_ == Name_Kind::Type ? index->types : index->funcs).find(name_);
+  return item == nullptr ? nullptr : *item;
+}
+
+template <typename Segment>
+std::optional<std::pair<std::string, ast::Item const*>> Semantic_Context::Impl::resolve_name(
+    std::string const& current_module_,
+    std::vector<Segment> const& segments_,
+    Name_Kind kind_,
+    Source_Range span_,
+    Diagnostic_Sink* sink_
+) const {
+  if (segments_.empty()) {
+    return std::nullopt;  // Invalid name
+  }
 
-      bool const is_func_def = std::holds_alternative<std::shared_ptr<ast::Func_Def>>(item.item);
+  // Path: "Std.Collections.Vec" for Std.Collections.Vec<T>
+  // One reused key per thread, so that resolving a memoized name doesn't allocate
+  thread_local Resolution_Key key;
+  key.module = current_module_;
+  key.kind = kind_;
+  key.path.clear();
+  for (size_t i = 0; i < segments_.size(); ++i) {
+    if (i > 0) {
+      key.path += '.';
+    }
+    key.path += segments_[i].value;
+  }
 
-      if (is_type_def) {
-        type_index[key] = &item;
-      }
-      if (is_func_def) {
-        func_index[key] = &item;
-      }
+  bool computed = false;
+  auto const& resolution = resolutions.get(key, computed);
+  if (!resolution.found) {
+    // The manager hears of a miss when it is computed: once, until something it was computed from changes
+    // A sink hears of every use, keyed so that merging the sinks keeps one report per module
+    if (sink_ != nullptr) {
+      sink_->add_error(
+          span_,
+          resolution.error,
+          std::format("{}\n{}\n{}", key.module, kind_ == Name_Kind::Type ? "type" : "function", key.path)
+      );
+    } else if (computed) {
+      diagnostics->add_error(span_, resolution.error);
     }
+    return std::nullopt;
+  }
+  return std::make_pair(resolution.module, find_item(resolution.module, resolution.item_name, kind_));
+}
+
+std::optional<std::string_view> Semantic_Context::Impl::impl_self_type_name(ast::Type_Name const& type_name_) {
+  // For simple impl like "impl Point" this is "Point"
+  // For generic impl like "impl<T> Array<T>" the type arguments are dropped: "Array"
+  // For a qualified path like "impl Geometry.Point" it is the last segment: "Point"
+  auto const* path_type = std::get_if<ast::Path_Type>(&static_cast<ast::Type_Name::Base_Type const&>(type_name_));
+  if (path_type == nullptr || path_type->segments.empty()) {
+    return std::nullopt;
   }
+  return std::string_view(path_type->segments.back().value);
 }
 
 bool Semantic_Context::Impl::item_matches_name(ast::Item const& item_, std::string_view name_) {
@@ -577,9 +1187,9 @@ bool Semantic_Context::Impl::item_matches_name(ast::Item const& item_, std::stri
   return item_name.has_value() && item_name.value() == name_;
 }
 
-std::optional<std::string> Semantic_Context::Impl::get_item_name(ast::Item const& item_) {
+std::optional<std::string_view> Semantic_Context::Impl::get_item_name(ast::Item const& item_) {
   return std::visit(
-      [](auto const& stmt_) -> std::optional<std::string> {
+      [](auto const& stmt_) -> std::optional<std::string_view> {
         using T = std::decay_t<decltype(stmt_)>;
         if constexpr (std::same_as<T, std::shared_ptr<ast::Func_Def>>) {
           return stmt_->declaration.name;
@@ -2,21 +2,43 @@
 
 #include "../parser/ast.hpp"
 
+#include <cstdint>
 #include <filesystem>
 #include <memory>
 #include <optional>
+#include <span>
 #include <string>
 #include <string_view>
 #include <vector>
 
 namespace life_lang {
+class Cancellation_Token;
 class Diagnostic_Manager;
+class Diagnostic_Sink;
 }  // namespace life_lang
 
 namespace life_lang::semantic {
 
+// Outcome of Semantic_Context::load_modules
+enum class Load_Status : std::uint8_t {
+  Ok,         // All modules loaded and indexed
+  Failed,     // Parse error, duplicate definition or circular import (diagnostics reported)
+  Cancelled,  // Cancellation token fired; the load is undone (see load_modules)
+};
+
 // Semantic analysis context - manages loaded modules and provides name resolution
 // Uses pimpl idiom to hide implementation details.
+//
+// Loading only stores the parsed modules (and checks the import graph); module indices, import
+// bindings and resolutions are memoized queries (see query_engine.hpp), computed on first use and
+// revalidated after an update. An edit that leaves a module's defined names alone keeps every
+// resolution that only looked at the names.
+//
+// Thread safety: loading (load_*, update, set_*) must not overlap anything else. Between loads any
+// number of threads may call the const queries at once, provided resolve_* report through the
+// Diagnostic_Sink overloads (one sink per thread, merged with Diagnostic_Manager::merge). A result
+// that is already current is read under a shared lock; a stale one is revalidated or computed by the
+// first thread to ask for it, while different results are brought up to date in parallel.
 class Semantic_Context {
 public:
   // Takes a reference to Diagnostic_Manager for error reporting
@@ -29,33 +51,92 @@ public:
   Semantic_Context& operator=(Semantic_Context&&) noexcept;
   ~Semantic_Context();
 
+  // Cache the src/ directory listing in manifest_path_ so later loads of an unchanged tree skip
+  // the directory walk (see Discovery_Options). An empty path disables the manifest.
+  void set_module_manifest(std::filesystem::path manifest_path_);
+
+  // Keep parsed files in directory_ (created on first store) keyed by a hash of their bytes, so
+  // later loads only parse files whose text changed. The directory may be shared by concurrent
+  // builds; it is trimmed to max_bytes_, least recently used first, after each load.
+  // An empty path disables the cache.
+  void set_parse_cache(std::filesystem::path directory_, std::uintmax_t max_bytes_ = std::uintmax_t{256} << 20);
+
+  // Load dependency modules from the interface files in directory_ (see module_interface.hpp,
+  // written by `lifec --emit-interfaces`) instead of parsing their sources. Only modules that
+  // load_reachable_modules reaches through imports qualify, never the entry modules, and only
+  // while their .life files still hash to what the interface was written for; any other module
+  // is parsed as usual. An empty path disables interfaces.
+  void set_interface_dir(std::filesystem::path directory_);
+
   // Load all modules from src/ directory
   // src_root_: Filesystem path to source directory
   // Returns false if any module fails to parse
   bool load_modules(std::filesystem::path const& src_root_);
 
+  // Cancellable variant: cancel_ is polled between modules, files and inside the parser
+  // Parsed modules are staged and only committed to the context once loading finishes. A Cancelled
+  // load (or update) also drops the files it registered and the diagnostics it reported, and keeps
+  // the previous src/ root, so the context and its Diagnostic_Manager are as they were. Only outside
+  // state remains: parse cache entries stored for files parsed before the cancellation (and the
+  // cache trimmed), and a module manifest written by the directory walk.
+  [[nodiscard]] Load_Status load_modules(std::filesystem::path const& src_root_, Cancellation_Token const& cancel_);
+
+  // Load only the modules reachable from entry_modules_ (dot-separated paths like "App.Server")
+  // through import statements. Modules are located directly by path instead of walking src/,
+  // each wave of newly imported modules is parsed in parallel, and unreachable modules are never
+  // read. An entry module that doesn't exist fails the load; an unknown imported module is left
+  // for name resolution to report, as with load_modules.
+  bool load_reachable_modules(std::filesystem::path const& src_root_, std::vector<std::string> const& entry_modules_);
+  [[nodiscard]] Load_Status load_reachable_modules(
+      std::filesystem::path const& src_root_,
+      std::vector<std::string> const& entry_modules_,
+      Cancellation_Token const& cancel_
+  );
+
+  // Bring the context up to date after the files in changed_paths_ were edited, added or deleted,
+  // without a full reload. Only the modules in the directories of changed .life files are touched:
+  // their changed files are read and parsed again (the others keep their items), and whatever was
+  // derived from them is revalidated when next queried. A .life file in a new directory under src/
+  // adds a module; a module whose last file was deleted stays known with no items.
+  // Requires an earlier load_modules or load_reachable_modules (whose src/ root it reuses). After
+  // a parse error or cancellation every module is left as it was.
+  bool update(std::vector<std::filesystem::path> const& changed_paths_);
+  [[nodiscard]] Load_Status
+  update(std::vector<std::filesystem::path> const& changed_paths_, Cancellation_Token const& cancel_);
+
   // Get a loaded module by dot-separated module path (e.g., "Std.Collections")
-  [[nodiscard]] ast::Module const* get_module(std::string const& module_path_) const;
+  [[nodiscard]] ast::Module const* get_module(std::string_view module_path_) const;
 
   // Get all loaded module paths (dot-separated strings like "Std.Collections")
   [[nodiscard]] std::vector<std::string> module_paths() const;
 
+  // Loaded module paths ordered so that every module comes after the modules it imports
+  // (for scheduling later passes); computed by a successful load_modules
+  [[nodiscard]] std::vector<std::string> dependency_order() const;
+
   // Find a type definition (struct/enum/trait/type alias) in a specific module
   // Returns nullptr if not found or not a type definition
   // Only searches module-level items, not nested definitions
-  [[nodiscard]] ast::Item const* find_type_def(std::string const& module_path_, std::string_view type_name_) const;
+  [[nodiscard]] ast::Item const* find_type_def(std::string_view module_path_, std::string_view type_name_) const;
 
   // Find a function definition in a specific module
   // Returns nullptr if not found or not a function
   // Only searches module-level items, not methods in impl blocks
-  [[nodiscard]] ast::Item const* find_func_def(std::string const& module_path_, std::string_view func_name_) const;
+  [[nodiscard]] ast::Item const* find_func_def(std::string_view module_path_, std::string_view func_name_) const;
 
   // Find a method definition within impl blocks for a specific type
   // type_name_: Simple type name (e.g., "Point") - not fully qualified
   // method_name_: Method name to find (e.g., "distance")
+  // Searches inherent impls and trait impls (generic impls by their base name, e.g. "List" for "impl<T> List<T>");
+  // an inherent method shadows a trait method of the same name
   // Returns nullptr if not found
   [[nodiscard]] ast::Func_Def const*
-  find_method_def(std::string const& module_path_, std::string_view type_name_, std::string_view method_name_) const;
+  find_method_def(std::string_view module_path_, std::string_view type_name_, std::string_view method_name_) const;
+
+  // All methods implemented for a type in a module: inherent impls first, then trait impls, each in source order
+  // Empty if the module or type has no impls
+  [[nodiscard]] std::span<ast::Func_Def const* const>
+  type_methods(std::string_view module_path_, std::string_view type_name_) const;
 
   // Resolve a type name within a module's context
   // current_module_: Dot-separated module path (e.g., "Geometry")
@@ -65,15 +146,26 @@ public:
   //   - "I32" -> built-in type (no module path, nullptr)
   //   - "Point" -> local definition or imported
   //   - "Std.Collections.Vec" -> fully qualified import
+  // Results are memoized per (module, path), misses included: an unresolved name is reported once per module,
+  // and again only after an update changes what its resolution was computed from
+  // Reports to the context's Diagnostic_Manager, so not for concurrent use (see the sink_ overload)
   [[nodiscard]] std::optional<std::pair<std::string, ast::Item const*>>
   resolve_type_name(std::string const& current_module_, ast::Type_Name const& name_) const;
 
+  // Thread-safe variant reporting into sink_: every use of an unresolved name is reported, keyed by
+  // module and name, so that merging the sinks leaves one report per module as above (the first in source order)
+  [[nodiscard]] std::optional<std::pair<std::string, ast::Item const*>>
+  resolve_type_name(std::string const& current_module_, ast::Type_Name const& name_, Diagnostic_Sink& sink_) const;
+
   // Resolve a variable/function name within a module's context
   // current_module_: Dot-separated module path (e.g., "Geometry")
   // name_: Variable/function name from AST to resolve
   // Returns (module_path, Item*) pair if found, where module_path is dot-separated
+  // Memoized like resolve_type_name
   [[nodiscard]] std::optional<std::pair<std::string, ast::Item const*>>
   resolve_var_name(std::string const& current_module_, ast::Var_Name const& name_) const;
+  [[nodiscard]] std::optional<std::pair<std::string, ast::Item const*>>
+  resolve_var_name(std::string const& current_module_, ast::Var_Name const& name_, Diagnostic_Sink& sink_) const;
 
 private:
   struct Impl;
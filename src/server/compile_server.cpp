@@ -0,0 +1,358 @@
+#include "compile_server.hpp"
+
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <iterator>
+#include <map>
+#include <optional>
+#include <set>
+#include <sstream>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#include "../cancellation.hpp"
+#include "../diagnostics.hpp"
+#include "../parser/parser.hpp"
+#include "../parser/sexp.hpp"
+#include "../semantic/module_loader.hpp"
+#include "../semantic/semantic_context.hpp"
+
+namespace life_lang::server {
+
+namespace {
+
+namespace fs = std::filesystem;
+
+constexpr int k_accept_poll_ms = 100;
+constexpr int k_client_timeout_seconds = 5;  // A client that stops talking mid-request is dropped
+
+// What a file looked like at the last refresh; a change of either means it was edited
+struct File_Stamp {
+  fs::file_time_type mtime;
+  std::uintmax_t size{};
+
+  bool operator==(File_Stamp const&) const = default;
+};
+
+std::optional<File_Stamp> stamp_of(fs::path const& path_) {
+  std::error_code ec;
+  auto const mtime = fs::last_write_time(path_, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  auto const size = fs::file_size(path_, ec);
+  if (ec) {
+    return std::nullopt;
+  }
+  return File_Stamp{.mtime = mtime, .size = size};
+}
+
+fs::path canonical_or_self(fs::path const& path_) {
+  std::error_code ec;
+  auto canonical = fs::weakly_canonical(path_, ec);
+  return ec ? path_ : canonical;
+}
+
+Reply rejected(std::string message_) {
+  return Reply{.status = Reply_Status::Rejected, .output = std::move(message_) + "\n"};
+}
+
+bool fill_address(fs::path const& path_, sockaddr_un& address_) {
+  address_ = {};
+  address_.sun_family = AF_UNIX;
+  auto const& native = path_.native();
+  if (native.empty() || native.size() >= sizeof(address_.sun_path)) {
+    return false;
+  }
+  std::memcpy(static_cast<char*>(address_.sun_path), native.c_str(), native.size() + 1);
+  return true;
+}
+
+}  // namespace
+
+struct Compile_Server::Impl {
+  fs::path src_root;
+  fs::path socket_path;
+  int listen_fd{-1};
+  bool shutdown{false};
+
+  Diagnostic_Manager diagnostics;
+  semantic::Semantic_Context context{diagnostics};
+
+  // Tree state as of the last refresh
+  std::map<fs::path, File_Stamp> stamps;
+  std::set<fs::path> failed_paths;  // Changed files whose update failed; handed to the next update again
+  bool loaded{false};               // A full load has succeeded
+  bool check_ok{false};
+  std::string check_output;  // Diagnostics printed by the last refresh
+
+  // "<request>" in the context's registry, holding the name being resolved so that a miss is printed
+  // against it; registered once and refilled by every resolve
+  File_Id request_file{k_invalid_file_id};
+
+  Impl(fs::path src_root_, fs::path socket_path_)
+      : src_root(canonical_or_self(src_root_)), socket_path(std::move(socket_path_)) {}
+
+  void refresh();
+  [[nodiscard]] Reply check(Request const& request_);
+  [[nodiscard]] static Reply parse(Request const& request_);
+  [[nodiscard]] Reply resolve(Request const& request_);
+  [[nodiscard]] Reply handle(Request const& request_);
+  void serve_connection(int fd_);
+};
+
+// Bring the context up to date with the tree, loading it in full the first time
+void Compile_Server::Impl::refresh() {
+  std::map<fs::path, File_Stamp> current;
+  for (auto const& module: semantic::Module_Loader::discover_modules(src_root)) {
+    for (auto const& file: module.files) {
+      if (auto const stamp = stamp_of(file)) {
+        current.emplace(file, *stamp);
+      }
+    }
+  }
+
+  bool ok = true;
+  if (!loaded) {
+    diagnostics.clear_all();
+    ok = context.load_modules(src_root);
+    loaded = ok;
+  } else {
+    std::vector<fs::path> changed(failed_paths.begin(), failed_paths.end());
+    for (auto const& [path, stamp]: current) {
+      auto const previous = stamps.find(path);
+      if ((previous == stamps.end() || previous->second != stamp) && !failed_paths.contains(path)) {
+        changed.push_back(path);
+      }
+    }
+    for (auto const& [path, stamp]: stamps) {
+      if (!current.contains(path) && !failed_paths.contains(path)) {
+        changed.push_back(path);  // Deleted or renamed away
+      }
+    }
+    if (changed.empty()) {
+      return;  // Nothing edited: the last answer stands
+    }
+    ok = context.update(changed);
+    failed_paths.clear();
+    if (!ok) {
+      failed_paths.insert(changed.begin(), changed.end());
+    }
+  }
+
+  stamps = std::move(current);
+  check_ok = ok && !diagnostics.has_errors();
+  std::ostringstream out;
+  diagnostics.print(out);
+  check_output = std::move(out).str();
+  diagnostics.clear_diagnostics();  // Each refresh reports only what it found
+}
+
+Reply Compile_Server::Impl::check(Request const& request_) {
+  if (request_.args.size() != 1) {
+    return rejected("usage: check <src_root>");
+  }
+  if (canonical_or_self(request_.args.front()) != src_root) {
+    return rejected(std::format("this server serves {}", src_root.string()));
+  }
+  refresh();
+  return Reply{.status = check_ok ? Reply_Status::Ok : Reply_Status::Failed, .output = check_output};
+}
+
+// One file on its own, as `lifec -` would print it; nothing is kept
+Reply Compile_Server::Impl::parse(Request const& request_) {
+  if (request_.args.size() != 1) {
+    return rejected("usage: parse <file>");
+  }
+  std::ifstream file(request_.args.front());
+  if (!file) {
+    return rejected(std::format("cannot read {}", request_.args.front()));
+  }
+  std::string source(std::istreambuf_iterator<char>(file), {});
+  Source_File_Registry registry;
+  File_Id const file_id = registry.register_file(request_.args.front(), std::move(source));
+  Diagnostic_Engine file_diagnostics{registry, file_id};
+  parser::Parser parser{file_diagnostics};
+  if (auto const module = parser.parse_module()) {
+    return Reply{.status = Reply_Status::Ok, .output = ast::to_sexp_string(*module, 2) + "\n"};
+  }
+  std::ostringstream out;
+  file_diagnostics.print(out);
+  return Reply{.status = Reply_Status::Failed, .output = std::move(out).str()};
+}
+
+// Where a type or function name, written in module args[1], is defined: "<module> <file>:<line>:<column>"
+Reply Compile_Server::Impl::resolve(Request const& request_) {
+  if (request_.args.size() != 3) {
+    return rejected("usage: resolve <src_root> <module> <name>");
+  }
+  if (canonical_or_self(request_.args[0]) != src_root) {
+    return rejected(std::format("this server serves {}", src_root.string()));
+  }
+  refresh();
+  if (!loaded) {
+    return Reply{.status = Reply_Status::Failed, .output = check_output};
+  }
+
+  auto const& module_path = request_.args[1];
+  auto const& name = request_.args[2];
+  if (request_file == k_invalid_file_id) {
+    request_file = diagnostics.register_file("<request>", name);
+  } else {
+    diagnostics.registry().set_source(request_file, name);
+  }
+
+  // Sinks hear of every miss, not only the first of a memoized one, so a repeated request gets the same reply
+  std::vector<Diagnostic_Sink> misses(1);
+  std::optional<std::pair<std::string, ast::Item const*>> resolved;
+  {
+    Diagnostic_Engine name_diagnostics{diagnostics.registry(), request_file};
+    parser::Parser parser{name_diagnostics};
+    if (auto const type_name = parser.parse_type_name(); type_name && parser.all_input_consumed()) {
+      resolved = context.resolve_type_name(module_path, *type_name, misses.front());
+    }
+  }
+  if (!resolved) {
+    Diagnostic_Engine name_diagnostics{diagnostics.registry(), request_file};
+    parser::Parser parser{name_diagnostics};
+    if (auto const var_name = parser.parse_qualified_variable_name(); var_name && parser.all_input_consumed()) {
+      misses.front() = Diagnostic_Sink{};  // Only the last attempt's misses are worth reporting
+      resolved = context.resolve_var_name(module_path, *var_name, misses.front());
+    }
+  }
+  diagnostics.merge(misses);
+
+  std::ostringstream out;
+  diagnostics.print(out);
+  diagnostics.clear_diagnostics();
+  if (!resolved) {
+    auto output = std::move(out).str();
+    if (output.empty()) {
+      output = std::format("cannot resolve '{}' in module '{}'\n", name, module_path);
+    }
+    return Reply{.status = Reply_Status::Failed, .output = std::move(output)};
+  }
+  if (resolved->second == nullptr) {
+    return Reply{.status = Reply_Status::Ok, .output = "<builtin>\n"};
+  }
+  auto const& span = resolved->second->span;
+  return Reply{
+      .status = Reply_Status::Ok,
+      .output = std::format(
+          "{} {}:{}:{}\n",
+          resolved->first,
+          diagnostics.registry().get_path(span.file),
+          span.start.line,
+          span.start.column
+      )
+  };
+}
+
+Reply Compile_Server::Impl::handle(Request const& request_) {
+  if (request_.command == "check") {
+    return check(request_);
+  }
+  if (request_.command == "parse") {
+    return parse(request_);
+  }
+  if (request_.command == "resolve") {
+    return resolve(request_);
+  }
+  if (request_.command == "ping") {
+    return Reply{};
+  }
+  if (request_.command == "shutdown") {
+    shutdown = true;
+    return Reply{};
+  }
+  return rejected(std::format("unknown command '{}'", request_.command));
+}
+
+void Compile_Server::Impl::serve_connection(int fd_) {
+  timeval timeout{};
+  timeout.tv_sec = k_client_timeout_seconds;
+  ::setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  while (!shutdown) {
+    auto const payload = read_frame(fd_);
+    if (!payload) {
+      return;  // Client done (or gone)
+    }
+    auto const request = decode_request(*payload);
+    Reply const reply = request ? handle(*request) : rejected("malformed request");
+    if (!write_frame(fd_, encode_reply(reply))) {
+      return;
+    }
+  }
+}
+
+Compile_Server::Compile_Server(fs::path src_root_, fs::path socket_path_)
+    : m_impl(std::make_unique<Impl>(std::move(src_root_), std::move(socket_path_))) {}
+
+Compile_Server::~Compile_Server() {
+  if (m_impl->listen_fd >= 0) {
+    ::close(m_impl->listen_fd);
+    std::error_code ec;
+    fs::remove(m_impl->socket_path, ec);
+  }
+}
+
+bool Compile_Server::listen() {
+  sockaddr_un address{};
+  if (!fill_address(m_impl->socket_path, address)) {
+    return false;
+  }
+  // A socket file nobody answers on is left over from a server that died
+  if (fs::exists(fs::symlink_status(m_impl->socket_path))) {
+    if (send_request(m_impl->socket_path, Request{.command = "ping", .args = {}})) {
+      return false;
+    }
+    std::error_code ec;
+    fs::remove(m_impl->socket_path, ec);
+  }
+
+  int const fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+  if (fd < 0) {
+    return false;
+  }
+  if (::bind(fd, reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0 ||  // NOLINT
+      ::listen(fd, SOMAXCONN) != 0) {
+    ::close(fd);
+    return false;
+  }
+  m_impl->listen_fd = fd;
+  return true;
+}
+
+void Compile_Server::serve(Cancellation_Token const& cancel_) {
+  while (!m_impl->shutdown && !cancel_.is_cancelled()) {
+    pollfd waiting{.fd = m_impl->listen_fd, .events = POLLIN, .revents = 0};
+    int const ready = ::poll(&waiting, 1, k_accept_poll_ms);
+    if (ready < 0 && errno != EINTR) {
+      return;
+    }
+    if (ready <= 0) {
+      continue;
+    }
+    int const client = ::accept4(m_impl->listen_fd, nullptr, nullptr, SOCK_CLOEXEC);
+    if (client < 0) {
+      continue;
+    }
+    m_impl->serve_connection(client);
+    ::close(client);
+  }
+}
+
+Reply Compile_Server::handle(Request const& request_) { return m_impl->handle(request_); }
+
+bool Compile_Server::shutdown_requested() const { return m_impl->shutdown; }
+
+}  // namespace life_lang::server
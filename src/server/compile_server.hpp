@@ -0,0 +1,62 @@
+#pragma once
+
+#include <filesystem>
+#include <memory>
+
+#include "protocol.hpp"
+
+namespace life_lang {
+class Cancellation_Token;
+}
+
+namespace life_lang::server {
+
+// ============================================================================
+// Compile_Server - one warm Semantic_Context serving many lifec invocations
+// ============================================================================
+// Keeps the diagnostics, source registry, parsed modules and indices of one
+// src/ tree resident between requests instead of discovering and parsing the
+// tree again in every lifec process. Before each request the tree is checked
+// for edits (each .life file's mtime and size against the last request): the
+// first request loads every module, later ones hand only the added, changed
+// and deleted files to Semantic_Context::update.
+//
+// Requests are served one at a time, on the thread that runs serve(); handle()
+// is the same work without the socket (lifec uses it when no server runs).
+//
+// Example:
+//   lifec --server src/ /tmp/lifec.sock &
+//   LIFEC_SERVER_SOCKET=/tmp/lifec.sock lifec --check src/  # Answered by the server
+
+class Compile_Server {
+public:
+  Compile_Server(std::filesystem::path src_root_, std::filesystem::path socket_path_);
+
+  // Non-copyable, non-movable (owns the listening socket and the context)
+  Compile_Server(Compile_Server const&) = delete;
+  Compile_Server& operator=(Compile_Server const&) = delete;
+  Compile_Server(Compile_Server&&) = delete;
+  Compile_Server& operator=(Compile_Server&&) = delete;
+
+  // Closes the socket and removes its file
+  ~Compile_Server();
+
+  // Bind and listen on the socket path, replacing a stale socket file left by a server that is
+  // gone; false if the path is unusable or another server is listening there
+  [[nodiscard]] bool listen();
+
+  // Accept connections and answer their requests until a shutdown request arrives or cancel_
+  // fires (polled between connections at least every 100 ms). Requires listen().
+  void serve(Cancellation_Token const& cancel_);
+
+  // Answer one request against the warm state
+  [[nodiscard]] Reply handle(Request const& request_);
+
+  [[nodiscard]] bool shutdown_requested() const;
+
+private:
+  struct Impl;
+  std::unique_ptr<Impl> m_impl;
+};
+
+}  // namespace life_lang::server
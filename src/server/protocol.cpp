@@ -0,0 +1,169 @@
+#include "protocol.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+namespace life_lang::server {
+
+namespace {
+
+constexpr std::size_t k_frame_header_bytes = 4;
+constexpr std::string_view k_status_chars = "012";
+
+bool write_all(int fd_, std::string_view bytes_) {
+  while (!bytes_.empty()) {
+    auto const written = ::send(fd_, bytes_.data(), bytes_.size(), MSG_NOSIGNAL);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+    bytes_.remove_prefix(static_cast<std::size_t>(written));
+  }
+  return true;
+}
+
+bool read_all(int fd_, char* data_, std::size_t size_) {
+  while (size_ > 0) {
+    auto const got = ::recv(fd_, data_, size_, 0);
+    if (got < 0 && errno == EINTR) {
+      continue;
+    }
+    if (got <= 0) {
+      return false;
+    }
+    data_ += got;  // NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    size_ -= static_cast<std::size_t>(got);
+  }
+  return true;
+}
+
+// Closes the descriptor on scope exit
+class Socket {
+public:
+  explicit Socket(int fd_) : m_fd(fd_) {}
+  Socket(Socket const&) = delete;
+  Socket& operator=(Socket const&) = delete;
+  Socket(Socket&&) = delete;
+  Socket& operator=(Socket&&) = delete;
+  ~Socket() {
+    if (m_fd >= 0) {
+      ::close(m_fd);
+    }
+  }
+  [[nodiscard]] int fd() const { return m_fd; }
+
+private:
+  int m_fd;
+};
+
+}  // namespace
+
+std::string encode_request(Request const& request_) {
+  std::string payload = request_.command;
+  payload += '\0';
+  for (auto const& arg: request_.args) {
+    payload += arg;
+    payload += '\0';
+  }
+  return payload;
+}
+
+std::optional<Request> decode_request(std::string_view payload_) {
+  if (payload_.empty() || payload_.back() != '\0') {
+    return std::nullopt;
+  }
+  Request request;
+  bool first = true;
+  while (!payload_.empty()) {
+    auto const end = payload_.find('\0');
+    if (first) {
+      request.command = payload_.substr(0, end);
+      first = false;
+    } else {
+      request.args.emplace_back(payload_.substr(0, end));
+    }
+    payload_.remove_prefix(end + 1);
+  }
+  return request;
+}
+
+std::string encode_reply(Reply const& reply_) {
+  std::string payload;
+  payload.reserve(1 + reply_.output.size());
+  payload += k_status_chars[static_cast<std::size_t>(reply_.status)];
+  payload += reply_.output;
+  return payload;
+}
+
+std::optional<Reply> decode_reply(std::string_view payload_) {
+  if (payload_.empty()) {
+    return std::nullopt;
+  }
+  auto const status = k_status_chars.find(payload_.front());
+  if (status == std::string_view::npos) {
+    return std::nullopt;
+  }
+  return Reply{.status = static_cast<Reply_Status>(status), .output = std::string{payload_.substr(1)}};
+}
+
+bool write_frame(int fd_, std::string_view payload_) {
+  auto const size = static_cast<std::uint32_t>(payload_.size());
+  std::array<char, k_frame_header_bytes> header{};
+  for (std::size_t i = 0; i < header.size(); ++i) {
+    header[i] = static_cast<char>((size >> (8 * i)) & 0xFFU);
+  }
+  return payload_.size() <= k_max_frame_bytes && write_all(fd_, {header.data(), header.size()}) &&
+         write_all(fd_, payload_);
+}
+
+std::optional<std::string> read_frame(int fd_) {
+  std::array<unsigned char, k_frame_header_bytes> header{};
+  if (!read_all(fd_, reinterpret_cast<char*>(header.data()), header.size())) {  // NOLINT(*-reinterpret-cast)
+    return std::nullopt;
+  }
+  std::size_t size = 0;
+  for (std::size_t i = 0; i < header.size(); ++i) {
+    size |= std::size_t{header[i]} << (8 * i);
+  }
+  if (size > k_max_frame_bytes) {
+    return std::nullopt;
+  }
+  std::string payload(size, '\0');
+  if (!read_all(fd_, payload.data(), size)) {
+    return std::nullopt;
+  }
+  return payload;
+}
+
+std::optional<Reply> send_request(std::filesystem::path const& socket_path_, Request const& request_) {
+  sockaddr_un address{};
+  address.sun_family = AF_UNIX;
+  auto const& path = socket_path_.native();
+  if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+    return std::nullopt;
+  }
+  std::memcpy(static_cast<char*>(address.sun_path), path.c_str(), path.size() + 1);
+
+  Socket const socket{::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0)};
+  if (socket.fd() < 0 ||
+      ::connect(socket.fd(), reinterpret_cast<sockaddr const*>(&address), sizeof(address)) != 0) {  // NOLINT
+    return std::nullopt;
+  }
+  if (!write_frame(socket.fd(), encode_request(request_))) {
+    return std::nullopt;
+  }
+  auto const payload = read_frame(socket.fd());
+  if (!payload) {
+    return std::nullopt;
+  }
+  return decode_reply(*payload);
+}
+
+}  // namespace life_lang::server
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace life_lang::server {
+
+// ============================================================================
+// Compile server protocol - length-prefixed frames over a Unix domain socket
+// ============================================================================
+// Every message is one frame: a u32 little-endian payload length, then the
+// payload. A client sends a request frame and reads one reply frame; it may
+// send further requests on the same connection.
+//
+//   Request payload  command and arguments, each terminated by '\0'
+//                    ("check\0/abs/src\0")
+//   Reply payload    one status byte ('0' ok, '1' failed, '2' rejected), then
+//                    the text lifec would print (diagnostics, S-expression, ...)
+//
+// Commands:
+//   check <src_root>                   diagnostics of the whole tree
+//   parse <file>                       S-expression of one file
+//   resolve <src_root> <module> <name> where a type or function name resolves to
+//   ping                               is a server listening (empty reply)
+//   shutdown                           stop the server after replying
+//
+// Example:
+//   auto const reply = send_request(socket, Request{.command = "check", .args = {src_root}});
+//   if (!reply) { ...no server running: do the work in process... }
+
+inline constexpr std::size_t k_max_frame_bytes = std::size_t{256} << 20;
+
+struct Request {
+  std::string command;
+  std::vector<std::string> args;
+};
+
+enum class Reply_Status : std::uint8_t {
+  Ok,        // Request done, nothing to report as an error
+  Failed,    // Request done, with errors (as a failing lifec run)
+  Rejected,  // Not served here (unknown command, other src root, bad arguments)
+};
+
+struct Reply {
+  Reply_Status status{Reply_Status::Ok};
+  std::string output;
+};
+
+[[nodiscard]] std::string encode_request(Request const& request_);
+[[nodiscard]] std::optional<Request> decode_request(std::string_view payload_);
+[[nodiscard]] std::string encode_reply(Reply const& reply_);
+[[nodiscard]] std::optional<Reply> decode_reply(std::string_view payload_);
+
+// Write one frame; false if the peer is gone
+[[nodiscard]] bool write_frame(int fd_, std::string_view payload_);
+
+// Read one frame; std::nullopt at end of stream, on error, or if the frame exceeds k_max_frame_bytes
+[[nodiscard]] std::optional<std::string> read_frame(int fd_);
+
+// Connect to the server at socket_path_, send request_ and wait for the reply;
+// std::nullopt if no server is listening there or the connection breaks
+[[nodiscard]] std::optional<Reply> send_request(std::filesystem::path const& socket_path_, Request const& request_);
+
+}  // namespace life_lang::server
@@ -0,0 +1,276 @@
+#include "source_watcher.hpp"
+
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <map>
+#include <set>
+#include <string>
+#include <system_error>
+#include <unordered_map>
+#include <utility>
+
+#include "../cancellation.hpp"
+#include "../semantic/module_loader.hpp"
+
+namespace life_lang::server {
+
+namespace {
+
+namespace fs = std::filesystem;
+using Clock = std::chrono::steady_clock;
+
+constexpr int k_idle_poll_ms = 100;
+constexpr std::uint32_t k_watch_mask = IN_CLOSE_WRITE | IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO |
+                                       IN_DELETE_SELF | IN_ONLYDIR | IN_DONT_FOLLOW | IN_EXCL_UNLINK;
+
+bool is_source_file(fs::path const& path_) { return path_.extension() == ".life"; }
+
+// Whether path_ is directory_ or lies below it
+bool is_within(fs::path const& path_, fs::path const& directory_) {
+  auto const [dir_end, path_it] = std::ranges::mismatch(directory_, path_);
+  return dir_end == directory_.end();
+}
+
+}  // namespace
+
+struct Source_Watcher::Impl {
+  fs::path src_root;
+  int inotify_fd{-1};
+  std::unordered_map<int, fs::path> watches;  // Watch descriptor -> directory
+  std::set<fs::path> files;                   // Known .life files
+  std::map<fs::path, semantic::Module_Descriptor> modules;
+
+  std::set<fs::path> changed;  // The batch being collected
+
+  Impl() = default;
+  Impl(Impl const&) = delete;
+  Impl& operator=(Impl const&) = delete;
+  Impl(Impl&&) = delete;
+  Impl& operator=(Impl&&) = delete;
+  ~Impl() {
+    if (inotify_fd >= 0) {
+      ::close(inotify_fd);
+    }
+  }
+
+  void discover();
+  void watch_tree(fs::path const& directory_, bool report_files_);
+  void forget_tree(fs::path const& directory_);
+  [[nodiscard]] bool handle_event(inotify_event const& event_);
+  [[nodiscard]] bool drain_events(bool& relevant_);
+  void settle_batch();
+};
+
+// (Re)build the file set and module descriptors from a full walk
+void Source_Watcher::Impl::discover() {
+  files.clear();
+  modules.clear();
+  for (auto& module: semantic::Module_Loader::discover_modules(src_root)) {
+    files.insert(module.files.begin(), module.files.end());
+    auto directory = module.directory;
+    modules.emplace(std::move(directory), std::move(module));
+  }
+}
+
+// Watch directory_ and every directory below it (symlinks are not followed, as in the walk).
+// report_files_: the tree is new to us, so the .life files already in it count as changed.
+void Source_Watcher::Impl::watch_tree(fs::path const& directory_, bool report_files_) {
+  auto const add_watch = [this](fs::path const& dir_) {
+    int const wd = ::inotify_add_watch(inotify_fd, dir_.c_str(), k_watch_mask);
+    if (wd >= 0) {
+      watches[wd] = dir_;
+    }
+  };
+  add_watch(directory_);
+  std::error_code ec;
+  for (fs::recursive_directory_iterator it{directory_, ec}, end; !ec && it != end; it.increment(ec)) {
+    auto const& entry = *it;
+    if (entry.is_directory(ec) && !entry.is_symlink(ec)) {
+      add_watch(entry.path());
+    } else if (report_files_ && is_source_file(entry.path()) && entry.is_regular_file(ec)) {
+      changed.insert(entry.path());
+    }
+  }
+}
+
+// directory_ was deleted or moved away: report the files it held and stop watching it
+void Source_Watcher::Impl::forget_tree(fs::path const& directory_) {
+  for (auto it = files.lower_bound(directory_); it != files.end() && is_within(*it, directory_); ++it) {
+    changed.insert(*it);
+  }
+  std::erase_if(watches, [&](auto const& watch_) {
+    if (!is_within(watch_.second, directory_)) {
+      return false;
+    }
+    ::inotify_rm_watch(inotify_fd, watch_.first);  // Still watching a moved directory under its new name
+    return true;
+  });
+}
+
+// Returns whether the event was about the batch: a .life file or a directory that may hold some
+// (a file saved again counts, though it already is in the batch)
+bool Source_Watcher::Impl::handle_event(inotify_event const& event_) {
+  if ((event_.mask & IN_Q_OVERFLOW) != 0) {
+    // Events were lost: report everything that exists now or existed before
+    changed.insert(files.begin(), files.end());
+    watch_tree(src_root, false);  // Directories created meanwhile (known ones keep their watch)
+    discover();
+    changed.insert(files.begin(), files.end());
+    return true;
+  }
+  if ((event_.mask & IN_IGNORED) != 0) {
+    watches.erase(event_.wd);
+    return false;
+  }
+  auto const watch = watches.find(event_.wd);
+  if (watch == watches.end() || event_.len == 0) {
+    return false;  // Events about the watched directory itself are reported by its parent
+  }
+  auto const path = watch->second / static_cast<char const*>(event_.name);
+
+  if ((event_.mask & IN_ISDIR) != 0) {
+    if ((event_.mask & (IN_CREATE | IN_MOVED_TO)) != 0) {
+      watch_tree(path, true);
+      return true;
+    }
+    if ((event_.mask & (IN_DELETE | IN_MOVED_FROM)) != 0) {
+      forget_tree(path);
+      return true;
+    }
+    return false;
+  }
+  if (is_source_file(path)) {
+    changed.insert(path);
+    return true;
+  }
+  return false;
+}
+
+// Read every queued event; false if the descriptor failed. relevant_ is set if any event was
+// about the batch (see handle_event), and left alone otherwise.
+bool Source_Watcher::Impl::drain_events(bool& relevant_) {
+  alignas(inotify_event) std::array<char, 64 * 1024> buffer{};
+  while (true) {
+    auto const got = ::read(inotify_fd, buffer.data(), buffer.size());
+    if (got < 0) {
+      return errno == EAGAIN || errno == EINTR;
+    }
+    auto const size = static_cast<std::size_t>(got);
+    for (std::size_t offset = 0; offset < size;) {
+      // Each record is the fixed header followed by its padded name, keeping the next one aligned
+      auto const* event = reinterpret_cast<inotify_event const*>(buffer.data() + offset);  // NOLINT
+      if (handle_event(*event)) {
+        relevant_ = true;
+      }
+      offset += sizeof(inotify_event) + event->len;
+    }
+  }
+}
+
+// The batch is done: bring the file set and the descriptors of the touched directories up to date
+void Source_Watcher::Impl::settle_batch() {
+  std::set<fs::path> directories;
+  for (auto const& path: changed) {
+    std::error_code ec;
+    if (fs::is_regular_file(path, ec)) {
+      files.insert(path);
+    } else {
+      files.erase(path);
+    }
+    directories.insert(path.parent_path());
+  }
+  for (auto const& directory: directories) {
+    if (auto descriptor = semantic::Module_Loader::describe_directory(src_root, directory)) {
+      modules.insert_or_assign(directory, std::move(*descriptor));
+    } else {
+      modules.erase(directory);
+    }
+  }
+}
+
+Source_Watcher::Source_Watcher(std::unique_ptr<Impl> impl_) : m_impl(std::move(impl_)) {}
+Source_Watcher::Source_Watcher(Source_Watcher&&) noexcept = default;
+Source_Watcher& Source_Watcher::operator=(Source_Watcher&&) noexcept = default;
+Source_Watcher::~Source_Watcher() = default;
+
+std::optional<Source_Watcher> Source_Watcher::open(fs::path const& src_root_) {
+  std::error_code ec;
+  auto root = fs::canonical(src_root_, ec);
+  if (ec || !fs::is_directory(root, ec)) {
+    return std::nullopt;
+  }
+  auto impl = std::make_unique<Impl>();
+  impl->src_root = std::move(root);
+  impl->inotify_fd = ::inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+  if (impl->inotify_fd < 0) {
+    return std::nullopt;
+  }
+  // Watch first, then walk: a file saved in between shows up in both, never in neither
+  impl->watch_tree(impl->src_root, false);
+  impl->discover();
+  impl->changed.clear();
+  return Source_Watcher{std::move(impl)};
+}
+
+std::optional<std::vector<fs::path>>
+Source_Watcher::wait_for_changes(Cancellation_Token const& cancel_, std::chrono::milliseconds quiet_period_) {
+  auto& impl = *m_impl;
+  std::optional<Clock::time_point> first_change;
+  Clock::time_point last_change{};
+
+  while (!cancel_.is_cancelled()) {
+    auto timeout = std::chrono::milliseconds{k_idle_poll_ms};
+    if (!impl.changed.empty()) {
+      auto const now = Clock::now();
+      if (!first_change) {
+        first_change = now;  // Left over from a batch cut short by the cap
+        last_change = now;
+      }
+      auto const close_at = std::min(last_change + quiet_period_, *first_change + k_max_batch_delay);
+      if (now >= close_at) {
+        impl.settle_batch();
+        std::vector<fs::path> batch(impl.changed.begin(), impl.changed.end());
+        impl.changed.clear();
+        return batch;
+      }
+      timeout = std::min(timeout, std::chrono::ceil<std::chrono::milliseconds>(close_at - now));
+    }
+
+    pollfd waiting{.fd = impl.inotify_fd, .events = POLLIN, .revents = 0};
+    int const ready = ::poll(&waiting, 1, static_cast<int>(timeout.count()));
+    if (ready < 0 && errno != EINTR) {
+      return std::nullopt;
+    }
+    if (ready > 0) {
+      // Any write to a batched file restarts the quiet period, not just ones that grow the batch:
+      // editors that save by writing twice would otherwise see the batch close in between
+      bool relevant = false;
+      if (!impl.drain_events(relevant)) {
+        return std::nullopt;
+      }
+      if (relevant && !impl.changed.empty()) {
+        last_change = Clock::now();
+        first_change = first_change.value_or(last_change);
+      }
+    }
+  }
+  return std::nullopt;
+}
+
+std::vector<semantic::Module_Descriptor> Source_Watcher::modules() const {
+  std::vector<semantic::Module_Descriptor> result;
+  result.reserve(m_impl->modules.size());
+  for (auto const& [directory, module]: m_impl->modules) {
+    result.push_back(module);
+  }
+  return result;
+}
+
+fs::path const& Source_Watcher::src_root() const { return m_impl->src_root; }
+
+}  // namespace life_lang::server
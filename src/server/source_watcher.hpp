@@ -0,0 +1,72 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace life_lang {
+class Cancellation_Token;
+}
+
+namespace life_lang::semantic {
+struct Module_Descriptor;
+}
+
+namespace life_lang::server {
+
+// ============================================================================
+// Source_Watcher - inotify view of the .life files under a src/ root
+// ============================================================================
+// Starts from Module_Loader::discover_modules and watches every directory under
+// the root. Saves, creations, renames and deletions of .life files are collected
+// into batches: a batch closes once the tree has been quiet for the quiet period
+// (an editor's save is several events: write, rename over, chmod...) or, under a
+// steady stream of events, k_max_batch_delay after its first change, so
+// diagnostics are never held back longer than that.
+//
+// Directories created or moved in are watched as they appear and the .life files
+// already inside them are reported; a directory deleted or moved away reports
+// every file it held. When the kernel's event queue overflows, the tree is
+// discovered again and every file is reported.
+//
+// Example:
+//   auto watcher = Source_Watcher::open("src/");
+//   while (auto const changed = watcher->wait_for_changes(stop)) {
+//     context.update(*changed);
+//   }
+
+class Source_Watcher {
+public:
+  static constexpr std::chrono::milliseconds k_default_quiet_period{50};
+  static constexpr std::chrono::milliseconds k_max_batch_delay{500};
+
+  // std::nullopt if src_root_ isn't a directory or inotify is unavailable
+  [[nodiscard]] static std::optional<Source_Watcher> open(std::filesystem::path const& src_root_);
+
+  // Move-only (owns the inotify descriptor)
+  Source_Watcher(Source_Watcher const&) = delete;
+  Source_Watcher& operator=(Source_Watcher const&) = delete;
+  Source_Watcher(Source_Watcher&&) noexcept;
+  Source_Watcher& operator=(Source_Watcher&&) noexcept;
+  ~Source_Watcher();
+
+  // Block until a batch of changes has settled and return the changed .life paths (canonical,
+  // sorted, each once; deleted files included); std::nullopt once cancel_ fires (polled every
+  // 100 ms) or reading events fails
+  [[nodiscard]] std::optional<std::vector<std::filesystem::path>>
+  wait_for_changes(Cancellation_Token const& cancel_, std::chrono::milliseconds quiet_period_ = k_default_quiet_period);
+
+  // The modules under the root as of the last batch, as discover_modules would describe them now
+  [[nodiscard]] std::vector<semantic::Module_Descriptor> modules() const;
+
+  [[nodiscard]] std::filesystem::path const& src_root() const;
+
+private:
+  struct Impl;
+  explicit Source_Watcher(std::unique_ptr<Impl> impl_);
+  std::unique_ptr<Impl> m_impl;
+};
+
+}  // namespace life_lang::server
@@ -0,0 +1,113 @@
+#include "thread_pool.hpp"
+
+#include <algorithm>
+
+namespace life_lang {
+
+namespace {
+// Lets submit() from a worker push onto that worker's own deque
+thread_local Thread_Pool const* t_current_pool = nullptr;
+thread_local std::size_t t_worker_index = 0;
+}  // namespace
+
+Thread_Pool::Thread_Pool(std::size_t thread_count_) {
+  std::size_t const count =
+      std::max<std::size_t>(thread_count_ != 0 ? thread_count_ : std::thread::hardware_concurrency(), 1);
+  m_queues.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    m_queues.push_back(std::make_unique<Worker_Queue>());
+  }
+  m_threads.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    m_threads.emplace_back([this, i] { worker_loop(i); });
+  }
+}
+
+Thread_Pool::~Thread_Pool() {
+  wait();
+  {
+    std::lock_guard const lock(m_mutex);
+    m_stopping = true;
+  }
+  m_work_available.notify_all();
+  for (auto& thread: m_threads) {
+    thread.join();
+  }
+}
+
+void Thread_Pool::submit(Task task_) {
+  std::size_t const target =
+      (t_current_pool == this) ? t_worker_index : m_next_queue.fetch_add(1) % m_queues.size();
+
+  m_pending.fetch_add(1);
+  {
+    std::lock_guard const lock(m_queues[target]->mutex);
+    m_queues[target]->tasks.push_back(std::move(task_));
+  }
+  m_queued.fetch_add(1);
+
+  // Taking m_mutex orders the m_queued update before a sleeping worker re-checks it
+  { std::lock_guard const lock(m_mutex); }
+  m_work_available.notify_one();
+}
+
+void Thread_Pool::wait() {
+  Task task;
+  while (m_pending.load() != 0) {
+    if (try_take(0, task)) {
+      run(task);
+      continue;
+    }
+    std::unique_lock lock(m_mutex);
+    m_all_done.wait(lock, [this] { return m_pending.load() == 0; });
+  }
+}
+
+bool Thread_Pool::try_take(std::size_t home_, Task& task_) {
+  for (std::size_t i = 0; i < m_queues.size(); ++i) {
+    auto& queue = *m_queues[(home_ + i) % m_queues.size()];
+    std::lock_guard const lock(queue.mutex);
+    if (queue.tasks.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      task_ = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    } else {
+      task_ = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+    m_queued.fetch_sub(1);
+    return true;
+  }
+  return false;
+}
+
+void Thread_Pool::run(Task& task_) {
+  task_();
+  task_ = nullptr;
+  if (m_pending.fetch_sub(1) == 1) {
+    std::lock_guard const lock(m_mutex);
+    m_all_done.notify_all();
+  }
+}
+
+void Thread_Pool::worker_loop(std::size_t index_) {
+  t_current_pool = this;
+  t_worker_index = index_;
+
+  Task task;
+  while (true) {
+    if (try_take(index_, task)) {
+      run(task);
+      continue;
+    }
+    std::unique_lock lock(m_mutex);
+    m_work_available.wait(lock, [this] { return m_stopping || m_queued.load() != 0; });
+    if (m_stopping && m_queued.load() == 0) {
+      return;
+    }
+  }
+}
+
+}  // namespace life_lang
@@ -0,0 +1,82 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace life_lang {
+
+// ============================================================================
+// Thread_Pool - Work-stealing pool for file-level parallelism
+// ============================================================================
+// Each worker owns a deque: it pops its own tasks LIFO (hot caches for tasks
+// spawned by the task it just ran) and steals from the front of other workers'
+// deques when it runs dry. Tasks submitted from outside the pool are spread
+// round-robin across the worker deques.
+//
+// wait() blocks until every submitted task has finished, running queued tasks
+// on the calling thread meanwhile. Tasks may submit more tasks, but only code
+// outside the pool may wait.
+//
+// Example:
+//   Thread_Pool pool;
+//   std::vector<Result> results(inputs.size());
+//   for (std::size_t i = 0; i < inputs.size(); ++i) {
+//     pool.submit([&, i] { results[i] = work(inputs[i]); });
+//   }
+//   pool.wait();  // results are in input order no matter which worker ran what
+
+class Thread_Pool {
+public:
+  using Task = std::function<void()>;
+
+  // thread_count_ == 0 uses std::thread::hardware_concurrency()
+  explicit Thread_Pool(std::size_t thread_count_ = 0);
+
+  // Non-copyable, non-movable (workers hold a pointer to the pool)
+  Thread_Pool(Thread_Pool const&) = delete;
+  Thread_Pool& operator=(Thread_Pool const&) = delete;
+  Thread_Pool(Thread_Pool&&) = delete;
+  Thread_Pool& operator=(Thread_Pool&&) = delete;
+
+  // Finishes queued tasks, then joins the workers
+  ~Thread_Pool();
+
+  void submit(Task task_);
+
+  // Block until all submitted tasks (including tasks they submitted) have run
+  void wait();
+
+  [[nodiscard]] std::size_t thread_count() const { return m_threads.size(); }
+
+private:
+  struct Worker_Queue {
+    std::mutex mutex;
+    std::deque<Task> tasks;
+  };
+
+  std::vector<std::unique_ptr<Worker_Queue>> m_queues;  // One per worker
+  std::vector<std::thread> m_threads;
+
+  std::mutex m_mutex;  // Guards sleeping/waking only; the queues have their own locks
+  std::condition_variable m_work_available;
+  std::condition_variable m_all_done;
+  std::atomic<std::size_t> m_queued{0};   // Submitted, not yet picked up
+  std::atomic<std::size_t> m_pending{0};  // Submitted, not yet finished
+  std::atomic<std::size_t> m_next_queue{0};
+  bool m_stopping = false;
+
+  void worker_loop(std::size_t index_);
+
+  // Pop from the home queue (back) or steal from the others (front)
+  [[nodiscard]] bool try_take(std::size_t home_, Task& task_);
+  void run(Task& task_);
+};
+
+}  // namespace life_lang
@@ -0,0 +1,158 @@
+#include "utf8.hpp"
+
+#include <bit>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace life_lang {
+
+namespace {
+
+// Allowed range of the second byte of a sequence (Unicode Table 3-7); the
+// remaining continuation bytes are always 0x80..0xBF. The narrowed ranges reject
+// overlong forms (E0, F0), surrogates (ED) and code points above U+10FFFF (F4).
+struct Second_Byte_Range {
+  unsigned char low;
+  unsigned char high;
+};
+
+constexpr Second_Byte_Range second_byte_range(unsigned char lead_) {
+  switch (lead_) {
+    case 0xE0U:
+      return {.low = 0xA0U, .high = 0xBFU};
+    case 0xEDU:
+      return {.low = 0x80U, .high = 0x9FU};
+    case 0xF0U:
+      return {.low = 0x90U, .high = 0xBFU};
+    case 0xF4U:
+      return {.low = 0x80U, .high = 0x8FU};
+    default:
+      return {.low = 0x80U, .high = 0xBFU};
+  }
+}
+
+// Length of the well-formed sequence at offset_, or 0 with bad_length_ set to the maximal subpart
+std::size_t decode_sequence(std::string_view text_, std::size_t offset_, std::size_t& bad_length_) {
+  auto const lead = static_cast<unsigned char>(text_[offset_]);
+  std::size_t const length = utf8_sequence_length(static_cast<char>(lead));
+  bad_length_ = 1;
+  if (length == 0) {
+    return 0;
+  }
+
+  auto const [low, high] = second_byte_range(lead);
+  for (std::size_t i = 1; i < length; ++i) {
+    if (offset_ + i >= text_.size()) {
+      return 0;
+    }
+    auto const byte = static_cast<unsigned char>(text_[offset_ + i]);
+    bool const in_range = (i == 1) ? (byte >= low && byte <= high) : is_utf8_continuation(static_cast<char>(byte));
+    if (!in_range) {
+      return 0;
+    }
+    bad_length_ = i + 1;
+  }
+  return length;
+}
+
+}  // namespace
+
+std::size_t ascii_prefix_length(std::string_view text_) {
+  std::size_t i = 0;
+#if defined(__SSE2__)
+  constexpr std::size_t k_block = 16;
+  for (; i + k_block <= text_.size(); i += k_block) {
+    // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+    __m128i const block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(text_.data() + i));
+    auto const high_bits = static_cast<unsigned>(_mm_movemask_epi8(block));
+    if (high_bits != 0) {
+      return i + static_cast<std::size_t>(std::countr_zero(high_bits));
+    }
+  }
+#else
+  // Word-at-a-time fallback: one test per 8 bytes
+  constexpr std::size_t k_block = sizeof(std::uint64_t);
+  constexpr std::uint64_t k_high_bits = 0x8080808080808080ULL;
+  for (; i + k_block <= text_.size(); i += k_block) {
+    std::uint64_t word = 0;
+    std::memcpy(&word, text_.data() + i, k_block);
+    if ((word & k_high_bits) != 0) {
+      break;
+    }
+  }
+#endif
+  while (i < text_.size() && static_cast<unsigned char>(text_[i]) < 0x80U) {
+    ++i;
+  }
+  return i;
+}
+
+std::vector<Utf8_Error> validate_utf8(std::string_view text_) {
+  std::vector<Utf8_Error> errors;
+  std::size_t i = ascii_prefix_length(text_);
+  while (i < text_.size()) {
+    std::size_t bad_length = 0;
+    std::size_t const length = decode_sequence(text_, i, bad_length);
+    if (length != 0) {
+      i += length;
+    } else {
+      if (!errors.empty() && errors.back().offset + errors.back().length == i) {
+        errors.back().length += bad_length;  // Runs of garbage get one diagnostic
+      } else {
+        errors.push_back(Utf8_Error{.offset = i, .length = bad_length});
+      }
+      i += bad_length;
+    }
+    i += ascii_prefix_length(text_.substr(i));
+  }
+  return errors;
+}
+
+std::size_t count_code_points(std::string_view text_) {
+  std::size_t count = 0;
+  for (char const c: text_) {
+    if (!is_utf8_continuation(c)) {
+      ++count;
+    }
+  }
+  return count;
+}
+
+std::size_t advance_code_points(std::string_view text_, std::size_t offset_, std::size_t count_) {
+  std::size_t i = offset_;
+  for (std::size_t n = 0; n < count_ && i < text_.size(); ++n) {
+    ++i;
+    while (i < text_.size() && is_utf8_continuation(text_[i])) {
+      ++i;
+    }
+  }
+  return i;
+}
+
+std::size_t count_utf16_units(std::string_view text_) {
+  std::size_t count = 0;
+  for (char const c: text_) {
+    if (!is_utf8_continuation(c)) {
+      count += utf8_sequence_length(c) == 4 ? std::size_t{2} : std::size_t{1};
+    }
+  }
+  return count;
+}
+
+std::size_t advance_utf16_units(std::string_view text_, std::size_t offset_, std::size_t count_) {
+  std::size_t i = offset_;
+  for (std::size_t n = 0; n < count_ && i < text_.size();) {
+    n += utf8_sequence_length(text_[i]) == 4 ? std::size_t{2} : std::size_t{1};
+    ++i;
+    while (i < text_.size() && is_utf8_continuation(text_[i])) {
+      ++i;
+    }
+  }
+  return i;
+}
+
+}  // namespace life_lang
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <cstddef>
+#include <string_view>
+#include <vector>
+
+namespace life_lang {
+
+// ============================================================================
+// UTF-8 - Validation and code point counting for source text
+// ============================================================================
+// Source files are validated once when they are registered. Everything after
+// that (lexer, column computation, diagnostics printer) may assume well-formed
+// UTF-8 for files without errors.
+//
+// None of the multi-byte sequences contain a byte below 0x80, so '\n', '\r',
+// quotes and backslashes found by a byte scan are always real characters, and
+// a sequence never spans a line break.
+
+// An ill-formed byte range (maximal subpart, adjacent ones merged)
+struct Utf8_Error {
+  std::size_t offset{};
+  std::size_t length{};
+
+  [[nodiscard]] bool operator==(Utf8_Error const&) const = default;
+};
+
+// Length of the prefix of text_ made only of ASCII bytes (SIMD-accelerated where available)
+[[nodiscard]] std::size_t ascii_prefix_length(std::string_view text_);
+
+[[nodiscard]] inline bool is_ascii(std::string_view text_) {
+  return ascii_prefix_length(text_) == text_.size();
+}
+
+// Every ill-formed range in text_, in order (empty if text_ is valid UTF-8)
+[[nodiscard]] std::vector<Utf8_Error> validate_utf8(std::string_view text_);
+
+// Sequence length announced by a lead byte (1 for ASCII, 0 for a byte that cannot start a sequence)
+[[nodiscard]] constexpr std::size_t utf8_sequence_length(char lead_) {
+  auto const byte = static_cast<unsigned char>(lead_);
+  if (byte < 0x80U) {
+    return 1;
+  }
+  if (byte >= 0xC2U && byte <= 0xDFU) {
+    return 2;
+  }
+  if (byte >= 0xE0U && byte <= 0xEFU) {
+    return 3;
+  }
+  if (byte >= 0xF0U && byte <= 0xF4U) {
+    return 4;
+  }
+  return 0;
+}
+
+[[nodiscard]] constexpr bool is_utf8_continuation(char ch_) {
+  return (static_cast<unsigned char>(ch_) & 0xC0U) == 0x80U;
+}
+
+// Number of code points in text_ (bytes that are not continuation bytes)
+[[nodiscard]] std::size_t count_code_points(std::string_view text_);
+
+// Byte offset reached by stepping over count_ code points of text_ from offset_ (clamped to the end)
+[[nodiscard]] std::size_t advance_code_points(std::string_view text_, std::size_t offset_, std::size_t count_);
+
+// Number of UTF-16 code units text_ takes (editor protocols count columns this way):
+// two for a 4-byte sequence, one for any other code point
+[[nodiscard]] std::size_t count_utf16_units(std::string_view text_);
+
+// Byte offset reached by stepping over count_ UTF-16 code units of text_ from offset_ (clamped to
+// the end; a count ending inside a surrogate pair stops after the whole code point)
+[[nodiscard]] std::size_t advance_utf16_units(std::string_view text_, std::size_t offset_, std::size_t count_);
+
+}  // namespace life_lang
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <system_error>
+
+// ============================================================================
+// Temp_Dir - a fresh, uniquely named scratch directory for one test
+// ============================================================================
+// Named like Temp_Module_Fixture's directories ("life_test_<prefix>_<timestamp>"),
+// plus a per-process counter for fixtures made within one clock tick. The name is
+// claimed with create_directory, so a test running in parallel (another thread or
+// another test process) never shares it; a taken name is retried with a new one.
+// The directory and everything in it is removed on destruction.
+//
+// Example:
+//   Temp_Dir const dir{"parse_cache"};
+//   auto const point = dir.write("src/geometry/point.life", "pub struct Point { x: I32 }\n");
+
+class Temp_Dir {
+public:
+  explicit Temp_Dir(std::string_view prefix_) {
+    static std::atomic<std::uint64_t> s_counter{0};
+    auto const root = std::filesystem::temp_directory_path();
+    do {
+      auto const now = std::chrono::system_clock::now();
+      auto const timestamp = std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+      m_path = root / ("life_test_" + std::string{prefix_} + "_" + std::to_string(timestamp) + "_" +
+                       std::to_string(s_counter++));
+    } while (!std::filesystem::create_directory(m_path));
+  }
+
+  Temp_Dir(Temp_Dir const&) = delete;
+  Temp_Dir(Temp_Dir&&) = delete;
+  Temp_Dir& operator=(Temp_Dir const&) = delete;
+  Temp_Dir& operator=(Temp_Dir&&) = delete;
+
+  ~Temp_Dir() {
+    std::error_code ec;
+    std::filesystem::remove_all(m_path, ec);
+  }
+
+  [[nodiscard]] std::filesystem::path const& path() const { return m_path; }
+
+  // Write content_ to path() / relative_path_, creating its directories; returns the full path
+  std::filesystem::path write(std::filesystem::path const& relative_path_, std::string_view content_) const {
+    auto const full_path = m_path / relative_path_;
+    std::filesystem::create_directories(full_path.parent_path());
+    std::ofstream file(full_path);
+    file << content_;
+    return full_path;
+  }
+
+private:
+  std::filesystem::path m_path;
+};
@@ -0,0 +1,192 @@
+#include <doctest/doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+
+#include "content_hash.hpp"
+#include "diagnostics.hpp"
+#include "mapped_file.hpp"
+#include "parser/ast.hpp"
+#include "parser/ast_binary.hpp"
+#include "parser/parser.hpp"
+#include "parser/sexp.hpp"
+#include "temp_dir.hpp"
+
+using namespace life_lang;
+namespace fs = std::filesystem;
+
+namespace {
+
+// Touches every node kind the encoder knows about
+constexpr auto k_all_nodes_source = R"life(
+import Geometry.{Point as P, Circle};
+
+pub struct Pair<T: Display + Clone, U> where T: Eq {
+  pub first: T,
+  second: U,
+}
+
+enum Shape {
+  Empty,
+  Circle(F64),
+  Rect { w: F64, h: F64 },
+}
+
+type Handler = fn(I32, Bool): Std.Result<I32, String>;
+
+trait Iterator<T> {
+  type Item: Display;
+  fn next(mut self): Option<T>;
+}
+
+impl<T> Iterator<T> for List<T> where T: Clone {
+  type Item = T;
+  fn next(mut self): Option<T> { return None; }
+}
+
+impl Point {
+  pub fn len(self): F64 { return 0.0; }
+}
+
+fn main(args: [String; 4], pair: (I32, Bool)): I32 {
+  let mut total: I64 = 0 as I64;
+  let (a, b) = (1U8, 2.5F32);
+  let Point { x, .. } = origin();
+  let arr = [1, 2, 3];
+  total = -arr[0] + ~x * (a << 2) % 7;
+  for i in 0..=10 {
+    if i == 3 { continue; } else if i > 8 && !flag { break; } else { total = total + i; }
+  }
+  while total < 100 { total = total + 1; }
+  let c = 'x';
+  let s = "hi {total} there";
+  let r = r"raw\n";
+  let t = true;
+  let u = ();
+  let p = Point { x: 1, y: { 2 } };
+  let m = match shape {
+    Shape.Circle(r) if r > 1.0 => 1,
+    Rect { w: 1, .. } => 2,
+    1 | 2 => 3,
+    (p, _) => 4,
+    _ => 5,
+  };
+  let v = loop_value.field.method<I32>(1, "x");
+  let w = ..5;
+  { nested(); }
+  Std.print("done");
+  return 0;
+}
+)life";
+
+constexpr auto k_point_source = R"(
+pub struct Point { x: I32, y: I32 }
+pub fn origin(): Point { return Point { x: 0, y: 0 }; }
+)";
+
+ast::Module parse_source(std::string source_) {
+  Source_File_Registry registry;
+  File_Id const file_id = registry.register_file("sample.life", std::move(source_));
+  Diagnostic_Engine diagnostics{registry, file_id};
+  parser::Parser parser{diagnostics};
+  auto module = parser.parse_module();
+  REQUIRE(module.has_value());
+  REQUIRE(diagnostics.diagnostics().empty());
+  return std::move(*module);
+}
+
+}  // namespace
+
+TEST_SUITE("Binary AST Format") {
+  TEST_CASE("AST binary encoding round-trips every node kind") {
+    auto const module = parse_source(k_all_nodes_source);
+    auto const bytes = ast::encode_module(module);
+
+    File_Id const other_file = 42;
+    auto const decoded = ast::decode_module(bytes, other_file);
+    REQUIRE(decoded.has_value());
+    CHECK(ast::to_sexp_string(*decoded, 2) == ast::to_sexp_string(module, 2));
+    CHECK(ast::encode_module(*decoded) == bytes);  // Spans and every field survive, not just the printed ones
+
+    // Located spans are re-stamped with the file they are decoded for
+    REQUIRE_FALSE(decoded->items.empty());
+    CHECK(decoded->items.front().span.file == other_file);
+    CHECK(decoded->items.front().span.start.line == module.items.front().span.start.line);
+    CHECK(decoded->imports.front().span.file == other_file);
+  }
+
+  TEST_CASE("AST binary decoding rejects malformed input") {
+    auto const bytes = ast::encode_module(parse_source(k_point_source));
+    CHECK_FALSE(ast::decode_module("", 1).has_value());
+    CHECK_FALSE(ast::decode_module(std::string_view{bytes}.substr(0, bytes.size() - 1), 1).has_value());
+    CHECK_FALSE(ast::decode_module(std::string_view{bytes}.substr(0, bytes.size() / 2), 1).has_value());
+    CHECK_FALSE(ast::decode_module(bytes + '\0', 1).has_value());  // Trailing bytes
+    CHECK_FALSE(ast::decode_module(std::string(16, '\xFF'), 1).has_value());
+  }
+
+  TEST_CASE("Header identifies the format version, compiler build and source") {
+    std::uint64_t const source_hash = hash_bytes(k_point_source);
+    auto const bytes = ast::encode_module(parse_source(k_point_source), source_hash);
+
+    auto const header = ast::read_header(bytes);
+    REQUIRE(header.has_value());
+    CHECK(header->version == ast::k_ast_binary_version);
+    CHECK(header->compiler_hash == ast::ast_binary_compiler_hash());
+    CHECK(header->source_hash == source_hash);
+
+    // Another format version or compiler build: rejected before the body is looked at
+    std::string other_version = bytes;
+    other_version[4] = static_cast<char>(other_version[4] + 1);
+    CHECK_FALSE(ast::read_header(other_version).has_value());
+    CHECK_FALSE(ast::decode_module(other_version, 1).has_value());
+    std::string other_compiler = bytes;
+    other_compiler[8] = static_cast<char>(other_compiler[8] ^ 1);
+    CHECK_FALSE(ast::decode_module(other_compiler, 1).has_value());
+  }
+
+  TEST_CASE("Corrupt bodies fail the checksum") {
+    auto const bytes = ast::encode_module(parse_source(k_point_source));
+    for (std::size_t const offset: {bytes.size() / 2, bytes.size() - 1}) {
+      std::string corrupt = bytes;
+      corrupt[offset] = static_cast<char>(corrupt[offset] ^ 0x20);
+      CHECK_FALSE(ast::decode_module(corrupt, 1).has_value());
+    }
+  }
+
+  TEST_CASE("Repeated strings are stored once") {
+    std::string source;
+    for (int i = 0; i < 50; ++i) {
+      source += "fn f(): Some_Long_Type_Name { return Some_Long_Type_Name { value: 1 }; }\n";
+    }
+    auto const bytes = ast::encode_module(parse_source(source));
+    auto const type_name = std::string_view{"Some_Long_Type_Name"};
+    CHECK(bytes.find(type_name) == bytes.rfind(type_name));
+  }
+
+  TEST_CASE("Read a module file through a memory mapping") {
+    Temp_Dir const temp{"ast_binary"};
+    auto const& dir = temp.path();
+    auto const module = parse_source(k_all_nodes_source);
+    {
+      std::ofstream out(dir / "sample.lab", std::ios::binary);
+      out << ast::encode_module(module);
+    }
+
+    auto const mapped = Mapped_File::open(dir / "sample.lab");
+    REQUIRE(mapped.has_value());
+    CHECK(mapped->bytes() == ast::encode_module(module));
+
+    auto const loaded = ast::read_module_file(dir / "sample.lab", 3);
+    REQUIRE(loaded.has_value());
+    CHECK(ast::to_sexp_string(*loaded, 0) == ast::to_sexp_string(module, 0));
+    CHECK_FALSE(ast::read_module_file(dir / "missing.lab", 3).has_value());
+
+    { std::ofstream empty(dir / "empty.lab"); }
+    auto const empty = Mapped_File::open(dir / "empty.lab");
+    REQUIRE(empty.has_value());
+    CHECK(empty->bytes().empty());
+    CHECK_FALSE(ast::read_module_file(dir / "empty.lab", 3).has_value());
+  }
+}
@@ -0,0 +1,194 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "cancellation.hpp"
+#include "diagnostics.hpp"
+#include "parser/ast.hpp"
+#include "parser/parser.hpp"
+#include "semantic/module_loader.hpp"
+#include "semantic/semantic_context.hpp"
+#include "temp_dir.hpp"
+
+using namespace life_lang;
+using namespace life_lang::semantic;
+namespace fs = std::filesystem;
+
+TEST_SUITE("Cancellation") {
+  struct Cancellation_Fixture {
+    Temp_Dir project{"cancellation"};
+    fs::path temp_src = project.path() / "src";
+
+    Cancellation_Fixture() { fs::create_directories(temp_src); }
+
+    void create_file(fs::path const& relative_path_, std::string const& content_) const {
+      auto const full_path = temp_src / relative_path_;
+      fs::create_directories(full_path.parent_path());
+      std::ofstream file(full_path);
+      file << content_;
+    }
+  };
+
+  TEST_CASE("Token state") {
+    SUBCASE("Fresh token is not cancelled") {
+      Cancellation_Token const token;
+      CHECK_FALSE(token.is_cancelled());
+    }
+
+    SUBCASE("cancel() latches") {
+      Cancellation_Token token;
+      token.cancel();
+      CHECK(token.is_cancelled());
+      CHECK(token.is_cancelled());
+    }
+
+    SUBCASE("Expired deadline cancels") {
+      Cancellation_Token const token{Cancellation_Token::Clock::now() - std::chrono::seconds{1}};
+      CHECK(token.is_cancelled());
+    }
+
+    SUBCASE("Future deadline does not cancel") {
+      Cancellation_Token token;
+      token.set_budget(std::chrono::hours{1});
+      CHECK_FALSE(token.is_cancelled());
+    }
+  }
+
+  TEST_CASE("Parser honours cancellation") {
+    std::string const source =
+        "fn first(): I32 { return 1; }\n"
+        "fn second(): I32 { return 2; }\n";
+
+    SUBCASE("Live token parses normally") {
+      Source_File_Registry registry;
+      File_Id const file_id = registry.register_file("live.life", std::string{source});
+      Diagnostic_Engine diagnostics{registry, file_id};
+      Cancellation_Token const token;
+
+      parser::Parser parser{diagnostics};
+      parser.set_cancellation_token(&token);
+      auto const module = parser.parse_module();
+
+      REQUIRE(module.has_value());
+      CHECK(module->items.size() == 2);
+      CHECK_FALSE(parser.cancelled());
+    }
+
+    SUBCASE("Cancelled token aborts without diagnostics") {
+      Source_File_Registry registry;
+      File_Id const file_id = registry.register_file("cancelled.life", std::string{source});
+      Diagnostic_Engine diagnostics{registry, file_id};
+      Cancellation_Token token;
+      token.cancel();
+
+      parser::Parser parser{diagnostics};
+      parser.set_cancellation_token(&token);
+      auto const module = parser.parse_module();
+
+      CHECK_FALSE(module.has_value());
+      CHECK(parser.cancelled());
+      CHECK(diagnostics.diagnostics().empty());
+    }
+
+    SUBCASE("Cancelled token stops a standalone block parse") {
+      Source_File_Registry registry;
+      File_Id const file_id = registry.register_file("block.life", "{ let x = 1; x; }");
+      Diagnostic_Engine diagnostics{registry, file_id};
+      Cancellation_Token const token{Cancellation_Token::Clock::now()};
+
+      parser::Parser parser{diagnostics};
+      parser.set_cancellation_token(&token);
+      CHECK_FALSE(parser.parse_block().has_value());
+      CHECK(parser.cancelled());
+      CHECK_FALSE(diagnostics.has_errors());
+    }
+  }
+
+  TEST_CASE("Module_Loader honours cancellation") {
+    Cancellation_Fixture const fixture;
+    fixture.create_file("geometry/a.life", "pub struct Point { x: I32 }\n");
+    fixture.create_file("geometry/b.life", "pub struct Point { y: I32 }\n");  // Duplicate on purpose
+
+    auto const modules = Module_Loader::discover_modules(fixture.temp_src);
+    REQUIRE(modules.size() == 1);
+
+    Diagnostic_Manager diag_mgr;
+    Cancellation_Token token;
+    token.cancel();
+
+    // A cancelled load reports nothing - not even the duplicate that a full load would find
+    CHECK_FALSE(Module_Loader::load_module(modules[0], diag_mgr, &token).has_value());
+    CHECK(diag_mgr.diagnostic_count() == 0);
+
+    // Same descriptor without cancellation surfaces the real error
+    CHECK_FALSE(Module_Loader::load_module(modules[0], diag_mgr).has_value());
+    CHECK(diag_mgr.has_errors());
+  }
+
+  TEST_CASE("Semantic_Context::load_modules reports Cancelled and leaves the context untouched") {
+    Cancellation_Fixture const fixture;
+    fixture.create_file("geometry/point.life", "pub struct Point { x: I32, y: I32 }\n");
+    fixture.create_file("main/main.life", "import Geometry.{ Point };\nfn main(): I32 { return 0; }\n");
+
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+
+    Cancellation_Token cancelled;
+    cancelled.cancel();
+    CHECK(ctx.load_modules(fixture.temp_src, cancelled) == Load_Status::Cancelled);
+    CHECK(ctx.module_paths().empty());
+    CHECK(ctx.find_type_def("Geometry", "Point") == nullptr);
+    CHECK(diag_mgr.diagnostic_count() == 0);
+    CHECK(diag_mgr.registry().file_count() == 0);
+
+    // No src/ root was kept either: there is nothing to update
+    CHECK(ctx.update({fixture.temp_src / "geometry/point.life"}, cancelled) == Load_Status::Failed);
+    diag_mgr.clear_diagnostics();
+
+    // The same context can be loaded afterwards with a live token
+    Cancellation_Token const live;
+    REQUIRE(ctx.load_modules(fixture.temp_src, live) == Load_Status::Ok);
+    CHECK(ctx.module_paths().size() == 2);
+    CHECK(ctx.find_type_def("Geometry", "Point") != nullptr);
+
+    // A cancelled update drops whatever it registered or reported
+    auto const file_count = diag_mgr.registry().file_count();
+    fixture.create_file("geometry/point.life", "pub struct Point { x: I32, y: I32, z: I32 }\n");
+    fixture.create_file("geometry/broken.life", "fn broken( { }\n");
+    CHECK(
+        ctx.update({fixture.temp_src / "geometry/point.life", fixture.temp_src / "geometry/broken.life"}, cancelled) ==
+        Load_Status::Cancelled
+    );
+    CHECK(diag_mgr.registry().file_count() == file_count);
+    CHECK(diag_mgr.diagnostic_count() == 0);
+  }
+
+  TEST_CASE("Semantic_Context::load_reachable_modules undoes a cancelled load") {
+    Cancellation_Fixture const fixture;
+    fixture.create_file("geometry/point.life", "pub struct Point { x: I32, y: I32 }\n");
+    fixture.create_file("main/main.life", "import Geometry.{ Point };\nfn main(): I32 { return 0; }\n");
+
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+
+    Cancellation_Token cancelled;
+    cancelled.cancel();
+    CHECK(ctx.load_reachable_modules(fixture.temp_src, {"Main"}, cancelled) == Load_Status::Cancelled);
+    CHECK(ctx.module_paths().empty());
+    CHECK(diag_mgr.diagnostic_count() == 0);
+    CHECK(diag_mgr.registry().file_count() == 0);
+  }
+
+  TEST_CASE("Semantic_Context::load_modules reports Failed for parse errors") {
+    Cancellation_Fixture const fixture;
+    fixture.create_file("broken/broken.life", "fn broken( { }\n");
+
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    Cancellation_Token const live;
+    CHECK(ctx.load_modules(fixture.temp_src, live) == Load_Status::Failed);
+  }
+}
@@ -0,0 +1,159 @@
+#include <doctest/doctest.h>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <array>
+#include <filesystem>
+#include <string>
+#include <thread>
+
+#include "cancellation.hpp"
+#include "server/compile_server.hpp"
+#include "server/protocol.hpp"
+#include "temp_dir.hpp"
+
+using namespace life_lang::server;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Server_Fixture {
+  Temp_Dir project{"compile_server"};
+  fs::path temp_src = project.path() / "src";
+  fs::path socket_path = project.path() / "lifec.sock";
+
+  Server_Fixture() {
+    write(
+        "geometry/point.life",
+        "pub struct Point { x: I32, y: I32 }\npub fn origin(): Point { return Point { x: 0, y: 0 }; }\n"
+    );
+    write("app/main.life", "import Geometry.{ Point, origin };\npub fn main(): I32 { return 0; }\n");
+  }
+
+  Server_Fixture(Server_Fixture const&) = delete;
+  Server_Fixture(Server_Fixture&&) = delete;
+  Server_Fixture& operator=(Server_Fixture const&) = delete;
+  Server_Fixture& operator=(Server_Fixture&&) = delete;
+
+  // Returns the full path of the written file (ignored by callers that only set up the tree)
+  fs::path write(fs::path const& relative_path_, std::string const& content_) const {
+    return project.write(fs::path{"src"} / relative_path_, content_);
+  }
+
+  [[nodiscard]] Request check() const { return Request{.command = "check", .args = {temp_src.string()}}; }
+
+  [[nodiscard]] Request resolve(std::string module_, std::string name_) const {
+    return Request{.command = "resolve", .args = {temp_src.string(), std::move(module_), std::move(name_)}};
+  }
+};
+
+}  // namespace
+
+TEST_SUITE("Compile Server") {
+  TEST_CASE("Requests and replies survive framing") {
+    Request const request{.command = "resolve", .args = {"/src", "App", ""}};
+    auto const decoded = decode_request(encode_request(request));
+    REQUIRE(decoded.has_value());
+    CHECK(decoded->command == "resolve");
+    CHECK(decoded->args == request.args);
+    CHECK_FALSE(decode_request("no terminator").has_value());
+
+    auto const reply = decode_reply(encode_reply({.status = Reply_Status::Failed, .output = "error\n"}));
+    REQUIRE(reply.has_value());
+    CHECK(reply->status == Reply_Status::Failed);
+    CHECK(reply->output == "error\n");
+    CHECK_FALSE(decode_reply("9").has_value());
+
+    std::array<int, 2> fds{};
+    REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds.data()) == 0);
+    std::string const big(100'000, 'x');
+    std::thread writer([&] { CHECK(write_frame(fds[0], big)); CHECK(write_frame(fds[0], "")); });
+    CHECK(read_frame(fds[1]) == big);
+    CHECK(read_frame(fds[1]) == std::string{});
+    writer.join();
+    ::close(fds[0]);
+    CHECK_FALSE(read_frame(fds[1]).has_value());  // End of stream
+    ::close(fds[1]);
+  }
+
+  TEST_CASE("Check and resolve follow edits to the tree") {
+    Server_Fixture const fixture;
+    Compile_Server server{fixture.temp_src, fixture.socket_path};
+
+    auto reply = server.handle(fixture.check());
+    CHECK(reply.status == Reply_Status::Ok);
+    CHECK(reply.output.empty());
+
+    reply = server.handle(fixture.resolve("App", "Point"));
+    REQUIRE(reply.status == Reply_Status::Ok);
+    CHECK(reply.output.starts_with("Geometry "));
+    CHECK(reply.output.ends_with("point.life:1:1\n"));
+    reply = server.handle(fixture.resolve("App", "origin"));
+    REQUIRE(reply.status == Reply_Status::Ok);
+    CHECK(reply.output.ends_with("point.life:2:1\n"));
+
+    // A broken file fails the check until it is fixed; the last good modules keep answering
+    fixture.write("geometry/point.life", "pub struct Point {\n");
+    reply = server.handle(fixture.check());
+    CHECK(reply.status == Reply_Status::Failed);
+    CHECK(reply.output.find("point.life") != std::string::npos);
+    CHECK(server.handle(fixture.check()).status == Reply_Status::Failed);
+    CHECK(server.handle(fixture.resolve("App", "Point")).status == Reply_Status::Ok);
+
+    fixture.write("geometry/point.life", "\npub struct Point { x: I32 }\n");
+    CHECK(server.handle(fixture.check()).status == Reply_Status::Ok);
+    reply = server.handle(fixture.resolve("App", "Point"));
+    CHECK(reply.output.ends_with("point.life:2:1\n"));
+    reply = server.handle(fixture.resolve("App", "origin"));
+    CHECK(reply.status == Reply_Status::Failed);
+    CHECK(reply.output.starts_with("<request>:1:1: error: function 'origin' not found in current module or imports"));
+    CHECK(reply.output.find("point.life") == std::string::npos);
+
+    // A memoized miss is reported again
+    CHECK(server.handle(fixture.resolve("App", "origin")).output == reply.output);
+
+    CHECK(server.handle(Request{.command = "check", .args = {"/elsewhere"}}).status == Reply_Status::Rejected);
+    CHECK(server.handle(Request{.command = "compile", .args = {}}).status == Reply_Status::Rejected);
+  }
+
+  TEST_CASE("Parse prints the AST of one file") {
+    Server_Fixture const fixture;
+    Compile_Server server{fixture.temp_src, fixture.socket_path};
+    auto const path = fixture.write("scratch.life", "fn f(): I32 { return 1; }\n");
+    auto reply = server.handle(Request{.command = "parse", .args = {path.string()}});
+    CHECK(reply.status == Reply_Status::Ok);
+    CHECK(reply.output.starts_with("(module"));
+
+    fixture.write("scratch.life", "fn f(: I32\n");
+    reply = server.handle(Request{.command = "parse", .args = {path.string()}});
+    CHECK(reply.status == Reply_Status::Failed);
+    CHECK(reply.output.find("error") != std::string::npos);
+  }
+
+  TEST_CASE("Clients reach a listening server over the socket") {
+    Server_Fixture const fixture;
+    CHECK_FALSE(send_request(fixture.socket_path, fixture.check()).has_value());  // Nobody listening yet
+
+    Compile_Server server{fixture.temp_src, fixture.socket_path};
+    REQUIRE(server.listen());
+    life_lang::Cancellation_Token stop;
+    std::thread serving([&] { server.serve(stop); });
+
+    // A second server can't take over a live socket
+    Compile_Server other{fixture.temp_src, fixture.socket_path};
+    CHECK_FALSE(other.listen());
+
+    auto const checked = send_request(fixture.socket_path, fixture.check());
+    REQUIRE(checked.has_value());
+    CHECK(checked->status == Reply_Status::Ok);
+    auto const resolved = send_request(fixture.socket_path, fixture.resolve("App", "Geometry.Point"));
+    REQUIRE(resolved.has_value());
+    CHECK(resolved->output.starts_with("Geometry "));
+
+    auto const stopped = send_request(fixture.socket_path, Request{.command = "shutdown", .args = {}});
+    REQUIRE(stopped.has_value());
+    serving.join();
+    CHECK(server.shutdown_requested());
+  }
+}
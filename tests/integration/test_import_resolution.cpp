@@ -4,12 +4,16 @@
 #include "parser/parser.hpp"
 #include "semantic/semantic_context.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <thread>
+#include <vector>
 
 using life_lang::Diagnostic_Engine;
 using life_lang::Diagnostic_Manager;
+using life_lang::Diagnostic_Sink;
 using life_lang::File_Id;
 using namespace life_lang::semantic;
 namespace fs = std::filesystem;
@@ -1048,4 +1052,217 @@ TEST_SUITE("Generic Var Name Resolution") {
       CHECK(errors[0].message.find("UnknownValue") != std::string::npos);
     }
   }
+
+  TEST_CASE("Repeated unresolved name - reported once per module") {
+    Temp_Module_Fixture const fixture;
+    fs::create_directories(fixture.temp_src / "main");
+    fixture.create_file("main/app.life", "pub struct Point { x: I32 }\n");
+    fs::create_directories(fixture.temp_src / "other");
+    fixture.create_file("other/app.life", "pub struct Other { x: I32 }\n");
+
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    REQUIRE(ctx.load_modules(fixture.temp_src));
+
+    life_lang::Source_File_Registry registry;
+    File_Id const file_id = registry.register_file("<test>", std::string{"Missing"});
+    Diagnostic_Engine diag{registry, file_id};
+    life_lang::parser::Parser parser(diag);
+    auto const type_name_opt = parser.parse_type_name();
+    REQUIRE(type_name_opt.has_value());
+
+    for (int i = 0; i < 3; ++i) {
+      CHECK(!ctx.resolve_type_name("Main", *type_name_opt).has_value());
+    }
+    CHECK(diag_mgr.error_count() == 1);
+
+    // The same name in another module is a separate report
+    CHECK(!ctx.resolve_type_name("Other", *type_name_opt).has_value());
+    CHECK(diag_mgr.error_count() == 2);
+
+    // Hits are cached too and keep returning the same definition
+    File_Id const point_id = registry.register_file("<point>", std::string{"Point"});
+    Diagnostic_Engine point_diag{registry, point_id};
+    life_lang::parser::Parser point_parser(point_diag);
+    auto const point_opt = point_parser.parse_type_name();
+    REQUIRE(point_opt.has_value());
+    auto const first = ctx.resolve_type_name("Main", *point_opt);
+    auto const second = ctx.resolve_type_name("Main", *point_opt);
+    REQUIRE(first.has_value());
+    REQUIRE(second.has_value());
+    CHECK(first->first == "Main");
+    CHECK(first->second == second->second);
+    CHECK(first->second == ctx.find_type_def("Main", "Point"));
+  }
+
+  TEST_CASE("Cached miss is dropped when the imported module is reloaded") {
+    Temp_Module_Fixture const fixture;
+    fs::create_directories(fixture.temp_src / "geometry");
+    fixture.create_file("geometry/types.life", "pub struct Point { x: I32 }\n");
+    fs::create_directories(fixture.temp_src / "main");
+    fixture.create_file("main/app.life", "fn test(): I32 { return 0; }\n");
+
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    REQUIRE(ctx.load_modules(fixture.temp_src));
+
+    life_lang::Source_File_Registry registry;
+    File_Id const file_id = registry.register_file("<test>", std::string{"Geometry.Circle"});
+    Diagnostic_Engine diag{registry, file_id};
+    life_lang::parser::Parser parser(diag);
+    auto const type_name_opt = parser.parse_type_name();
+    REQUIRE(type_name_opt.has_value());
+
+    CHECK(!ctx.resolve_type_name("Main", *type_name_opt).has_value());
+    CHECK(diag_mgr.error_count() == 1);
+
+    // Add Circle and reload: the miss cached in Main depended on Geometry
+    fixture.create_file("geometry/types.life", "pub struct Point { x: I32 }\npub struct Circle { r: I32 }\n");
+    REQUIRE(ctx.load_modules(fixture.temp_src));
+
+    auto const result = ctx.resolve_type_name("Main", *type_name_opt);
+    REQUIRE(result.has_value());
+    CHECK(result->first == "Geometry");
+    CHECK(diag_mgr.error_count() == 1);
+  }
+
+  TEST_CASE("Import binding - visibility is per definition kind") {
+    Temp_Module_Fixture const fixture;
+    fs::create_directories(fixture.temp_src / "lib");
+    fixture.create_file(
+        "lib/lib.life",
+        "struct Hidden { x: I32 }\n"
+        "pub fn make(): I32 { return 0; }\n"
+    );
+    fs::create_directories(fixture.temp_src / "main");
+    fixture.create_file("main/app.life", "import Lib.{ Hidden, make as build };\n");
+
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    REQUIRE(ctx.load_modules(fixture.temp_src));
+
+    life_lang::Source_File_Registry registry;
+    auto const parse_var = [&](std::string text_) {
+      File_Id const file_id = registry.register_file("<test>", std::move(text_));
+      Diagnostic_Engine diag{registry, file_id};
+      life_lang::parser::Parser parser(diag);
+      return parser.parse_qualified_variable_name();
+    };
+    File_Id const type_file = registry.register_file("<type>", std::string{"Hidden"});
+    Diagnostic_Engine type_diag{registry, type_file};
+    life_lang::parser::Parser type_parser(type_diag);
+    auto const hidden_type = type_parser.parse_type_name();
+    REQUIRE(hidden_type.has_value());
+
+    // Aliased pub function is bound under its local name
+    auto const build = parse_var("build");
+    REQUIRE(build.has_value());
+    auto const result = ctx.resolve_var_name("Main", *build);
+    REQUIRE(result.has_value());
+    CHECK(result->first == "Lib");
+    CHECK(result->second == ctx.find_func_def("Lib", "make"));
+    CHECK(!diag_mgr.has_errors());
+
+    // Non-pub type: explained as a visibility error
+    CHECK(!ctx.resolve_type_name("Main", *hidden_type).has_value());
+    REQUIRE(diag_mgr.error_count() == 1);
+    CHECK(diag_mgr.all_diagnostics()[0].message.find("cannot import 'Hidden'") != std::string::npos);
+
+    // The same import used as a function: there is no such function at all
+    auto const hidden_var = parse_var("Hidden");
+    REQUIRE(hidden_var.has_value());
+    CHECK(!ctx.resolve_var_name("Main", *hidden_var).has_value());
+    REQUIRE(diag_mgr.error_count() == 2);
+    CHECK(diag_mgr.all_diagnostics()[1].message.find("function 'Hidden' not found") != std::string::npos);
+  }
+
+  TEST_CASE("Concurrent queries report into per-thread sinks") {
+    Temp_Module_Fixture const fixture;
+    fixture.create_file(
+        "geometry/types.life",
+        "pub struct Point { x: I32, y: I32 }\n"
+        "struct Hidden { x: I32 }\n"
+        "pub fn origin(): Point { return Point { x: 0, y: 0 }; }\n"
+    );
+    fixture.create_file(
+        "main/app.life",
+        "import Geometry.{ Point, Hidden, origin };\n"
+        "fn main(): I32 { return 0; }\n"
+    );
+
+    // One file per use site, so that source order is File_Id order
+    life_lang::Source_File_Registry registry;
+    std::vector<life_lang::ast::Type_Name> types;
+    auto const type_texts = {
+        "Point", "Missing", "Hidden", "Geometry.Point", "Missing", "Vec<Other>", "(Point, Hidden)",
+    };
+    for (std::string text: type_texts) {
+      Diagnostic_Engine diag{registry, registry.register_file("<type>", std::move(text))};
+      life_lang::parser::Parser parser(diag);
+      auto type_name = parser.parse_type_name();
+      REQUIRE(type_name.has_value());
+      types.push_back(std::move(*type_name));
+    }
+    std::vector<life_lang::ast::Var_Name> vars;
+    for (std::string text: {"origin", "nowhere", "Geometry.origin", "nowhere"}) {
+      Diagnostic_Engine diag{registry, registry.register_file("<var>", std::move(text))};
+      life_lang::parser::Parser parser(diag);
+      auto var_name = parser.parse_qualified_variable_name();
+      REQUIRE(var_name.has_value());
+      vars.push_back(std::move(*var_name));
+    }
+
+    // Reference: one thread, reporting to the manager in source order
+    Diagnostic_Manager expected;
+    Semantic_Context sequential(expected);
+    REQUIRE(sequential.load_modules(fixture.temp_src));
+    std::vector<bool> expected_found;
+    for (auto const& type: types) {
+      expected_found.push_back(sequential.resolve_type_name("Main", type).has_value());
+    }
+    for (auto const& var: vars) {
+      expected_found.push_back(sequential.resolve_var_name("Main", var).has_value());
+    }
+    REQUIRE(expected.error_count() == 5);  // Missing, Hidden, Vec, Other and nowhere: once each
+
+    // Every thread resolves everything many times, each starting at a different name
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    REQUIRE(ctx.load_modules(fixture.temp_src));
+    constexpr std::size_t k_threads = 8;
+    std::vector<Diagnostic_Sink> sinks(k_threads);
+    std::vector<std::vector<bool>> found(k_threads, std::vector<bool>(types.size() + vars.size()));
+    {
+      std::vector<std::jthread> threads;
+      for (std::size_t t = 0; t < k_threads; ++t) {
+        threads.emplace_back([&, t] {
+          for (std::size_t round = 0; round < 50; ++round) {
+            for (std::size_t n = 0; n < found[t].size(); ++n) {
+              std::size_t const i = (n + t) % found[t].size();
+              auto const resolved = i < types.size() ? ctx.resolve_type_name("Main", types[i], sinks[t])
+                                                     : ctx.resolve_var_name("Main", vars[i - types.size()], sinks[t]);
+              found[t][i] = resolved.has_value();
+            }
+          }
+        });
+      }
+    }
+    for (auto const& thread_found: found) {
+      CHECK(thread_found == expected_found);
+    }
+    CHECK(diag_mgr.diagnostic_count() == 0);  // Nothing bypassed the sinks
+
+    diag_mgr.merge(sinks);
+    CHECK(sinks[0].diagnostic_count() == 0);
+    // Same diagnostics as the sequential run, in source order (it reported "Other" before "Vec<Other>")
+    auto const& merged = diag_mgr.all_diagnostics();
+    auto reference = expected.all_diagnostics();
+    std::ranges::sort(reference, {}, [](auto const& diag_) { return std::pair{diag_.range.file, diag_.range.start}; });
+    REQUIRE(merged.size() == reference.size());
+    for (std::size_t i = 0; i < merged.size(); ++i) {
+      CHECK(merged[i].message == reference[i].message);
+      CHECK(merged[i].range.file == reference[i].range.file);
+      CHECK(merged[i].range.start == reference[i].range.start);
+    }
+  }
 }
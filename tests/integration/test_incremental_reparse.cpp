@@ -0,0 +1,297 @@
+#include <doctest/doctest.h>
+
+#include <string>
+#include <vector>
+
+#include "diagnostics.hpp"
+#include "parser/ast.hpp"
+#include "parser/parser.hpp"
+#include "parser/sexp.hpp"
+
+using namespace life_lang;
+
+namespace {
+
+constexpr auto k_base_source =
+    "import Geometry.{ Point };\n"
+    "\n"
+    "fn first(): I32 {\n"
+    "  return 1;\n"
+    "}\n"
+    "\n"
+    "struct Pair { a: I32, b: I32 }\n"
+    "\n"
+    "fn third(x: I32): I32 {\n"
+    "  let y = x + 1;\n"
+    "  return y;\n"
+    "}\n"
+    "\n"
+    "pub fn fourth(): Bool { return true; }\n";
+
+struct Reparse_Result {
+  std::optional<ast::Module> incremental;
+  std::optional<ast::Module> full;
+  ast::Module previous;
+  std::size_t incremental_errors = 0;
+  std::size_t full_errors = 0;
+};
+
+// Parse k_base_source, apply edit_ in place, reparse incrementally and from scratch
+Reparse_Result reparse_with(std::string const& source_, Text_Edit const& edit_) {
+  Reparse_Result result;
+
+  Source_File_Registry registry;
+  File_Id const file_id = registry.register_file("edit.life", std::string{source_});
+  {
+    Diagnostic_Engine diagnostics{registry, file_id};
+    parser::Parser parser{diagnostics};
+    auto previous = parser.parse_module();
+    REQUIRE(previous.has_value());
+    result.previous = std::move(*previous);
+  }
+
+  auto const removed_end = registry.get_file(file_id)->offset_to_position(edit_.offset + edit_.removed_length);
+  REQUIRE(registry.apply_edit(file_id, edit_));
+  {
+    Diagnostic_Engine diagnostics{registry, file_id};
+    parser::Parser parser{diagnostics};
+    result.incremental = parser.reparse_module(result.previous, edit_, removed_end);
+    result.incremental_errors = diagnostics.diagnostics().size();
+  }
+
+  Source_File_Registry fresh_registry;
+  File_Id const fresh_id = fresh_registry.register_file("edit.life", registry.get_file(file_id)->source());
+  REQUIRE(fresh_id == file_id);
+  Diagnostic_Engine diagnostics{fresh_registry, fresh_id};
+  parser::Parser parser{diagnostics};
+  result.full = parser.parse_module();
+  result.full_errors = diagnostics.diagnostics().size();
+  return result;
+}
+
+template <typename T>
+Source_Range span_of(T const& node_) {
+  return node_.span;
+}
+
+template <typename T>
+Source_Range span_of(std::shared_ptr<T> const& node_) {
+  return node_->span;
+}
+
+std::vector<Source_Range> item_spans(ast::Module const& module_) {
+  std::vector<Source_Range> spans;
+  for (auto const& item: module_.items) {
+    spans.push_back(item.span);
+    if (auto const* func = std::get_if<std::shared_ptr<ast::Func_Def>>(&item.item)) {
+      spans.push_back((*func)->body.span);
+      for (auto const& stmt: (*func)->body.statements) {
+        std::visit([&](auto const& node_) { spans.push_back(span_of(node_)); }, stmt);
+      }
+    }
+  }
+  return spans;
+}
+
+void check_same_as_full_parse(Reparse_Result const& result_) {
+  REQUIRE(result_.incremental.has_value() == result_.full.has_value());
+  CHECK(result_.incremental_errors == result_.full_errors);
+  if (!result_.full) {
+    return;
+  }
+  CHECK(ast::to_sexp_string(*result_.incremental, 0) == ast::to_sexp_string(*result_.full, 0));
+
+  auto const incremental_spans = item_spans(*result_.incremental);
+  auto const full_spans = item_spans(*result_.full);
+  REQUIRE(incremental_spans.size() == full_spans.size());
+  for (std::size_t i = 0; i < full_spans.size(); ++i) {
+    CHECK(incremental_spans[i].file == full_spans[i].file);
+    CHECK(incremental_spans[i].start == full_spans[i].start);
+    CHECK(incremental_spans[i].end == full_spans[i].end);
+  }
+  CHECK(result_.incremental->span.start == result_.full->span.start);
+  CHECK(result_.incremental->span.end == result_.full->span.end);
+}
+
+template <typename T>
+T const* item_node(ast::Module const& module_, std::size_t index_) {
+  return std::get<std::shared_ptr<T>>(module_.items.at(index_).item).get();
+}
+
+std::size_t offset_of(std::string_view source_, std::string_view needle_) {
+  auto const pos = source_.find(needle_);
+  REQUIRE(pos != std::string_view::npos);
+  return pos;
+}
+
+}  // namespace
+
+TEST_SUITE("Incremental Reparse") {
+  TEST_CASE("Same-line edit inside one item reuses every other item") {
+    std::string const source = k_base_source;
+    auto const result =
+        reparse_with(source, Text_Edit{.offset = offset_of(source, "x + 1"), .removed_length = 5, .inserted = "x * 2"});
+    check_same_as_full_parse(result);
+    REQUIRE(result.incremental.has_value());
+
+    // Untouched items share their nodes with the previous module
+    CHECK(item_node<ast::Func_Def>(*result.incremental, 0) == item_node<ast::Func_Def>(result.previous, 0));
+    CHECK(item_node<ast::Struct_Def>(*result.incremental, 1) == item_node<ast::Struct_Def>(result.previous, 1));
+    CHECK(item_node<ast::Func_Def>(*result.incremental, 2) != item_node<ast::Func_Def>(result.previous, 2));
+    CHECK(item_node<ast::Func_Def>(*result.incremental, 3) == item_node<ast::Func_Def>(result.previous, 3));
+  }
+
+  TEST_CASE("Inserted lines shift the spans of later items") {
+    std::string const source = k_base_source;
+    auto const result = reparse_with(
+        source,
+        Text_Edit{.offset = offset_of(source, "  return 1;"), .removed_length = 0, .inserted = "  let z = 0;\n\n"}
+    );
+    check_same_as_full_parse(result);
+    REQUIRE(result.incremental.has_value());
+
+    // Later items were rebased into copies, the previous module is untouched
+    CHECK(item_node<ast::Func_Def>(*result.incremental, 3) != item_node<ast::Func_Def>(result.previous, 3));
+    CHECK(result.previous.items[3].span.start.line == 14);
+    CHECK(result.incremental->items[3].span.start.line == 16);
+  }
+
+  TEST_CASE("Deleted lines shift later items up") {
+    std::string const source = k_base_source;
+    auto const begin = offset_of(source, "  let y");
+    auto const result = reparse_with(
+        source,
+        Text_Edit{.offset = begin, .removed_length = offset_of(source, "  return y;") - begin, .inserted = ""}
+    );
+    check_same_as_full_parse(result);
+  }
+
+  TEST_CASE("Multi-line replacement on non-ASCII lines maps later items through the edit") {
+    std::string const source =
+        "fn first(): I32 {\n"
+        "  let s = \"é\";\n"
+        "  return 1;\n"
+        "}\n"
+        "\n"
+        "fn second(): I32 { let t = \"ü\"; return 2; }\n"
+        "\n"
+        "fn last(): I32 { let u = \"ñ\"; return 3; }\n";
+    auto const begin = offset_of(source, "let s");
+    auto const result = reparse_with(
+        source,
+        Text_Edit{
+            .offset = begin,
+            .removed_length = offset_of(source, "return 1;") - begin,
+            .inserted = "let a = \"ß\";\n  let b = 2;\n  let c = 3;\n  "
+        }
+    );
+    check_same_as_full_parse(result);
+    REQUIRE(result.incremental.has_value());
+    CHECK(item_node<ast::Func_Def>(*result.incremental, 2) != item_node<ast::Func_Def>(result.previous, 2));
+    CHECK(result.incremental->items[2].span.start.line == result.previous.items[2].span.start.line + 2);
+  }
+
+  TEST_CASE("Edits between items") {
+    std::string const source = k_base_source;
+
+    SUBCASE("New item") {
+      auto const result = reparse_with(
+          source,
+          Text_Edit{
+              .offset = offset_of(source, "struct Pair"),
+              .removed_length = 0,
+              .inserted = "type Alias = I32;\n"
+          }
+      );
+      check_same_as_full_parse(result);
+      REQUIRE(result.incremental.has_value());
+      CHECK(result.incremental->items.size() == 5);
+    }
+
+    SUBCASE("Removed item") {
+      auto const begin = offset_of(source, "struct Pair");
+      auto const result = reparse_with(
+          source,
+          Text_Edit{.offset = begin, .removed_length = offset_of(source, "fn third") - begin, .inserted = ""}
+      );
+      check_same_as_full_parse(result);
+      REQUIRE(result.incremental.has_value());
+      CHECK(result.incremental->items.size() == 3);
+    }
+
+    SUBCASE("Comment only") {
+      auto const result = reparse_with(
+          source,
+          Text_Edit{.offset = offset_of(source, "\nstruct Pair"), .removed_length = 0, .inserted = "\n// note\n"}
+      );
+      check_same_as_full_parse(result);
+    }
+  }
+
+  TEST_CASE("Edits that change item boundaries") {
+    std::string const source = k_base_source;
+
+    SUBCASE("Unclosed brace swallows the following items") {
+      auto const closing_brace = offset_of(source, "}\n\nstruct");
+      auto const result = reparse_with(source, Text_Edit{.offset = closing_brace, .removed_length = 1, .inserted = ""});
+      check_same_as_full_parse(result);
+    }
+
+    SUBCASE("Two items merged into one line") {
+      auto const newline = offset_of(source, "\n\npub fn fourth");
+      auto const result = reparse_with(source, Text_Edit{.offset = newline, .removed_length = 2, .inserted = " "});
+      check_same_as_full_parse(result);
+    }
+
+    SUBCASE("Syntax error reports the same diagnostics as a full parse") {
+      auto const result =
+          reparse_with(source, Text_Edit{.offset = offset_of(source, "a: I32"), .removed_length = 1, .inserted = "@"});
+      check_same_as_full_parse(result);
+      CHECK_FALSE(result.incremental.has_value());
+      CHECK(result.incremental_errors > 0);
+    }
+  }
+
+  TEST_CASE("Edits reaching the imports fall back to a full parse") {
+    std::string const source = k_base_source;
+
+    SUBCASE("Inside an import") {
+      auto const imported = offset_of(source, "Point");
+      auto const result = reparse_with(source, Text_Edit{.offset = imported, .removed_length = 5, .inserted = "Line"});
+      check_same_as_full_parse(result);
+    }
+
+    SUBCASE("New import after the existing ones") {
+      auto const result = reparse_with(
+          source,
+          Text_Edit{.offset = offset_of(source, "\nfn first"), .removed_length = 0, .inserted = "import Std.{ Io };\n"}
+      );
+      check_same_as_full_parse(result);
+      REQUIRE(result.incremental.has_value());
+      CHECK(result.incremental->imports.size() == 2);
+    }
+  }
+
+  TEST_CASE("Empty edit reuses the whole module") {
+    std::string const source = k_base_source;
+    auto const result = reparse_with(source, Text_Edit{.offset = 0, .removed_length = 0, .inserted = ""});
+    check_same_as_full_parse(result);
+  }
+
+  TEST_CASE("Edit that does not match the previous source falls back to a full parse") {
+    std::string const source = k_base_source;
+    Source_File_Registry registry;
+    File_Id const file_id = registry.register_file("edit.life", std::string{source});
+    Diagnostic_Engine diagnostics{registry, file_id};
+    parser::Parser parser{diagnostics};
+    auto const previous = parser.parse_module();
+    REQUIRE(previous.has_value());
+
+    // Claims to insert text the registry never received
+    auto const reparsed = parser.reparse_module(
+        *previous, Text_Edit{.offset = 0, .removed_length = 0, .inserted = "x"}, Source_Position{.line = 1, .column = 1}
+    );
+    REQUIRE(reparsed.has_value());
+    CHECK(ast::to_sexp_string(*reparsed, 0) == ast::to_sexp_string(*previous, 0));
+  }
+}
@@ -0,0 +1,192 @@
+#include <doctest/doctest.h>
+
+#include "diagnostics.hpp"
+#include "parser/parser.hpp"
+#include "semantic/semantic_context.hpp"
+#include "temp_dir.hpp"
+
+#include <filesystem>
+#include <string>
+
+using life_lang::Diagnostic_Engine;
+using life_lang::Diagnostic_Manager;
+using life_lang::File_Id;
+using namespace life_lang::semantic;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Update_Fixture {
+  Temp_Dir project{"incremental_update"};
+  fs::path temp_src = project.path() / "src";
+
+  Update_Fixture() {
+    write("geometry/point.life", "pub struct Point { x: I32, y: I32 }\n");
+    write("geometry/shapes.life", "pub struct Circle { r: F64 }\n");
+    write("app/main.life", "import Geometry.{ Point };\npub fn main(): I32 { return 0; }\n");
+  }
+
+  Update_Fixture(Update_Fixture const&) = delete;
+  Update_Fixture(Update_Fixture&&) = delete;
+  Update_Fixture& operator=(Update_Fixture const&) = delete;
+  Update_Fixture& operator=(Update_Fixture&&) = delete;
+
+  // Returns the full path of the written file (ignored by callers that only set up the tree)
+  fs::path write(fs::path const& relative_path_, std::string const& content_) const {
+    return project.write(fs::path{"src"} / relative_path_, content_);
+  }
+};
+
+// Resolve a type name as written in module_
+std::optional<std::pair<std::string, life_lang::ast::Item const*>>
+resolve_type(Semantic_Context const& ctx_, std::string const& module_, std::string source_) {
+  life_lang::Source_File_Registry registry;
+  File_Id const file_id = registry.register_file("<test>", std::move(source_));
+  Diagnostic_Engine diag{registry, file_id};
+  life_lang::parser::Parser parser(diag);
+  auto const type_name = parser.parse_type_name();
+  REQUIRE(type_name.has_value());
+  return ctx_.resolve_type_name(module_, *type_name);
+}
+
+}  // namespace
+
+TEST_SUITE("Incremental Update") {
+  TEST_CASE("Only the changed file is parsed again") {
+    Update_Fixture const fixture;
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    REQUIRE(ctx.load_modules(fixture.temp_src));
+    REQUIRE(resolve_type(ctx, "App", "Point").has_value());
+    auto const files_before = diag_mgr.registry().file_count();
+    REQUIRE(ctx.find_type_def("Geometry", "Point") != nullptr);
+    File_Id const point_file = ctx.find_type_def("Geometry", "Point")->span.file;
+
+    auto const point = fixture.write(
+        "geometry/point.life",
+        "pub struct Point { x: I32, y: I32 }\n"
+        "pub fn origin(): Point { return Point { x: 0, y: 0 }; }\n"
+    );
+    REQUIRE(ctx.update({point}));
+    CHECK_FALSE(diag_mgr.has_errors());
+    CHECK(diag_mgr.registry().file_count() == files_before);  // point.life's new text replaced the old one
+
+    REQUIRE(ctx.find_func_def("Geometry", "origin") != nullptr);
+    CHECK(ctx.find_func_def("Geometry", "origin")->span.file == point_file);
+    CHECK(diag_mgr.registry().get_line(point_file, 2).starts_with("pub fn origin()"));
+    CHECK(ctx.find_type_def("Geometry", "Circle") != nullptr);
+
+    // The dependent's import now binds to the new definition
+    auto const resolved = resolve_type(ctx, "App", "Point");
+    REQUIRE(resolved.has_value());
+    CHECK(resolved->second == ctx.find_type_def("Geometry", "Point"));
+  }
+
+  TEST_CASE("Repeated updates of a file don't grow the registry") {
+    Update_Fixture const fixture;
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    REQUIRE(ctx.load_modules(fixture.temp_src));
+    auto const files_before = diag_mgr.registry().file_count();
+
+    for (int i = 0; i < 5; ++i) {
+      auto const source =
+          "pub struct Point { x: I32, y: I32 }\npub fn f" + std::to_string(i) + "(): I32 { return 0; }\n";
+      REQUIRE(ctx.update({fixture.write("geometry/point.life", source)}));
+    }
+    CHECK(diag_mgr.registry().file_count() == files_before);
+    CHECK(ctx.find_func_def("Geometry", "f4") != nullptr);
+    CHECK(ctx.find_func_def("Geometry", "f3") == nullptr);
+  }
+
+  TEST_CASE("Resolution caches of dependents are refreshed") {
+    Update_Fixture const fixture;
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    REQUIRE(ctx.load_modules(fixture.temp_src));
+    REQUIRE(resolve_type(ctx, "App", "Point").has_value());
+    REQUIRE(resolve_type(ctx, "App", "Geometry.Circle").has_value());
+
+    REQUIRE(ctx.update({fixture.write("geometry/point.life", "struct Point { x: I32, y: I32 }\n")}));
+    CHECK_FALSE(resolve_type(ctx, "App", "Point").has_value());
+    CHECK(diag_mgr.all_diagnostics().back().message == "cannot import 'Point' from module 'Geometry' - not marked pub");
+
+    REQUIRE(ctx.update({fixture.write("geometry/shapes.life", "pub struct Square { side: F64 }\n")}));
+    CHECK_FALSE(resolve_type(ctx, "App", "Geometry.Circle").has_value());
+    CHECK(resolve_type(ctx, "App", "Geometry.Square").has_value());
+  }
+
+  TEST_CASE("Edits that keep the defined names keep resolutions") {
+    Update_Fixture const fixture;
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    REQUIRE(ctx.load_modules(fixture.temp_src));
+    CHECK_FALSE(resolve_type(ctx, "App", "Missing").has_value());
+    CHECK(diag_mgr.all_diagnostics().size() == 1);
+
+    // Field and body edits: the miss is neither recomputed nor reported again
+    REQUIRE(ctx.update({fixture.write("geometry/point.life", "pub struct Point { x: F64, y: F64 }\n")}));
+    REQUIRE(ctx.update({fixture.write(
+        "app/main.life", "import Geometry.{ Point };\npub fn main(): I32 { return 1; }\n"
+    )}));
+    CHECK_FALSE(resolve_type(ctx, "App", "Missing").has_value());
+    CHECK(diag_mgr.all_diagnostics().size() == 1);
+
+    // A kept resolution still points at the current definition
+    auto const point = resolve_type(ctx, "App", "Point");
+    REQUIRE(point.has_value());
+    CHECK(point->second == ctx.find_type_def("Geometry", "Point"));
+
+    REQUIRE(ctx.update({fixture.write(
+        "app/main.life", "import Geometry.{ Point };\nstruct Missing {}\npub fn main(): I32 { return 1; }\n"
+    )}));
+    auto const missing = resolve_type(ctx, "App", "Missing");
+    REQUIRE(missing.has_value());
+    CHECK(missing->second == ctx.find_type_def("App", "Missing"));
+  }
+
+  TEST_CASE("Modules appear and empty out as their files come and go") {
+    Update_Fixture const fixture;
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    REQUIRE(ctx.load_modules(fixture.temp_src));
+    CHECK(ctx.get_module("Lib") == nullptr);
+
+    auto const lib = fixture.write("lib/lib.life", "pub fn helper(): I32 { return 1; }\n");
+    auto const readme = fixture.write("lib/README.md", "not a module file");
+    REQUIRE(ctx.update({lib, readme}));
+    CHECK(ctx.find_func_def("Lib", "helper") != nullptr);
+    CHECK(ctx.dependency_order().size() == 3);
+
+    fs::remove(lib);
+    REQUIRE(ctx.update({lib}));
+    REQUIRE(ctx.get_module("Lib") != nullptr);
+    CHECK(ctx.get_module("Lib")->items.empty());
+    CHECK(ctx.find_func_def("Lib", "helper") == nullptr);
+  }
+
+  TEST_CASE("A failed update keeps the previous modules") {
+    Update_Fixture const fixture;
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    REQUIRE(ctx.load_modules(fixture.temp_src));
+
+    CHECK_FALSE(ctx.update({fixture.write("geometry/point.life", "pub struct Point {\n")}));
+    CHECK(diag_mgr.has_errors());
+    CHECK(ctx.find_type_def("Geometry", "Point") != nullptr);
+    CHECK(resolve_type(ctx, "App", "Point").has_value());
+
+    // Duplicate definitions across an unchanged and a changed file are still caught
+    diag_mgr.clear_diagnostics();
+    CHECK_FALSE(ctx.update({fixture.write("geometry/point.life", "pub struct Circle { r: F64 }\n")}));
+    CHECK(diag_mgr.all_diagnostics().back().message.starts_with("duplicate definition of 'Circle'"));
+  }
+
+  TEST_CASE("Update needs an earlier load") {
+    Update_Fixture const fixture;
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    CHECK_FALSE(ctx.update({fixture.temp_src / "geometry" / "point.life"}));
+    CHECK(diag_mgr.has_errors());
+  }
+}
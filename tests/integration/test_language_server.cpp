@@ -0,0 +1,285 @@
+#include <doctest/doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "lsp/json.hpp"
+#include "lsp/language_server.hpp"
+#include "temp_dir.hpp"
+
+using life_lang::lsp::Json;
+using life_lang::lsp::Language_Server;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Lsp_Fixture {
+  Temp_Dir project{"language_server"};
+  fs::path point_path = project.path() / "src" / "geometry" / "point.life";
+  fs::path main_path = project.path() / "src" / "app" / "main.life";
+  std::vector<Json> sent;
+  Language_Server server{[this](std::string const& message_) { sent.push_back(*Json::parse(message_)); }};
+
+  Lsp_Fixture() {
+    fs::create_directories(point_path.parent_path());
+    fs::create_directories(main_path.parent_path());
+    std::ofstream(point_path) << "pub struct Point { x: I32, y: I32 }\n"
+                                 "pub fn origin(): Point { return Point { x: 0, y: 0 }; }\n";
+    std::ofstream(main_path) << k_main_source;
+
+    server.handle_batch({
+        request(1, "initialize", Json::Object{{"rootUri", uri(project.path())}}),
+        notification("initialized", Json::Object{}),
+    });
+    server.wait_for_index();
+    sent.clear();
+  }
+
+  Lsp_Fixture(Lsp_Fixture const&) = delete;
+  Lsp_Fixture(Lsp_Fixture&&) = delete;
+  Lsp_Fixture& operator=(Lsp_Fixture const&) = delete;
+  Lsp_Fixture& operator=(Lsp_Fixture&&) = delete;
+
+  static constexpr std::string_view k_main_source =
+      "import Geometry.{ Point, origin };\n"
+      "\n"
+      "struct Pair { a: I32, b: I32 }\n"
+      "\n"
+      "impl Pair {\n"
+      "  fn sum(self): I32 { return self.a + self.b; }\n"
+      "}\n"
+      "\n"
+      "fn main(): I32 { let p: Point = origin(); let q: Pair = Pair { a: 1, b: 2 }; return 0; }\n";
+
+  static std::string uri(fs::path const& path_) { return "file://" + path_.string(); }
+
+  static Json request(int id_, std::string method_, Json params_) {
+    return Json::Object{
+        {"jsonrpc", "2.0"}, {"id", id_}, {"method", std::move(method_)}, {"params", std::move(params_)}
+    };
+  }
+
+  static Json notification(std::string method_, Json params_) {
+    return Json::Object{{"jsonrpc", "2.0"}, {"method", std::move(method_)}, {"params", std::move(params_)}};
+  }
+
+  [[nodiscard]] Json open(fs::path const& path_, std::string_view text_) const {
+    return notification(
+        "textDocument/didOpen",
+        Json::Object{{"textDocument",
+                      Json::Object{{"uri", uri(path_)}, {"languageId", "life"}, {"version", 1}, {"text", text_}}}}
+    );
+  }
+
+  // Replace [line:character, end_line:end_character) with text_
+  [[nodiscard]] Json change(
+      fs::path const& path_,
+      int version_,
+      std::pair<int, int> start_,
+      std::pair<int, int> end_,
+      std::string text_
+  ) const {
+    Json::Object range{
+        {"start", Json::Object{{"line", start_.first}, {"character", start_.second}}},
+        {"end", Json::Object{{"line", end_.first}, {"character", end_.second}}},
+    };
+    Json::Array changes{Json::Object{{"range", std::move(range)}, {"text", std::move(text_)}}};
+    return notification(
+        "textDocument/didChange",
+        Json::Object{
+            {"textDocument", Json::Object{{"uri", uri(path_)}, {"version", version_}}},
+            {"contentChanges", std::move(changes)}
+        }
+    );
+  }
+
+  [[nodiscard]] Json at(int id_, std::string method_, fs::path const& path_, int line_, int character_) const {
+    return request(
+        id_,
+        std::move(method_),
+        Json::Object{
+            {"textDocument", Json::Object{{"uri", uri(path_)}}},
+            {"position", Json::Object{{"line", line_}, {"character", character_}}}
+        }
+    );
+  }
+
+  // The reply to request id_ among the messages sent so far
+  [[nodiscard]] Json const& reply(int id_) const {
+    for (auto const& message: sent) {
+      if (message["id"] == Json{id_}) {
+        return message;
+      }
+    }
+    FAIL("no reply to request " << id_);
+    return sent.front();
+  }
+
+  [[nodiscard]] std::vector<Json> published() const {
+    std::vector<Json> result;
+    for (auto const& message: sent) {
+      if (message["method"] == Json{"textDocument/publishDiagnostics"}) {
+        result.push_back(message["params"]);
+      }
+    }
+    return result;
+  }
+};
+
+}  // namespace
+
+TEST_SUITE("Language Server") {
+  TEST_CASE("Diagnostics follow incremental edits") {
+    Lsp_Fixture fixture;
+    fixture.server.handle_batch({fixture.open(fixture.main_path, Lsp_Fixture::k_main_source)});
+    REQUIRE(fixture.published().size() == 1);
+    CHECK(fixture.published()[0]["diagnostics"].as_array()->empty());
+
+    // Break the struct on line 3, then a burst of two edits that fix it again
+    fixture.sent.clear();
+    fixture.server.handle_batch({fixture.change(fixture.main_path, 2, {2, 29}, {2, 30}, "")});
+    auto published = fixture.published();
+    REQUIRE(published.size() == 1);
+    CHECK(published[0]["version"].as_int() == 2);
+    auto const& diagnostics = *published[0]["diagnostics"].as_array();
+    REQUIRE_FALSE(diagnostics.empty());
+    CHECK(diagnostics[0]["severity"].as_int() == 1);
+    CHECK(diagnostics[0]["range"]["start"]["line"].as_int() >= 2);
+
+    fixture.sent.clear();
+    fixture.server.handle_batch({
+        fixture.change(fixture.main_path, 3, {2, 29}, {2, 29}, "X"),
+        fixture.change(fixture.main_path, 4, {2, 29}, {2, 30}, "}"),
+    });
+    published = fixture.published();
+    REQUIRE(published.size() == 1);  // Once per batch
+    CHECK(published[0]["version"].as_int() == 4);
+    CHECK(published[0]["diagnostics"].as_array()->empty());
+  }
+
+  TEST_CASE("Positions count UTF-16 code units") {
+    Lsp_Fixture fixture;
+    fixture.server.handle_batch({
+        fixture.open(fixture.main_path, "fn f(): String { return \"\xC3\xA9\xF0\x9F\x98\x80\"; }\n"),
+    });
+    // The closing quote is at UTF-16 column 28 (é is one unit, the emoji two); put a stray token after it
+    fixture.sent.clear();
+    fixture.server.handle_batch({fixture.change(fixture.main_path, 2, {0, 29}, {0, 29}, " 1")});
+    auto const published = fixture.published();
+    REQUIRE(published.size() == 1);
+    auto const& diagnostics = *published[0]["diagnostics"].as_array();
+    REQUIRE_FALSE(diagnostics.empty());
+    CHECK(diagnostics[0]["range"]["start"]["character"].as_int() == 30);
+  }
+
+  TEST_CASE("Document symbols list the items of the open text") {
+    Lsp_Fixture fixture;
+    fixture.server.handle_batch({
+        fixture.open(fixture.main_path, Lsp_Fixture::k_main_source),
+        fixture.request(
+            2,
+            "textDocument/documentSymbol",
+            Json::Object{{"textDocument", Json::Object{{"uri", Lsp_Fixture::uri(fixture.main_path)}}}}
+        ),
+    });
+    auto const& symbols = *fixture.reply(2)["result"].as_array();
+    REQUIRE(symbols.size() == 3);
+    CHECK(symbols[0]["name"] == Json{"Pair"});
+    CHECK(symbols[0]["kind"].as_int() == 23);
+    CHECK(symbols[1]["name"] == Json{"impl Pair"});
+    CHECK(symbols[1]["children"][0]["name"] == Json{"sum"});
+    CHECK(symbols[1]["children"][0]["range"]["start"]["line"].as_int() == 5);
+    CHECK(symbols[2]["name"] == Json{"main"});
+    CHECK(symbols[2]["kind"].as_int() == 12);
+  }
+
+  TEST_CASE("Definition and hover resolve through the document and the index") {
+    Lsp_Fixture fixture;
+    fixture.server.handle_batch({
+        fixture.open(fixture.main_path, Lsp_Fixture::k_main_source),
+        fixture.at(2, "textDocument/definition", fixture.main_path, 8, 26),  // Point
+        fixture.at(3, "textDocument/definition", fixture.main_path, 8, 33),  // origin
+        fixture.at(4, "textDocument/definition", fixture.main_path, 8, 52),  // Pair, defined in the document
+        fixture.at(5, "textDocument/hover", fixture.main_path, 8, 33),
+        fixture.at(6, "textDocument/definition", fixture.main_path, 8, 12),  // I32: built in
+    });
+
+    auto const& point = fixture.reply(2)["result"];
+    CHECK(point["uri"] == Json{Lsp_Fixture::uri(fs::canonical(fixture.point_path))});
+    CHECK(point["range"]["start"]["line"].as_int() == 0);
+    CHECK(fixture.reply(3)["result"]["range"]["start"]["line"].as_int() == 1);
+    CHECK(fixture.reply(4)["result"]["uri"] == Json{Lsp_Fixture::uri(fixture.main_path)});
+    CHECK(fixture.reply(4)["result"]["range"]["start"]["line"].as_int() == 2);
+
+    auto const* hover = fixture.reply(5)["result"]["contents"]["value"].as_string();
+    REQUIRE(hover != nullptr);
+    CHECK(hover->find("pub fn origin(): Point") != std::string::npos);
+    CHECK(hover->find("module `Geometry`") != std::string::npos);
+
+    CHECK(fixture.reply(6)["result"].is_null());
+  }
+
+  TEST_CASE("Saving a file updates the index") {
+    Lsp_Fixture fixture;
+    fixture.server.handle_batch({fixture.open(fixture.main_path, Lsp_Fixture::k_main_source)});
+    std::ofstream(fixture.point_path) << "\n\npub struct Point { x: I32, y: I32 }\n";
+    fixture.server.handle_batch({
+        fixture.notification(
+            "textDocument/didSave",
+            Json::Object{{"textDocument", Json::Object{{"uri", Lsp_Fixture::uri(fixture.point_path)}}}}
+        ),
+        fixture.at(2, "textDocument/definition", fixture.main_path, 8, 26),
+        fixture.at(3, "textDocument/definition", fixture.main_path, 8, 33),
+    });
+    CHECK(fixture.reply(2)["result"]["range"]["start"]["line"].as_int() == 2);
+    CHECK(fixture.reply(3)["result"].is_null());  // origin is gone
+  }
+
+  TEST_CASE("Stale and cancelled requests are not computed") {
+    Lsp_Fixture fixture;
+    fixture.server.handle_batch({
+        fixture.open(fixture.main_path, Lsp_Fixture::k_main_source),
+        fixture.at(2, "textDocument/hover", fixture.main_path, 8, 33),
+        fixture.change(fixture.main_path, 2, {0, 0}, {0, 0}, "\n"),
+        fixture.at(3, "textDocument/hover", fixture.main_path, 9, 33),
+        fixture.at(4, "textDocument/hover", fixture.main_path, 9, 33),
+        fixture.notification("$/cancelRequest", Json::Object{{"id", 4}}),
+        fixture.request(5, "textDocument/unknown", Json::Object{}),
+    });
+    CHECK(fixture.reply(2)["error"]["code"].as_int() == -32801);  // Content modified
+    CHECK(fixture.reply(3)["result"]["contents"]["value"].as_string() != nullptr);
+    CHECK(fixture.reply(4)["error"]["code"].as_int() == -32800);  // Cancelled
+    CHECK(fixture.reply(5)["error"]["code"].as_int() == -32601);
+  }
+
+  TEST_CASE("The stdio loop frames messages and exits after shutdown") {
+    std::ostringstream input;
+    life_lang::lsp::write_message(input, R"({"jsonrpc":"2.0","id":1,"method":"initialize","params":{}})");
+    life_lang::lsp::write_message(input, R"({"jsonrpc":"2.0","id":2,"method":"shutdown"})");
+    life_lang::lsp::write_message(input, R"({"jsonrpc":"2.0","method":"exit"})");
+    life_lang::lsp::write_message(input, R"({"jsonrpc":"2.0","id":3,"method":"shutdown"})");
+    std::istringstream in{input.str()};
+    std::ostringstream out;
+    CHECK(Language_Server::run(in, out) == 0);
+
+    // Reading stopped at exit: what followed it is still in the stream, and nothing reads it anymore
+    auto const after_exit = life_lang::lsp::read_message(in);
+    REQUIRE(after_exit.has_value());
+    CHECK((*Json::parse(*after_exit))["id"].as_int() == 3);
+
+    std::istringstream replies{out.str()};
+    auto const first = life_lang::lsp::read_message(replies);
+    REQUIRE(first.has_value());
+    CHECK((*Json::parse(*first))["result"]["capabilities"]["definitionProvider"] == Json{true});
+    auto const second = life_lang::lsp::read_message(replies);
+    REQUIRE(second.has_value());
+    CHECK((*Json::parse(*second))["id"].as_int() == 2);
+    CHECK_FALSE(life_lang::lsp::read_message(replies).has_value());
+
+    std::istringstream truncated{"Content-Length: 10\r\n\r\n{}"};
+    CHECK_FALSE(life_lang::lsp::read_message(truncated).has_value());
+  }
+}
@@ -0,0 +1,296 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <span>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "diagnostics.hpp"
+#include "parser/ast.hpp"
+#include "parser/parser.hpp"
+#include "semantic/module_interface.hpp"
+#include "semantic/module_loader.hpp"
+#include "semantic/semantic_context.hpp"
+#include "temp_dir.hpp"
+#include "thread_pool.hpp"
+
+using namespace life_lang;
+using namespace life_lang::semantic;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Interface_Fixture {
+  Temp_Dir project{"module_interface"};
+  fs::path temp_src = project.path() / "src";
+  fs::path interface_dir = project.path() / "interfaces";
+
+  Interface_Fixture() {
+    fs::create_directories(temp_src / "geometry");
+    fs::create_directories(temp_src / "app");
+    write_file(temp_src / "geometry" / "point.life", k_geometry_source);
+    write_file(temp_src / "app" / "main.life", k_app_source);
+  }
+
+  Interface_Fixture(Interface_Fixture const&) = delete;
+  Interface_Fixture(Interface_Fixture&&) = delete;
+  Interface_Fixture& operator=(Interface_Fixture const&) = delete;
+  Interface_Fixture& operator=(Interface_Fixture&&) = delete;
+
+  static void write_file(fs::path const& path_, std::string_view content_) {
+    std::ofstream file(path_);
+    file << content_;
+  }
+
+  void emit() const {
+    Diagnostic_Manager diagnostics;
+    Thread_Pool pool{2};
+    REQUIRE(emit_module_interfaces(temp_src, interface_dir, diagnostics, pool));
+    REQUIRE_FALSE(diagnostics.has_errors());
+  }
+
+  static constexpr std::string_view k_geometry_source = R"(
+pub trait Display { fn to_string(self): String; }
+pub struct Point { x: I32, y: I32 }
+struct Scratch { n: I32 }
+pub type Coord = I32;
+pub fn origin(): Point { return Point { x: 0, y: 0 }; }
+fn helper(): I32 { return 1; }
+
+impl Point {
+  pub fn norm(self): I32 { return self.x * self.x + self.y * self.y; }
+  fn secret(self): I32 { return 0; }
+}
+
+impl Display for Point {
+  fn to_string(self): String { return "point"; }
+}
+)";
+
+  static constexpr std::string_view k_app_source = R"(
+import Geometry.{Point, origin};
+
+pub fn main(): I32 { let p: Point = origin(); return 0; }
+)";
+};
+
+ast::Func_Def const& func_of(ast::Item const* item_) {
+  REQUIRE(item_ != nullptr);
+  auto const* func = std::get_if<std::shared_ptr<ast::Func_Def>>(&item_->item);
+  REQUIRE(func != nullptr);
+  return **func;
+}
+
+// Resolve a type name as written in module_
+std::optional<std::pair<std::string, ast::Item const*>>
+resolve_type(Semantic_Context const& ctx_, std::string const& module_, std::string source_) {
+  Source_File_Registry registry;
+  File_Id const file_id = registry.register_file("<test>", std::move(source_));
+  Diagnostic_Engine diag{registry, file_id};
+  parser::Parser parser(diag);
+  auto const type_name = parser.parse_type_name();
+  REQUIRE(type_name.has_value());
+  return ctx_.resolve_type_name(module_, *type_name);
+}
+
+}  // namespace
+
+TEST_SUITE("Module Interfaces") {
+  TEST_CASE("An interface keeps the pub surface and drops bodies and private definitions") {
+    Interface_Fixture const fixture;
+    auto const descriptor = Module_Loader::locate_module(fixture.temp_src, {"Geometry"});
+    REQUIRE(descriptor.has_value());
+    Diagnostic_Manager diagnostics;
+    auto const module = Module_Loader::load_module(*descriptor, diagnostics);
+    REQUIRE(module.has_value());
+    REQUIRE(module->items.size() == 8);
+
+    auto const interface = module_interface(*module);
+    CHECK(interface.imports.size() == module->imports.size());
+    REQUIRE(interface.items.size() == 8);  // Display, Point, Scratch, Coord, origin, helper, both impls
+    CHECK(std::ranges::count(interface.items, false, &ast::Item::is_pub) == 4);  // Scratch, helper, both impls
+    for (auto const& item: interface.items) {
+      if (auto const* func = std::get_if<std::shared_ptr<ast::Func_Def>>(&item.item)) {
+        CHECK(((*func)->declaration.name == "origin") == item.is_pub);
+        CHECK((*func)->body.statements.empty());
+      } else if (auto const* def = std::get_if<std::shared_ptr<ast::Struct_Def>>(&item.item)) {
+        CHECK((*def)->fields.empty() == !item.is_pub);  // Scratch keeps only its name
+      } else if (auto const* impl = std::get_if<std::shared_ptr<ast::Impl_Block>>(&item.item)) {
+        REQUIRE((*impl)->methods.size() == 1);  // Only the pub method
+        CHECK((*impl)->methods.front().declaration.name == "norm");
+        CHECK((*impl)->methods.front().body.statements.empty());
+      } else if (auto const* trait_impl = std::get_if<std::shared_ptr<ast::Trait_Impl>>(&item.item)) {
+        REQUIRE((*trait_impl)->methods.size() == 1);
+        CHECK((*trait_impl)->methods.front().body.statements.empty());
+      } else {
+        CHECK(item.is_pub);
+      }
+    }
+
+    // The original module is untouched (no nodes shared)
+    CHECK_FALSE(func_of(&module->items[4]).body.statements.empty());
+  }
+
+  TEST_CASE("lifec --emit-interfaces writes one up-to-date file per module") {
+    Interface_Fixture const fixture;
+    Interface_Fixture::write_file(fixture.temp_src / "geometry" / "shapes.life", "pub struct Circle { r: I32 }\n");
+    fixture.emit();
+    auto const path = interface_file_path(fixture.interface_dir, "Geometry");
+    CHECK(path.filename() == "Geometry.lli");
+    REQUIRE(fs::exists(path));
+    CHECK(fs::exists(interface_file_path(fixture.interface_dir, "App")));
+
+    auto const descriptor = Module_Loader::locate_module(fixture.temp_src, {"Geometry"});
+    REQUIRE(descriptor.has_value());
+    auto const hash = module_content_hash(*descriptor);
+    REQUIRE(hash.has_value());
+    REQUIRE(descriptor->files.size() == 2);
+
+    // Each file's definitions come back stamped with that file's id
+    std::array<File_Id, 2> const files{7, 9};
+    std::size_t const shapes_index = descriptor->files[0].filename() == "shapes.life" ? 0 : 1;
+    auto const interface = read_interface_file(path, *hash, files);
+    REQUIRE(interface.has_value());
+    CHECK(interface->items.size() == 9);
+    for (auto const& item: interface->items) {
+      auto const* def = std::get_if<std::shared_ptr<ast::Struct_Def>>(&item.item);
+      bool const in_shapes = def != nullptr && (*def)->name == "Circle";
+      CHECK(item.span.file == (in_shapes ? files[shapes_index] : files[1 - shapes_index]));
+    }
+    CHECK_FALSE(read_interface_file(path, *hash + 1, files).has_value());
+    CHECK_FALSE(read_interface_file(path, *hash, std::span{files}.first(1)).has_value());  // Written for two files
+
+    // Any edit to the module's files changes its hash
+    Interface_Fixture::write_file(fixture.temp_src / "geometry" / "point.life", "pub struct Point { x: I32 }");
+    CHECK(module_content_hash(*descriptor) != hash);
+  }
+
+  TEST_CASE("Concurrent emits into one directory leave whole interfaces") {
+    Interface_Fixture const fixture;
+    std::vector<int> failures(4, 0);
+    {
+      std::vector<std::jthread> writers;
+      for (std::size_t w = 0; w < failures.size(); ++w) {
+        writers.emplace_back([&fixture, &failures, w] {
+          for (int round = 0; round < 10; ++round) {
+            Diagnostic_Manager diagnostics;
+            Thread_Pool pool{1};
+            if (!emit_module_interfaces(fixture.temp_src, fixture.interface_dir, diagnostics, pool)) {
+              ++failures[w];
+            }
+          }
+        });
+      }
+    }
+    CHECK(std::ranges::count(failures, 0) == static_cast<std::ptrdiff_t>(failures.size()));
+
+    // Only the interfaces themselves are left, and each reads back whole
+    for (auto const& entry: fs::directory_iterator(fixture.interface_dir)) {
+      CHECK(entry.path().extension() == k_interface_extension);
+    }
+    auto const descriptor = Module_Loader::locate_module(fixture.temp_src, {"Geometry"});
+    REQUIRE(descriptor.has_value());
+    auto const hash = module_content_hash(*descriptor);
+    REQUIRE(hash.has_value());
+    std::array<File_Id, 1> const files{1};
+    auto const path = interface_file_path(fixture.interface_dir, "Geometry");
+    CHECK(read_interface_file(path, *hash, files).has_value());
+  }
+
+  TEST_CASE("Semantic_Context loads dependencies from up-to-date interfaces") {
+    Interface_Fixture const fixture;
+    fixture.emit();
+
+    Diagnostic_Manager diagnostics;
+    Semantic_Context context(diagnostics);
+    context.set_interface_dir(fixture.interface_dir);
+    REQUIRE(context.load_reachable_modules(fixture.temp_src, {"App"}));
+    CHECK_FALSE(diagnostics.has_errors());
+
+    // The dependency has only its surface...
+    CHECK(context.find_type_def("Geometry", "Point") != nullptr);
+    CHECK(func_of(context.find_func_def("Geometry", "origin")).body.statements.empty());
+    CHECK(func_of(context.find_func_def("Geometry", "helper")).body.statements.empty());
+    CHECK(context.find_method_def("Geometry", "Point", "norm") != nullptr);
+    CHECK(context.find_method_def("Geometry", "Point", "secret") == nullptr);
+    CHECK(context.find_method_def("Geometry", "Point", "to_string") != nullptr);
+
+    // ...while the entry module is always parsed in full
+    CHECK_FALSE(func_of(context.find_func_def("App", "main")).body.statements.empty());
+  }
+
+  TEST_CASE("Stale or missing interfaces fall back to parsing the sources") {
+    Interface_Fixture const fixture;
+    fixture.emit();
+    Interface_Fixture::write_file(
+        fixture.temp_src / "geometry" / "point.life",
+        std::string{Interface_Fixture::k_geometry_source} + "fn added(): I32 { return 2; }\n"
+    );
+
+    {
+      Diagnostic_Manager diagnostics;
+      Semantic_Context context(diagnostics);
+      context.set_interface_dir(fixture.interface_dir);
+      REQUIRE(context.load_reachable_modules(fixture.temp_src, {"App"}));
+      CHECK(context.find_func_def("Geometry", "added") != nullptr);
+      CHECK_FALSE(func_of(context.find_func_def("Geometry", "helper")).body.statements.empty());
+    }
+
+    fs::remove_all(fixture.interface_dir);
+    Diagnostic_Manager diagnostics;
+    Semantic_Context context(diagnostics);
+    context.set_interface_dir(fixture.interface_dir);
+    REQUIRE(context.load_reachable_modules(fixture.temp_src, {"App"}));
+    CHECK_FALSE(func_of(context.find_func_def("Geometry", "helper")).body.statements.empty());
+  }
+
+  TEST_CASE("Importing a private name through an interface is reported as not pub") {
+    Interface_Fixture const fixture;
+    Interface_Fixture::write_file(
+        fixture.temp_src / "app" / "main.life", "import Geometry.{Scratch};\npub fn main(): I32 { return 0; }\n"
+    );
+    fixture.emit();
+
+    Diagnostic_Manager diagnostics;
+    Semantic_Context context(diagnostics);
+    context.set_interface_dir(fixture.interface_dir);
+    REQUIRE(context.load_reachable_modules(fixture.temp_src, {"App"}));
+    auto const* scratch = context.find_type_def("Geometry", "Scratch");
+    REQUIRE(scratch != nullptr);
+    CHECK_FALSE(scratch->is_pub);
+
+    CHECK_FALSE(resolve_type(context, "App", "Scratch").has_value());
+    REQUIRE_FALSE(diagnostics.all_diagnostics().empty());
+    auto const& message = diagnostics.all_diagnostics().back().message;
+    CHECK(message == "cannot import 'Scratch' from module 'Geometry' - not marked pub");
+  }
+
+  TEST_CASE("Diagnostics about an interface-loaded module point into its .life files") {
+    Interface_Fixture const fixture;
+    Interface_Fixture::write_file(
+        fixture.temp_src / "geometry" / "point.life",
+        "import App.{main};\n" + std::string{Interface_Fixture::k_geometry_source}
+    );
+    fixture.emit();
+
+    Diagnostic_Manager diagnostics;
+    Semantic_Context context(diagnostics);
+    context.set_interface_dir(fixture.interface_dir);
+    CHECK_FALSE(context.load_reachable_modules(fixture.temp_src, {"App"}));
+    REQUIRE(diagnostics.has_errors());
+
+    // The cycle runs through Geometry's import, quoted from point.life rather than the .lli
+    std::ostringstream out;
+    diagnostics.print(out);
+    CHECK(out.str().find("point.life:1:1") != std::string::npos);
+    CHECK(out.str().find("import App.{main};") != std::string::npos);
+    CHECK(out.str().find(".lli") == std::string::npos);
+  }
+}
@@ -1,11 +1,16 @@
 #include <doctest/doctest.h>
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
+#include <format>
 #include <fstream>
 
 #include "diagnostics.hpp"
 #include "parser/ast.hpp"
+#include "parser/sexp.hpp"
 #include "semantic/module_loader.hpp"
+#include "thread_pool.hpp"
 
 using namespace life_lang;
 using namespace life_lang::semantic;
@@ -248,6 +253,30 @@ pub struct Point { a: F64, b: F64 }
     CHECK(diag_mgr.has_errors());
   }
 
+  TEST_CASE("Every duplicate across files is reported against its first definition") {
+    Module_Loading_Fixture const fixture;
+
+    auto const utils_dir = fixture.temp_src / "utils";
+    fs::create_directories(utils_dir);
+
+    Module_Loading_Fixture::write_file(utils_dir / "a.life", "pub fn one(): I32 { return 1; }\nstruct Two { x: I32 }");
+    Module_Loading_Fixture::write_file(utils_dir / "b.life", "fn three(): I32 { return 3; }\nfn one(): I32 {}");
+    Module_Loading_Fixture::write_file(utils_dir / "c.life", "type Two = I32;\nfn three(): I32 { return 0; }");
+
+    auto const modules = Module_Loader::discover_modules(fixture.temp_src);
+    REQUIRE(modules.size() == 1);
+
+    life_lang::Diagnostic_Manager diag_mgr;
+    auto const module_opt = Module_Loader::load_module(modules[0], diag_mgr);
+
+    CHECK_FALSE(module_opt.has_value());
+    auto const& errors = diag_mgr.all_diagnostics();
+    REQUIRE(errors.size() == 3);
+    CHECK(errors[0].message == "duplicate definition of 'one' - first defined in a.life");
+    CHECK(errors[1].message == "duplicate definition of 'Two' - first defined in a.life");
+    CHECK(errors[2].message == "duplicate definition of 'three' - first defined in b.life");
+  }
+
   TEST_CASE("Same name struct and function is allowed") {
     // In life-lang, functions and types have separate namespaces
     // So "struct Foo" and "fn Foo" should not conflict
@@ -271,4 +300,187 @@ pub struct Point { a: F64, b: F64 }
     CHECK_FALSE(module_opt.has_value());
     CHECK(diag_mgr.has_errors());
   }
+
+  TEST_CASE("Parallel load matches sequential load") {
+    Module_Loading_Fixture const fixture;
+
+    for (int module = 0; module < 6; ++module) {
+      auto const dir = fixture.temp_src / std::format("mod_{}", module);
+      fs::create_directories(dir);
+      for (int file = 0; file < 5; ++file) {
+        Module_Loading_Fixture::write_file(
+            dir / std::format("f{}.life", file),
+            std::format("pub fn func_{}_{}(): I32 {{ return {}; }}\n", module, file, module * 10 + file)
+        );
+      }
+    }
+    // A parse error in one module and a duplicate in a later one
+    Module_Loading_Fixture::write_file(fixture.temp_src / "mod_3" / "bad.life", "fn broken( {");
+    Module_Loading_Fixture::write_file(fixture.temp_src / "mod_4" / "dup.life", "fn func_4_0(): I32 { return 0; }");
+
+    auto const descriptors = Module_Loader::discover_modules(fixture.temp_src);
+    REQUIRE(descriptors.size() == 6);
+
+    life_lang::Diagnostic_Manager sequential_diagnostics;
+    std::vector<std::optional<ast::Module>> sequential;
+    for (auto const& descriptor: descriptors) {
+      sequential.push_back(Module_Loader::load_module(descriptor, sequential_diagnostics));
+      if (!sequential.back()) {
+        break;
+      }
+    }
+    sequential.resize(descriptors.size());
+
+    Thread_Pool pool{4};
+    life_lang::Diagnostic_Manager parallel_diagnostics;
+    auto const parallel = Module_Loader::load_modules(descriptors, parallel_diagnostics, pool);
+
+    REQUIRE(parallel.size() == descriptors.size());
+    for (std::size_t i = 0; i < descriptors.size(); ++i) {
+      CAPTURE(descriptors[i].module_path_string());
+      REQUIRE(parallel[i].has_value() == sequential[i].has_value());
+      if (parallel[i]) {
+        CHECK(ast::to_sexp_string(*parallel[i], 0) == ast::to_sexp_string(*sequential[i], 0));
+      }
+    }
+
+    // Parse errors of the failing module are reported, in the same order and with the same File_Ids
+    // for the files that were read before it
+    auto const& expected = sequential_diagnostics.all_diagnostics();
+    auto const& actual = parallel_diagnostics.all_diagnostics();
+    REQUIRE(actual.size() == expected.size());
+    CHECK_FALSE(actual.empty());
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+      CHECK(actual[i].message == expected[i].message);
+      CHECK(actual[i].range.start == expected[i].range.start);
+      CHECK(parallel_diagnostics.registry().get_path(actual[i].range.file) ==
+            sequential_diagnostics.registry().get_path(expected[i].range.file));
+    }
+  }
+
+  TEST_CASE("Parallel load registers files in descriptor order") {
+    Module_Loading_Fixture const fixture;
+    for (auto const* name: {"alpha", "beta", "gamma"}) {
+      fs::create_directories(fixture.temp_src / name);
+      Module_Loading_Fixture::write_file(fixture.temp_src / name / "a.life", "fn a(): I32 { return 1; }");
+      Module_Loading_Fixture::write_file(fixture.temp_src / name / "b.life", "fn b(): I32 { return 2; }");
+    }
+
+    auto const descriptors = Module_Loader::discover_modules(fixture.temp_src);
+    Thread_Pool pool{3};
+    life_lang::Diagnostic_Manager diag_mgr;
+    auto const modules = Module_Loader::load_modules(descriptors, diag_mgr, pool);
+
+    File_Id expected_id = 1;
+    for (std::size_t i = 0; i < descriptors.size(); ++i) {
+      REQUIRE(modules[i].has_value());
+      for (std::size_t file = 0; file < descriptors[i].files.size(); ++file) {
+        CHECK(diag_mgr.registry().get_path(expected_id) == descriptors[i].files[file].string());
+        CHECK(modules[i]->items[file].span.file == expected_id);
+        ++expected_id;
+      }
+    }
+  }
+
+  TEST_CASE("Parallel discovery matches sequential discovery") {
+    Module_Loading_Fixture const fixture;
+    for (auto const* dir: {"std", "std/collections", "std/io", "geometry", "geometry/shapes/round", "empty/dir"}) {
+      fs::create_directories(fixture.temp_src / dir);
+    }
+    for (auto const* file: {"main.life", "std/b.life", "std/a.life", "std/collections/vec.life", "std/io/file.life",
+                            "geometry/point.life", "geometry/shapes/round/circle.life", "std/notes.txt"}) {
+      Module_Loading_Fixture::write_file(fixture.temp_src / file, "");
+    }
+
+    auto const sequential = Module_Loader::discover_modules(fixture.temp_src);
+    Thread_Pool pool{4};
+    auto const parallel =
+        Module_Loader::discover_modules(fixture.temp_src, Discovery_Options{.pool = &pool, .manifest_path = {}});
+
+    std::vector<std::string> paths;
+    for (auto const& module: sequential) {
+      paths.push_back(module.module_path_string());
+    }
+    CHECK(
+        paths == std::vector<std::string>{"", "Geometry", "Geometry.Shapes.Round", "Std", "Std.Collections", "Std.Io"}
+    );
+
+    REQUIRE(parallel.size() == sequential.size());
+    for (std::size_t i = 0; i < sequential.size(); ++i) {
+      CHECK(parallel[i].path == sequential[i].path);
+      CHECK(parallel[i].directory == sequential[i].directory);
+      CHECK(parallel[i].files == sequential[i].files);
+    }
+
+    // Files are sorted by name within a module
+    auto const& std_module = sequential[3];
+    REQUIRE(std_module.files.size() == 2);
+    CHECK(std_module.files[0].filename() == "a.life");
+    CHECK(std_module.files[1].filename() == "b.life");
+  }
+
+  TEST_CASE("Discovery manifest skips the walk for an unchanged tree") {
+    Module_Loading_Fixture const fixture;
+    fs::create_directories(fixture.temp_src / "geometry");
+    Module_Loading_Fixture::write_file(fixture.temp_src / "geometry" / "point.life", "");
+    auto const manifest = fixture.temp_project / "modules.manifest";
+    Discovery_Options const options{.pool = nullptr, .manifest_path = manifest};
+
+    auto const first = Module_Loader::discover_modules(fixture.temp_src, options);
+    REQUIRE(first.size() == 1);
+    REQUIRE(fs::exists(manifest));
+
+    // Plant an entry only the manifest knows about: it is reported while no directory changed
+    {
+      std::ofstream out(manifest, std::ios::app);
+      out << "file ghost.life\n";
+    }
+    auto const cached = Module_Loader::discover_modules(fixture.temp_src, options);
+    REQUIRE(cached.size() == 1);
+    CHECK(cached[0].files.size() == 2);
+
+    // Adding a file changes the directory mtime: the tree is walked again and the manifest rewritten
+    Module_Loading_Fixture::write_file(fixture.temp_src / "geometry" / "line.life", "");
+    fs::last_write_time(
+        fixture.temp_src / "geometry", fs::last_write_time(fixture.temp_src / "geometry") + std::chrono::seconds{1}
+    );
+    auto const rewalked = Module_Loader::discover_modules(fixture.temp_src, options);
+    REQUIRE(rewalked.size() == 1);
+    REQUIRE(rewalked[0].files.size() == 2);
+    CHECK(rewalked[0].files[0].filename() == "line.life");
+    CHECK(rewalked[0].files[1].filename() == "point.life");
+
+    // A manifest for another root is ignored
+    Module_Loading_Fixture::write_file(manifest, "life-lang-manifest 1\nroot /somewhere/else\n");
+    CHECK(Module_Loader::discover_modules(fixture.temp_src, options).size() == 1);
+  }
+
+  TEST_CASE("Locate a module without walking the tree") {
+    Module_Loading_Fixture const fixture;
+    fs::create_directories(fixture.temp_src / "std" / "collections");
+    fs::create_directories(fixture.temp_src / "userProfile");
+    fs::create_directories(fixture.temp_src / "empty");
+    Module_Loading_Fixture::write_file(fixture.temp_src / "std" / "collections" / "vec.life", "");
+    Module_Loading_Fixture::write_file(fixture.temp_src / "std" / "collections" / "map.life", "");
+    Module_Loading_Fixture::write_file(fixture.temp_src / "userProfile" / "profile.life", "");
+
+    // Same descriptor as discovery produces
+    auto const discovered = Module_Loader::discover_modules(fixture.temp_src);
+    auto const located = Module_Loader::locate_module(fixture.temp_src, {"Std", "Collections"});
+    REQUIRE(located.has_value());
+    auto const it = std::ranges::find(discovered, located->path, &Module_Descriptor::path);
+    REQUIRE(it != discovered.end());
+    CHECK(located->directory == it->directory);
+    CHECK(located->files == it->files);
+
+    // Directory names that aren't the lowercase spelling are still found
+    auto const profile = Module_Loader::locate_module(fixture.temp_src, {"Userprofile"});
+    REQUIRE(profile.has_value());
+    CHECK(profile->directory.filename() == "userProfile");
+
+    CHECK_FALSE(Module_Loader::locate_module(fixture.temp_src, {"Std"}).has_value());    // No .life files
+    CHECK_FALSE(Module_Loader::locate_module(fixture.temp_src, {"Empty"}).has_value());  // No .life files
+    CHECK_FALSE(Module_Loader::locate_module(fixture.temp_src, {"Missing"}).has_value());
+    CHECK_FALSE(Module_Loader::locate_module(fixture.temp_src, {}).has_value());
+  }
 }
@@ -0,0 +1,197 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+#include "diagnostics.hpp"
+#include "parser/ast.hpp"
+#include "parser/parser.hpp"
+#include "parser/sexp.hpp"
+#include "semantic/module_loader.hpp"
+#include "semantic/parse_cache.hpp"
+#include "semantic/semantic_context.hpp"
+#include "temp_dir.hpp"
+
+using namespace life_lang;
+using namespace life_lang::semantic;
+namespace fs = std::filesystem;
+
+namespace {
+
+ast::Module parse_source(std::string source_) {
+  Source_File_Registry registry;
+  File_Id const file_id = registry.register_file("sample.life", std::move(source_));
+  Diagnostic_Engine diagnostics{registry, file_id};
+  parser::Parser parser{diagnostics};
+  auto module = parser.parse_module();
+  REQUIRE(module.has_value());
+  REQUIRE(diagnostics.diagnostics().empty());
+  return std::move(*module);
+}
+
+struct Parse_Cache_Fixture {
+  Temp_Dir project{"parse_cache"};
+  fs::path temp_src = project.path() / "src";
+  fs::path cache_dir = project.path() / "cache";
+
+  Parse_Cache_Fixture() { fs::create_directories(temp_src / "geometry"); }
+
+  Parse_Cache_Fixture(Parse_Cache_Fixture const&) = delete;
+  Parse_Cache_Fixture(Parse_Cache_Fixture&&) = delete;
+  Parse_Cache_Fixture& operator=(Parse_Cache_Fixture const&) = delete;
+  Parse_Cache_Fixture& operator=(Parse_Cache_Fixture&&) = delete;
+
+  static void write_file(fs::path const& path_, std::string_view content_) {
+    std::ofstream file(path_);
+    file << content_;
+  }
+
+  [[nodiscard]] Module_Descriptor geometry() const {
+    auto descriptor = Module_Loader::locate_module(temp_src, {"Geometry"});
+    REQUIRE(descriptor.has_value());
+    return *descriptor;
+  }
+};
+
+constexpr auto k_point_source = R"(
+pub struct Point { x: I32, y: I32 }
+pub fn origin(): Point { return Point { x: 0, y: 0 }; }
+)";
+
+}  // namespace
+
+TEST_SUITE("Parse Cache") {
+  TEST_CASE("Unchanged files are loaded from the cache instead of parsed") {
+    Parse_Cache_Fixture const fixture;
+    Parse_Cache_Fixture::write_file(fixture.temp_src / "geometry" / "point.life", k_point_source);
+    Parse_Cache_Fixture::write_file(fixture.temp_src / "geometry" / "shapes.life", "pub struct Circle { r: F64 }");
+
+    std::string first_sexp;
+    {
+      Parse_Cache cache(fixture.cache_dir);
+      Diagnostic_Manager diagnostics;
+      auto const module = Module_Loader::load_module(fixture.geometry(), diagnostics, nullptr, &cache);
+      REQUIRE(module.has_value());
+      CHECK(cache.hits() == 0);
+      CHECK(cache.stores() == 2);
+      first_sexp = ast::to_sexp_string(*module, 0);
+    }
+
+    // A later run (fresh cache object, fresh registry) parses nothing
+    Parse_Cache cache(fixture.cache_dir);
+    Diagnostic_Manager diagnostics;
+    [[maybe_unused]] File_Id const unrelated = diagnostics.registry().register_file("other.life", "");
+    auto const module = Module_Loader::load_module(fixture.geometry(), diagnostics, nullptr, &cache);
+    REQUIRE(module.has_value());
+    CHECK(cache.hits() == 2);
+    CHECK(cache.stores() == 0);
+    CHECK(ast::to_sexp_string(*module, 0) == first_sexp);
+
+    // Spans point at this run's File_Ids, whose text is registered for later diagnostics
+    REQUIRE(module->items.size() == 3);
+    File_Id const point_file = module->items.front().span.file;
+    CHECK(point_file != unrelated);
+    REQUIRE(diagnostics.registry().get_file(point_file) != nullptr);
+    CHECK(diagnostics.registry().get_file(point_file)->source() == k_point_source);
+    CHECK(module->items.back().span.file != point_file);
+  }
+
+  TEST_CASE("Edited files and files with errors are parsed again") {
+    Parse_Cache_Fixture const fixture;
+    auto const file = fixture.temp_src / "geometry" / "point.life";
+    Parse_Cache_Fixture::write_file(file, k_point_source);
+
+    Parse_Cache cache(fixture.cache_dir);
+    {
+      Diagnostic_Manager diagnostics;
+      REQUIRE(Module_Loader::load_module(fixture.geometry(), diagnostics, nullptr, &cache).has_value());
+    }
+
+    Parse_Cache_Fixture::write_file(file, "pub struct Point { x: I64 }");
+    {
+      Diagnostic_Manager diagnostics;
+      auto const module = Module_Loader::load_module(fixture.geometry(), diagnostics, nullptr, &cache);
+      REQUIRE(module.has_value());
+      CHECK(cache.hits() == 0);
+      CHECK(cache.stores() == 2);
+      CHECK(ast::to_sexp_string(*module, 0).find("I64") != std::string::npos);
+    }
+
+    // A failed parse is never stored, so its errors are reported on every load
+    Parse_Cache_Fixture::write_file(file, "pub struct Point { x: }");
+    for (int run = 0; run < 2; ++run) {
+      Diagnostic_Manager diagnostics;
+      CHECK_FALSE(Module_Loader::load_module(fixture.geometry(), diagnostics, nullptr, &cache).has_value());
+      CHECK(diagnostics.has_errors());
+    }
+    CHECK(cache.stores() == 2);
+  }
+
+  TEST_CASE("Corrupt cache entries are ignored and rewritten") {
+    Parse_Cache_Fixture const fixture;
+    Parse_Cache_Fixture::write_file(fixture.temp_src / "geometry" / "point.life", k_point_source);
+
+    Parse_Cache cache(fixture.cache_dir);
+    Diagnostic_Manager diagnostics;
+    REQUIRE(Module_Loader::load_module(fixture.geometry(), diagnostics, nullptr, &cache).has_value());
+    REQUIRE(cache.stores() == 1);
+
+    for (auto const& entry: fs::directory_iterator(fixture.cache_dir)) {
+      auto const size = entry.file_size();
+      fs::resize_file(entry.path(), size - 1);
+    }
+    Diagnostic_Manager reload_diagnostics;
+    REQUIRE(Module_Loader::load_module(fixture.geometry(), reload_diagnostics, nullptr, &cache).has_value());
+    CHECK(cache.hits() == 0);
+    CHECK(cache.stores() == 2);
+  }
+
+  TEST_CASE("Eviction drops least recently used entries past the size cap") {
+    Parse_Cache_Fixture const fixture;
+    auto const module = parse_source(k_point_source);
+
+    Parse_Cache sizing(fixture.cache_dir);
+    sizing.store(1, module);
+    auto const entry_size = fs::file_size(fixture.cache_dir / "0000000000000001.ast");
+    fs::remove_all(fixture.cache_dir);
+
+    // Room for two entries
+    Parse_Cache cache(fixture.cache_dir, (2 * entry_size) + (entry_size / 2));
+    auto const now = fs::file_time_type::clock::now();
+    for (std::uint64_t key = 1; key <= 3; ++key) {
+      cache.store(key, module);
+    }
+    // Entry 2 is the oldest, then 1 (used more recently), then 3
+    fs::last_write_time(fixture.cache_dir / "0000000000000002.ast", now - std::chrono::hours{3});
+    fs::last_write_time(fixture.cache_dir / "0000000000000001.ast", now - std::chrono::hours{2});
+    fs::last_write_time(fixture.cache_dir / "0000000000000003.ast", now - std::chrono::hours{1});
+    REQUIRE(cache.load(1, 1).has_value());  // A hit refreshes entry 1
+
+    cache.evict();
+    CHECK(fs::exists(fixture.cache_dir / "0000000000000001.ast"));
+    CHECK_FALSE(fs::exists(fixture.cache_dir / "0000000000000002.ast"));
+    CHECK(fs::exists(fixture.cache_dir / "0000000000000003.ast"));
+
+    // Nothing stored since: evict() doesn't even list the directory
+    Parse_Cache_Fixture::write_file(fixture.cache_dir / "0000000000000004.ast", std::string(entry_size * 4, 'x'));
+    cache.evict();
+    CHECK(fs::exists(fixture.cache_dir / "0000000000000004.ast"));
+  }
+
+  TEST_CASE("Semantic_Context reuses the parse cache across loads") {
+    Parse_Cache_Fixture const fixture;
+    Parse_Cache_Fixture::write_file(fixture.temp_src / "geometry" / "point.life", k_point_source);
+
+    for (int run = 0; run < 2; ++run) {
+      Diagnostic_Manager diagnostics;
+      Semantic_Context context(diagnostics);
+      context.set_parse_cache(fixture.cache_dir);
+      REQUIRE(context.load_modules(fixture.temp_src));
+      CHECK(context.find_type_def("Geometry", "Point") != nullptr);
+    }
+    CHECK(fs::exists(fixture.cache_dir));
+    CHECK(std::distance(fs::directory_iterator(fixture.cache_dir), fs::directory_iterator{}) == 1);
+  }
+}
@@ -376,3 +376,69 @@ TEST_CASE("Parse Module - Anonymous Module Names") {
     CHECK(oss.str().find("<input>:") != std::string::npos);
   }
 }
+
+// ============================================================================
+// Parser Reuse Tests
+// ============================================================================
+
+TEST_CASE("Parse Module - Parser reuse with reset()") {
+  life_lang::Source_File_Registry registry;
+  life_lang::File_Id const bad_id = registry.register_file("bad.life", std::string{"fn bad("});
+  life_lang::File_Id const good_id = registry.register_file("good.life", std::string{"fn good(): I32 { return 0; }"});
+
+  life_lang::Diagnostic_Engine bad_diagnostics{registry, bad_id};
+  life_lang::Diagnostic_Engine good_diagnostics{registry, good_id};
+
+  life_lang::parser::Parser parser{bad_diagnostics};
+  REQUIRE_FALSE(parser.parse_module().has_value());
+  auto const bad_error_count = bad_diagnostics.diagnostics().size();
+  CHECK(bad_error_count > 0);
+
+  SUBCASE("Second file parses from its own start into its own engine") {
+    parser.reset(good_diagnostics);
+    auto const result = parser.parse_module();
+    REQUIRE(result.has_value());
+    CHECK(result->items.size() == 1);
+    CHECK(result->span.file == good_id);
+    CHECK_FALSE(good_diagnostics.has_errors());
+    CHECK(bad_diagnostics.diagnostics().size() == bad_error_count);
+  }
+
+  SUBCASE("Re-parsing the same file reproduces the same diagnostics") {
+    life_lang::Diagnostic_Engine again{registry, bad_id};
+    parser.reset(again);
+    REQUIRE_FALSE(parser.parse_module().has_value());
+    CHECK(again.diagnostics().size() == bad_error_count);
+  }
+}
+
+TEST_CASE("Parse Module - Invalid UTF-8 is rejected before lexing") {
+  life_lang::Source_File_Registry registry;
+  life_lang::File_Id const file_id =
+      registry.register_file("bad.life", std::string{"fn main(): () {\n  let s = \"caf\xE9\";\n}\n"});
+  life_lang::Diagnostic_Engine diagnostics{registry, file_id};
+  life_lang::parser::Parser parser{diagnostics};
+
+  CHECK_FALSE(parser.parse_module().has_value());
+  REQUIRE(diagnostics.diagnostics().size() == 1);
+  auto const& diag = diagnostics.diagnostics().front();
+  CHECK(diag.message == "Invalid UTF-8 byte sequence");
+  CHECK(diag.range.start == life_lang::Source_Position{.line = 2, .column = 15});
+  CHECK(diag.range.end == life_lang::Source_Position{.line = 2, .column = 16});
+}
+
+TEST_CASE("Parse Module - Multi-byte text in literals keeps code point columns") {
+  life_lang::Source_File_Registry registry;
+  life_lang::File_Id const file_id =
+      registry.register_file("ok.life", std::string{"fn main(): () {\n  let s = \"世界\"; let c = '🎉';\n}\n"});
+  life_lang::Diagnostic_Engine diagnostics{registry, file_id};
+  life_lang::parser::Parser parser{diagnostics};
+
+  auto const module = parser.parse_module();
+  REQUIRE(module.has_value());
+  auto const& func = std::get<std::shared_ptr<life_lang::ast::Func_Def>>(module->items.front().item);
+  REQUIRE(func->body.statements.size() == 2);
+  auto const& second = std::get<std::shared_ptr<life_lang::ast::Let_Statement>>(func->body.statements[1]);
+  CHECK(second->span.start == life_lang::Source_Position{.line = 2, .column = 17});
+  CHECK(second->span.end == life_lang::Source_Position{.line = 2, .column = 29});
+}
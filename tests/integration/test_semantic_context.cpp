@@ -3,9 +3,12 @@
 #include "diagnostics.hpp"
 #include "semantic/semantic_context.hpp"
 
+#include <algorithm>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
+#include <string>
+#include <vector>
 
 using life_lang::Diagnostic_Manager;
 using namespace life_lang::semantic;
@@ -261,6 +264,56 @@ TEST_SUITE("Semantic Context") {
     CHECK(push_method->declaration.name == "push");
   }
 
+  TEST_CASE("Find methods in trait impls") {
+    Temp_Module_Fixture const fixture;
+    fs::create_directories(fixture.temp_src / "shapes");
+    fixture.create_file(
+        "shapes/shapes.life",
+        "pub struct Point { pub x: I32 }\n"
+        "pub trait Display { fn show(self): String; fn name(self): String; }\n"
+        "\n"
+        "impl Display for Point {\n"
+        "  fn show(self): String { return \"trait\"; }\n"
+        "  fn name(self): String { return \"Point\"; }\n"
+        "}\n"
+        "\n"
+        "impl Point {\n"
+        "  pub fn show(self): String { return \"inherent\"; }\n"
+        "}\n"
+        "\n"
+        "impl<T> Display for Array<T> {\n"
+        "  fn show(self): String { return \"array\"; }\n"
+        "}\n"
+    );
+
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    REQUIRE(ctx.load_modules(fixture.temp_src));
+
+    // Trait-only method
+    auto const* name_method = ctx.find_method_def("Shapes", "Point", "name");
+    REQUIRE(name_method != nullptr);
+    CHECK(name_method->declaration.name == "name");
+
+    // Inherent method shadows the trait method even though the trait impl comes first
+    auto const* show_method = ctx.find_method_def("Shapes", "Point", "show");
+    REQUIRE(show_method != nullptr);
+    CHECK(show_method->is_pub);
+
+    // Generic trait impl is indexed by the base type name
+    CHECK(ctx.find_method_def("Shapes", "Array", "show") != nullptr);
+
+    // Enumeration: inherent methods first, then trait methods, shadowed ones included
+    auto const methods = ctx.type_methods("Shapes", "Point");
+    REQUIRE(methods.size() == 3);
+    CHECK(methods[0] == show_method);
+    CHECK(methods[1]->declaration.name == "show");
+    CHECK(methods[2] == name_method);
+
+    CHECK(ctx.type_methods("Shapes", "Missing").empty());
+    CHECK(ctx.type_methods("Missing", "Point").empty());
+  }
+
   TEST_CASE("Empty module loads successfully") {
     Temp_Module_Fixture const fixture;
     fs::create_directories(fixture.temp_src / "empty");
@@ -406,5 +459,83 @@ TEST_SUITE("Semantic Context") {
     CHECK(ctx.get_module("Base") != nullptr);
     CHECK(ctx.get_module("Middle") != nullptr);
     CHECK(ctx.get_module("Top") != nullptr);
+
+    // Dependencies come first
+    CHECK(ctx.dependency_order() == std::vector<std::string>{"Base", "Middle", "Top"});
+  }
+
+  TEST_CASE("Every independent import cycle is reported") {
+    Temp_Module_Fixture const fixture;
+
+    // Cycle 1: Alpha <-> Beta
+    fs::create_directories(fixture.temp_src / "alpha");
+    fixture.create_file("alpha/main.life", "import Beta.{ b };\npub fn a(): I32 { return 1; }\n");
+    fs::create_directories(fixture.temp_src / "beta");
+    fixture.create_file("beta/main.life", "import Alpha.{ a };\npub fn b(): I32 { return 2; }\n");
+
+    // Cycle 2: Gamma -> Delta -> Epsilon -> Gamma
+    fs::create_directories(fixture.temp_src / "gamma");
+    fixture.create_file("gamma/main.life", "import Delta.{ d };\npub fn g(): I32 { return 3; }\n");
+    fs::create_directories(fixture.temp_src / "delta");
+    fixture.create_file("delta/main.life", "import Epsilon.{ e };\npub fn d(): I32 { return 4; }\n");
+    fs::create_directories(fixture.temp_src / "epsilon");
+    fixture.create_file(
+        "epsilon/main.life",
+        "// Closes the cycle\n"
+        "import Gamma.{ g };\n"
+        "pub fn e(): I32 { return 5; }\n"
+    );
+
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    CHECK_FALSE(ctx.load_modules(fixture.temp_src));
+
+    auto const& errors = diag_mgr.all_diagnostics();
+    REQUIRE(errors.size() == 2);
+    std::vector<std::string> messages{errors[0].message, errors[1].message};
+    std::ranges::sort(messages);
+    CHECK(messages[0] == "circular import detected: Alpha -> Beta -> Alpha");
+    CHECK(messages[1] == "circular import detected: Delta -> Epsilon -> Gamma -> Delta");
+
+    // One note per further import of the cycle, pointing at that import statement
+    auto const& three_cycle = errors[0].message == messages[1] ? errors[0] : errors[1];
+    REQUIRE(three_cycle.notes.size() == 2);
+    CHECK(three_cycle.notes[0].message == "'Epsilon' imports 'Gamma' here");
+    CHECK(three_cycle.notes[0].range.start.line == 2);
+    CHECK(three_cycle.notes[1].message == "'Gamma' imports 'Delta' here");
+  }
+
+  TEST_CASE("Reachable load reads only imported modules") {
+    Temp_Module_Fixture const fixture;
+    fixture.create_file(
+        "app/main.life",
+        "import Lib.{ helper };\n"
+        "import Missing.{ x };\n"  // Unknown modules are left to name resolution
+        "pub fn main(): I32 { return 0; }\n"
+    );
+    fixture.create_file("lib/lib.life", "import Base.{ base };\npub fn helper(): I32 { return 1; }\n");
+    fixture.create_file("base/base.life", "pub fn base(): I32 { return 2; }\n");
+    fixture.create_file("unused/broken.life", "pub fn broken syntax error\n");  // Would fail a full load
+
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    REQUIRE(ctx.load_reachable_modules(fixture.temp_src, {"App"}));
+    CHECK_FALSE(diag_mgr.has_errors());
+
+    CHECK(ctx.module_paths() == std::vector<std::string>{"App", "Base", "Lib"});
+    CHECK(ctx.dependency_order() == std::vector<std::string>{"Base", "Lib", "App"});
+    CHECK(diag_mgr.registry().file_count() == 3);  // unused/broken.life was never read
+    CHECK(ctx.find_func_def("Base", "base") != nullptr);
+  }
+
+  TEST_CASE("Reachable load fails for a missing entry module") {
+    Temp_Module_Fixture const fixture;
+    fixture.create_file("app/main.life", "pub fn main(): I32 { return 0; }\n");
+
+    Diagnostic_Manager diag_mgr;
+    Semantic_Context ctx(diag_mgr);
+    CHECK_FALSE(ctx.load_reachable_modules(fixture.temp_src, {"App", "Nowhere"}));
+    REQUIRE(diag_mgr.error_count() == 1);
+    CHECK(diag_mgr.all_diagnostics()[0].message == "entry module 'Nowhere' not found");
   }
 }
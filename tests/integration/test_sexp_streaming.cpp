@@ -0,0 +1,106 @@
+#include <doctest/doctest.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "diagnostics.hpp"
+#include "parser/parser.hpp"
+#include "parser/sexp.hpp"
+#include "temp_dir.hpp"
+#include "thread_pool.hpp"
+
+using namespace life_lang;
+namespace fs = std::filesystem;
+
+namespace {
+
+ast::Module parse_source(std::string source_) {
+  Source_File_Registry registry;
+  File_Id const file_id = registry.register_file("dump.life", std::move(source_));
+  Diagnostic_Engine diagnostics{registry, file_id};
+  parser::Parser parser{diagnostics};
+  auto module = parser.parse_module();
+  REQUIRE(module.has_value());
+  REQUIRE(diagnostics.diagnostics().empty());
+  return std::move(*module);
+}
+
+// Big enough that the printer flushes many chunks mid-document
+ast::Module large_module() {
+  std::string source;
+  for (int i = 0; i < 2000; ++i) {
+    auto const n = std::to_string(i);
+    source += "fn f" + n + "(x: I32): String { if x > " + n + R"( { return "tab\there \"q\" )" + n + R"(\n"; })";
+    source += R"( return "plain )" + n + "\"; }\n";
+  }
+  return parse_source(std::move(source));
+}
+
+}  // namespace
+
+TEST_SUITE("S-Expression Streaming") {
+  TEST_CASE("Streaming to an ostream matches to_sexp_string") {
+    auto const module = large_module();
+    for (int const indent: {0, 2, 300}) {  // 300: indentation wider than the precomputed run of spaces
+      CAPTURE(indent);
+      auto const expected = ast::to_sexp_string(module, indent) + '\n';
+      REQUIRE(expected.size() > 4 * ast::detail::Sexp_Printer::k_flush_bytes);
+
+      std::ostringstream out;
+      CHECK(ast::write_sexp(out, module, indent));
+      CHECK(out.str() == expected);
+    }
+  }
+
+  TEST_CASE("Streaming to a file descriptor matches to_sexp_string") {
+    auto const module = large_module();
+    Temp_Dir const temp{"sexp_stream"};
+    auto const path = temp.path() / "stream.txt";
+    int const fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    REQUIRE(fd >= 0);
+    CHECK(ast::write_sexp(fd, module, 2));
+    ::close(fd);
+
+    std::ifstream in(path, std::ios::binary);
+    std::string const written((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    CHECK(written == ast::to_sexp_string(module, 2) + '\n');
+  }
+
+  TEST_CASE("Write failures are reported") {
+    std::ostringstream out;
+    out.setstate(std::ios::badbit);
+    CHECK_FALSE(ast::write_sexp(out, large_module(), 2));
+
+    int const read_only = ::open("/dev/null", O_RDONLY | O_CLOEXEC);
+    REQUIRE(read_only >= 0);
+    CHECK_FALSE(ast::write_sexp(read_only, parse_source("fn main(): I32 { return 0; }"), 2));
+    ::close(read_only);
+  }
+
+  TEST_CASE("Parallel rendering matches the sequential printer") {
+    Thread_Pool pool{4};
+    auto const module = large_module();
+    for (int const indent: {0, 2, 4}) {
+      CAPTURE(indent);
+      CHECK(ast::to_sexp_string(module, indent, pool) == ast::to_sexp_string(module, indent));
+    }
+
+    // Imports, and too few items to fan out
+    for (auto const* source: {"import A.{b};", "import A.{b}; fn f(): I32 { return 1; }", ""}) {
+      CAPTURE(source);
+      auto const small = parse_source(source);
+      CHECK(ast::to_sexp_string(small, 2, pool) == ast::to_sexp_string(small, 2));
+    }
+  }
+
+  TEST_CASE("Escaping copies clean runs and escapes the rest") {
+    CHECK(ast::detail::escape_string("") == R"("")");
+    CHECK(ast::detail::escape_string("plain text") == R"("plain text")");
+    CHECK(ast::detail::escape_string("a\"b\\c\nd\re\tf") == R"("a\"b\\c\nd\re\tf")");
+    CHECK(ast::detail::escape_string("\n\n") == R"("\n\n")");
+  }
+}
@@ -0,0 +1,156 @@
+#include <doctest/doctest.h>
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cancellation.hpp"
+#include "semantic/module_loader.hpp"
+#include "server/source_watcher.hpp"
+#include "temp_dir.hpp"
+
+using life_lang::Cancellation_Token;
+using life_lang::server::Source_Watcher;
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Watch_Fixture {
+  Temp_Dir project{"source_watcher"};
+  fs::path temp_src = project.path() / "src";
+
+  Watch_Fixture() {
+    write("geometry/point.life", "pub struct Point { x: I32 }\n");
+    write("app/main.life", "pub fn main(): I32 { return 0; }\n");
+    temp_src = fs::canonical(temp_src);
+  }
+
+  Watch_Fixture(Watch_Fixture const&) = delete;
+  Watch_Fixture(Watch_Fixture&&) = delete;
+  Watch_Fixture& operator=(Watch_Fixture const&) = delete;
+  Watch_Fixture& operator=(Watch_Fixture&&) = delete;
+
+  // Returns the full path of the written file (ignored by callers that only set up the tree)
+  fs::path write(fs::path const& relative_path_, std::string const& content_) const {
+    auto const full_path = temp_src / relative_path_;
+    fs::create_directories(full_path.parent_path());
+    std::ofstream file(full_path);
+    file << content_;
+    return full_path;
+  }
+};
+
+// The next batch, or an empty list if none settles within a second
+std::vector<fs::path> next_batch(Source_Watcher& watcher_) {
+  Cancellation_Token timeout;
+  timeout.set_budget(std::chrono::seconds{1});
+  return watcher_.wait_for_changes(timeout).value_or(std::vector<fs::path>{});
+}
+
+std::vector<std::string> module_paths(Source_Watcher const& watcher_) {
+  std::vector<std::string> paths;
+  for (auto const& module: watcher_.modules()) {
+    paths.push_back(module.module_path_string());
+  }
+  return paths;
+}
+
+}  // namespace
+
+TEST_SUITE("Source Watcher") {
+  TEST_CASE("Starts from the discovered modules and reports saved files") {
+    Watch_Fixture const fixture;
+    auto watcher = Source_Watcher::open(fixture.temp_src);
+    REQUIRE(watcher.has_value());
+    CHECK(module_paths(*watcher) == std::vector<std::string>{"App", "Geometry"});
+
+    auto const point = fixture.write("geometry/point.life", "pub struct Point { x: I32, y: I32 }\n");
+    CHECK(next_batch(*watcher) == std::vector{point});
+    CHECK(next_batch(*watcher).empty());  // Nothing more happened
+
+    fixture.write("geometry/notes.txt", "not a source file");
+    CHECK(next_batch(*watcher).empty());
+  }
+
+  TEST_CASE("A burst of saves settles into one batch") {
+    Watch_Fixture const fixture;
+    auto watcher = Source_Watcher::open(fixture.temp_src);
+    REQUIRE(watcher.has_value());
+
+    std::vector<fs::path> written;
+    for (int i = 0; i < 5; ++i) {
+      written.push_back(fixture.write("geometry/point.life", "pub struct Point { x: I32 }\n// " + std::to_string(i)));
+      written.push_back(fixture.write("app/main.life", "pub fn main(): I32 { return " + std::to_string(i) + "; }\n"));
+    }
+    auto const batch = next_batch(*watcher);
+    CHECK(batch == std::vector{fixture.temp_src / "app" / "main.life", fixture.temp_src / "geometry" / "point.life"});
+  }
+
+  TEST_CASE("Saving a batched file again extends the quiet period") {
+    Watch_Fixture const fixture;
+    auto watcher = Source_Watcher::open(fixture.temp_src);
+    REQUIRE(watcher.has_value());
+
+    // The same file saved four times, closer together than the quiet period: one batch, not two
+    constexpr std::chrono::milliseconds k_quiet{150};
+    std::jthread const saver{[&fixture] {
+      for (int i = 0; i < 4; ++i) {
+        fixture.write("geometry/point.life", "pub struct Point { x: I32 }\n// " + std::to_string(i));
+        std::this_thread::sleep_for(std::chrono::milliseconds{60});
+      }
+    }};
+    Cancellation_Token timeout;
+    timeout.set_budget(std::chrono::seconds{2});
+    auto const batch = watcher->wait_for_changes(timeout, k_quiet);
+    CHECK(batch == std::vector{fixture.temp_src / "geometry" / "point.life"});
+
+    Cancellation_Token second_timeout;
+    second_timeout.set_budget(std::chrono::milliseconds{500});
+    CHECK_FALSE(watcher->wait_for_changes(second_timeout, k_quiet).has_value());
+  }
+
+  TEST_CASE("Created, renamed and deleted files keep the modules current") {
+    Watch_Fixture const fixture;
+    auto watcher = Source_Watcher::open(fixture.temp_src);
+    REQUIRE(watcher.has_value());
+
+    // A new directory, with its file written right after the directory appears
+    auto const helper = fixture.write("util/strings/helper.life", "pub fn helper(): I32 { return 1; }\n");
+    CHECK(next_batch(*watcher) == std::vector{helper});
+    CHECK(module_paths(*watcher) == std::vector<std::string>{"App", "Geometry", "Util.Strings"});
+
+    // A rename reports both names; the module keeps its new file
+    auto const renamed = fixture.temp_src / "util" / "strings" / "text.life";
+    fs::rename(helper, renamed);
+    CHECK(next_batch(*watcher) == std::vector{helper, renamed});
+    auto modules = watcher->modules();
+    REQUIRE(modules.size() == 3);
+    CHECK(modules.back().files == std::vector{renamed});
+
+    // Deleting a directory reports every file it held and drops its module
+    fs::remove_all(fixture.temp_src / "util");
+    CHECK(next_batch(*watcher) == std::vector{renamed});
+    CHECK(module_paths(*watcher) == std::vector<std::string>{"App", "Geometry"});
+
+    // A tree moved in from outside src/ is picked up whole
+    auto const outside = fixture.temp_src.parent_path() / "staged";
+    fs::create_directories(outside / "net");
+    std::ofstream(outside / "net" / "socket.life") << "pub struct Socket { fd: I32 }\n";
+    fs::rename(outside, fixture.temp_src / "io");
+    CHECK(next_batch(*watcher) == std::vector{fixture.temp_src / "io" / "net" / "socket.life"});
+    CHECK(module_paths(*watcher) == std::vector<std::string>{"App", "Geometry", "Io.Net"});
+  }
+
+  TEST_CASE("Waiting ends when cancelled") {
+    Watch_Fixture const fixture;
+    auto watcher = Source_Watcher::open(fixture.temp_src);
+    REQUIRE(watcher.has_value());
+    Cancellation_Token cancelled;
+    cancelled.cancel();
+    CHECK_FALSE(watcher->wait_for_changes(cancelled).has_value());
+    CHECK_FALSE(Source_Watcher::open(fixture.temp_src / "missing").has_value());
+  }
+}
@@ -6,6 +6,7 @@
 using life_lang::Diagnostic_Engine;
 using life_lang::File_Id;
 using life_lang::Source_File_Registry;
+using life_lang::Source_Position;
 using life_lang::Source_Range;
 
 // ============================================================================
@@ -265,3 +266,137 @@ TEST_CASE("Diagnostic State Management") {
     CHECK(registry.get_path(file_id) == "<input>");
   }
 }
+
+// ============================================================================
+// Incremental Line Index Tests
+// ============================================================================
+
+namespace {
+// Line index built incrementally must match one built from scratch
+void check_same_lines(life_lang::Source_File const& incremental_, std::string const& expected_source_) {
+  life_lang::Source_File const fresh{expected_source_};
+  REQUIRE(incremental_.source() == expected_source_);
+  REQUIRE(incremental_.line_count() == fresh.line_count());
+  for (std::size_t line = 1; line <= fresh.line_count(); ++line) {
+    CHECK(incremental_.get_line(line) == fresh.get_line(line));
+    CHECK(incremental_.is_ascii_line(line) == fresh.is_ascii_line(line));
+  }
+  CHECK(incremental_.utf8_errors() == fresh.utf8_errors());
+  for (std::size_t offset = 0; offset <= expected_source_.size(); ++offset) {
+    CHECK(incremental_.offset_to_position(offset) == fresh.offset_to_position(offset));
+  }
+}
+}  // namespace
+
+TEST_CASE("Source_File incremental line index") {
+  std::string const source = "line 1\nline 2\r\nline 3\rline 4\n";
+
+  SUBCASE("Insert newlines") {
+    life_lang::Source_File file{source};
+    file.apply_edit(life_lang::Text_Edit{.offset = 3, .removed_length = 0, .inserted = "a\nb\n"});
+    check_same_lines(file, "lina\nb\ne 1\nline 2\r\nline 3\rline 4\n");
+  }
+
+  SUBCASE("Remove across lines") {
+    life_lang::Source_File file{source};
+    file.apply_edit(life_lang::Text_Edit{.offset = 2, .removed_length = 10, .inserted = ""});
+    check_same_lines(file, "li2\r\nline 3\rline 4\n");
+  }
+
+  SUBCASE("Split CRLF") {
+    life_lang::Source_File file{source};
+    file.apply_edit(life_lang::Text_Edit{.offset = 14, .removed_length = 0, .inserted = "x"});
+    check_same_lines(file, "line 1\nline 2\rx\nline 3\rline 4\n");
+  }
+
+  SUBCASE("Join CR with following LF") {
+    life_lang::Source_File file{source};
+    file.apply_edit(life_lang::Text_Edit{.offset = 22, .removed_length = 0, .inserted = "\n"});
+    check_same_lines(file, "line 1\nline 2\r\nline 3\r\nline 4\n");
+  }
+
+  SUBCASE("Edit at end clamps") {
+    life_lang::Source_File file{source};
+    file.apply_edit(life_lang::Text_Edit{.offset = 100, .removed_length = 5, .inserted = "tail"});
+    check_same_lines(file, source + "tail");
+  }
+
+  SUBCASE("set_source diffs against the previous text") {
+    life_lang::Source_File file{source};
+    file.set_source("line 1\nline two\nline 3\rline 4\n");
+    check_same_lines(file, "line 1\nline two\nline 3\rline 4\n");
+    file.set_source("");
+    check_same_lines(file, "");
+    file.set_source(source);
+    check_same_lines(file, source);
+  }
+
+  SUBCASE("position_to_offset round-trips") {
+    life_lang::Source_File const file{source};
+    for (std::size_t offset = 0; offset < source.size(); ++offset) {
+      CHECK(file.position_to_offset(file.offset_to_position(offset)) == offset);
+    }
+  }
+}
+
+// ============================================================================
+// UTF-8 Validation and Code Point Columns
+// ============================================================================
+
+TEST_CASE("Source_File UTF-8 columns") {
+  // "é" is 2 bytes, "世" is 3 bytes
+  std::string const source = "let x = 1;\nlet é = '世';\n\tlet y = 2;\n";
+  life_lang::Source_File const file{source};
+  REQUIRE(file.is_valid_utf8());
+
+  CHECK(file.is_ascii_line(1));
+  CHECK_FALSE(file.is_ascii_line(2));
+  CHECK(file.is_ascii_line(3));
+
+  SUBCASE("Columns count code points") {
+    auto const semicolon = source.find("';") + 1;
+    CHECK(file.offset_to_position(semicolon) == Source_Position{.line = 2, .column = 12});
+    CHECK(file.position_to_offset(Source_Position{.line = 2, .column = 12}) == semicolon);
+    CHECK(file.offset_to_position(source.find('=')) == Source_Position{.line = 1, .column = 7});
+  }
+
+  SUBCASE("Visual columns expand tabs and count code points") {
+    CHECK(file.visual_column(Source_Position{.line = 2, .column = 12}) == 11);
+    CHECK(file.visual_column(Source_Position{.line = 3, .column = 2}) == 8);
+    CHECK(file.visual_column(Source_Position{.line = 1, .column = 100}) == 10);
+  }
+
+  SUBCASE("Visual column of a line outside the file is 0") {
+    CHECK(file.visual_column(Source_Position{.line = 0, .column = 5}) == 0);
+    CHECK(file.visual_column(Source_Position{.line = 100, .column = 5}) == 0);
+  }
+
+  SUBCASE("position_to_offset round-trips on code point boundaries") {
+    for (std::size_t offset = 0; offset < source.size(); ++offset) {
+      if (!life_lang::is_utf8_continuation(source[offset])) {
+        CHECK(file.position_to_offset(file.offset_to_position(offset)) == offset);
+      }
+    }
+  }
+}
+
+TEST_CASE("Source_File UTF-8 validation") {
+  using life_lang::Utf8_Error;
+
+  SUBCASE("Invalid sequences are recorded at registration") {
+    life_lang::Source_File const file{"ok\nbad \xC0\xAF here\ntruncated \xE4\xB8"};
+    CHECK(file.utf8_errors() == std::vector<Utf8_Error>{{.offset = 7, .length = 2}, {.offset = 25, .length = 2}});
+  }
+
+  SUBCASE("Edits revalidate only the touched lines") {
+    std::string const source = "a\xFF\nb\nc\xFE\n";
+    life_lang::Source_File file{source};
+    file.apply_edit(life_lang::Text_Edit{.offset = 3, .removed_length = 0, .inserted = "\xE4\xB8\x96\n\x80"});
+    check_same_lines(file, "a\xFF\n\xE4\xB8\x96\n\x80" "b\nc\xFE\n");
+    file.apply_edit(life_lang::Text_Edit{.offset = 1, .removed_length = 1, .inserted = "\xC3\xA9"});
+    check_same_lines(file, "a\xC3\xA9\n\xE4\xB8\x96\n\x80" "b\nc\xFE\n");
+    file.set_source("all fine\n");
+    check_same_lines(file, "all fine\n");
+    CHECK(file.is_valid_utf8());
+  }
+}
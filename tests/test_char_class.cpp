@@ -0,0 +1,37 @@
+#include <doctest/doctest.h>
+
+#include <cctype>
+
+#include "char_class.hpp"
+
+using namespace life_lang;
+
+// The table is constexpr, so the basic classification is checked at compile time
+static_assert(is_identifier_start('_') && is_identifier_start('a') && is_identifier_start('Z'));
+static_assert(!is_identifier_start('0') && is_identifier_continue('0'));
+static_assert(is_hex_digit('f') && is_hex_digit('F') && !is_hex_digit('g'));
+static_assert(is_oct_digit('7') && !is_oct_digit('8'));
+static_assert(is_bin_digit('1') && !is_bin_digit('2'));
+static_assert(is_line_break('\n') && is_line_break('\r') && !is_line_break('\t'));
+static_assert(to_upper('a') == 'A' && to_upper('_') == '_' && to_lower('Q') == 'q');
+
+TEST_CASE("Character class table matches <cctype> in the C locale") {
+  for (int byte = 0; byte < 0x80; ++byte) {
+    auto const ch = static_cast<char>(byte);
+    CAPTURE(byte);
+    CHECK(is_upper(ch) == (std::isupper(byte) != 0));
+    CHECK(is_digit(ch) == (std::isdigit(byte) != 0));
+    CHECK(is_hex_digit(ch) == (std::isxdigit(byte) != 0));
+    CHECK(is_whitespace(ch) == (std::isspace(byte) != 0));
+    CHECK(is_identifier_start(ch) == (std::isalpha(byte) != 0 || ch == '_'));
+    CHECK(is_identifier_continue(ch) == (std::isalnum(byte) != 0 || ch == '_'));
+  }
+}
+
+TEST_CASE("Bytes outside ASCII belong to no character class") {
+  for (int byte = 0x80; byte < 0x100; ++byte) {
+    CAPTURE(byte);
+    CHECK(k_char_class_table[static_cast<std::size_t>(byte)] == 0);
+    CHECK(to_upper(static_cast<char>(byte)) == static_cast<char>(byte));
+  }
+}
@@ -0,0 +1,28 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "content_hash.hpp"
+
+using life_lang::hash_bytes;
+
+TEST_CASE("hash_bytes matches the XXH64 reference values") {
+  CHECK(hash_bytes("") == 0xEF46DB3751D8E999ULL);
+  // 39 bytes: one full 32-byte stripe, then the 4-byte and single-byte tails
+  CHECK(hash_bytes("Nobody inspects the spammish repetition") == 0xFBCEA83C8A378BF1ULL);
+}
+
+TEST_CASE("hash_bytes depends on every byte, the length and the seed") {
+  std::string text(100, 'a');
+  std::uint64_t const base = hash_bytes(text);
+  for (int const i: {0, 31, 32, 63, 96, 99}) {
+    std::string changed = text;
+    changed[static_cast<std::size_t>(i)] = 'b';
+    CHECK(hash_bytes(changed) != base);
+  }
+  CHECK(hash_bytes(std::string_view{text}.substr(0, 99)) != base);
+  CHECK(hash_bytes(text, 1) != base);
+  CHECK(hash_bytes(text) == base);  // Deterministic
+}
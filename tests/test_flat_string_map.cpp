@@ -0,0 +1,78 @@
+#include <doctest/doctest.h>
+
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "flat_string_map.hpp"
+
+using life_lang::Flat_String_Map;
+
+TEST_CASE("Flat_String_Map insert and find") {
+  Flat_String_Map<int> map;
+  CHECK(map.empty());
+  CHECK(map.find("missing") == nullptr);  // Lookup on a table that never allocated slots
+
+  auto const [value, inserted] = map.try_emplace("Point", 1);
+  CHECK(inserted);
+  CHECK(*value == 1);
+
+  auto const [existing, inserted_again] = map.try_emplace("Point", 2);
+  CHECK_FALSE(inserted_again);
+  CHECK(*existing == 1);  // try_emplace never overwrites
+
+  map["Circle"] = 3;
+  CHECK(map.size() == 2);
+  REQUIRE(map.find("Circle") != nullptr);
+  CHECK(*map.find("Circle") == 3);
+  CHECK_FALSE(map.contains("Square"));
+  CHECK_FALSE(map.contains(""));
+
+  map.clear();
+  CHECK(map.empty());
+  CHECK(map.find("Point") == nullptr);
+}
+
+TEST_CASE("Flat_String_Map lookup by string_view into a larger buffer") {
+  Flat_String_Map<int> map;
+  map.try_emplace("Geometry", 7);
+
+  // Segment views into a path, as name resolution sees them
+  std::string_view const path = "Geometry.Point";
+  CHECK(map.contains(path.substr(0, 8)));
+  CHECK_FALSE(map.contains(path.substr(0, 7)));
+  CHECK_FALSE(map.contains(path));
+}
+
+TEST_CASE("Flat_String_Map growth keeps every entry in insertion order") {
+  Flat_String_Map<std::size_t> map;
+  constexpr std::size_t k_count = 1000;
+  for (std::size_t i = 0; i < k_count; ++i) {
+    map.try_emplace("item_" + std::to_string(i), i);
+  }
+  REQUIRE(map.size() == k_count);
+
+  for (std::size_t i = 0; i < k_count; ++i) {
+    auto const* value = map.find("item_" + std::to_string(i));
+    REQUIRE(value != nullptr);
+    CHECK(*value == i);
+  }
+  CHECK(map.find("item_1000") == nullptr);
+
+  std::size_t expected = 0;
+  for (auto const& entry: map) {
+    CHECK(entry.value == expected);
+    CHECK(entry.key == "item_" + std::to_string(expected));
+    ++expected;
+  }
+}
+
+TEST_CASE("Flat_String_Map reserve does not change contents") {
+  Flat_String_Map<int> map;
+  map.try_emplace("a", 1);
+  map.reserve(100);
+  map.try_emplace("b", 2);
+  CHECK(map.size() == 2);
+  CHECK(*map.find("a") == 1);
+  CHECK(*map.find("b") == 2);
+}
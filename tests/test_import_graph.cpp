@@ -0,0 +1,96 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "semantic/import_graph.hpp"
+
+using life_lang::semantic::Import_Graph;
+using Edge = Import_Graph::Edge;
+
+TEST_CASE("Import_Graph CSR layout") {
+  Import_Graph const graph(
+      3, {{.from = 2, .to = 0, .label = 0}, {.from = 0, .to = 1, .label = 0}, {.from = 0, .to = 2, .label = 1}}
+  );
+  CHECK(graph.node_count() == 3);
+  REQUIRE(graph.out_edges(0).size() == 2);
+  CHECK(graph.out_edges(0)[0] == Edge{.from = 0, .to = 1, .label = 0});  // Input order kept per node
+  CHECK(graph.out_edges(0)[1] == Edge{.from = 0, .to = 2, .label = 1});
+  CHECK(graph.out_edges(1).empty());
+  CHECK(graph.out_edges(2).size() == 1);
+}
+
+TEST_CASE("Import_Graph components of an acyclic graph are a dependency order") {
+  // 0 -> 1 -> 2, 0 -> 2, 3 -> 1
+  Import_Graph const graph(
+      4,
+      {{.from = 0, .to = 1, .label = 0},
+       {.from = 1, .to = 2, .label = 0},
+       {.from = 0, .to = 2, .label = 1},
+       {.from = 3, .to = 1, .label = 0}}
+  );
+  auto const sccs = graph.strongly_connected_components();
+  REQUIRE(sccs.components.size() == 4);
+  for (auto const& component: sccs.components) {
+    CHECK(component.size() == 1);
+    CHECK_FALSE(graph.is_cyclic(component));
+  }
+
+  // Every edge points to an earlier component
+  auto const& rank = sccs.component_of;
+  for (Import_Graph::Node node = 0; node < 4; ++node) {
+    for (auto const& edge: graph.out_edges(node)) {
+      CHECK(rank[edge.to] < rank[edge.from]);
+    }
+  }
+}
+
+TEST_CASE("Import_Graph finds every cycle") {
+  // Cycle A: 0 -> 1 -> 2 -> 0, cycle B: 3 <-> 4, self-loop 5, and 6 depending on both cycles
+  Import_Graph const graph(
+      7,
+      {{.from = 0, .to = 1, .label = 0},
+       {.from = 1, .to = 2, .label = 0},
+       {.from = 2, .to = 0, .label = 0},
+       {.from = 3, .to = 4, .label = 0},
+       {.from = 4, .to = 3, .label = 0},
+       {.from = 5, .to = 5, .label = 7},
+       {.from = 6, .to = 0, .label = 0},
+       {.from = 6, .to = 3, .label = 1}}
+  );
+  auto const sccs = graph.strongly_connected_components();
+  auto const cyclic = std::ranges::count_if(sccs.components, [&](auto const& c_) { return graph.is_cyclic(c_); });
+  CHECK(cyclic == 3);
+  CHECK(sccs.component_of[0] == sccs.component_of[2]);
+  CHECK(sccs.component_of[3] == sccs.component_of[4]);
+  CHECK(sccs.component_of[0] != sccs.component_of[3]);
+  CHECK(sccs.component_of[6] > sccs.component_of[0]);
+  CHECK(sccs.component_of[6] > sccs.component_of[3]);
+
+  auto const cycle = graph.find_cycle(1, sccs);
+  REQUIRE(cycle.size() == 3);
+  CHECK(cycle[0] == Edge{.from = 1, .to = 2, .label = 0});
+  CHECK(cycle[1] == Edge{.from = 2, .to = 0, .label = 0});
+  CHECK(cycle[2] == Edge{.from = 0, .to = 1, .label = 0});
+
+  auto const self_loop = graph.find_cycle(5, sccs);
+  REQUIRE(self_loop.size() == 1);
+  CHECK(self_loop[0].label == 7);
+
+  CHECK(graph.find_cycle(6, sccs).empty());
+}
+
+TEST_CASE("Import_Graph handles long chains without recursion") {
+  constexpr Import_Graph::Node k_count = 100000;
+  std::vector<Edge> edges;
+  for (Import_Graph::Node i = 0; i + 1 < k_count; ++i) {
+    edges.push_back(Edge{.from = i, .to = i + 1, .label = 0});
+  }
+  edges.push_back(Edge{.from = k_count - 1, .to = 0, .label = 0});  // Close one giant cycle
+
+  Import_Graph const graph(k_count, std::move(edges));
+  auto const sccs = graph.strongly_connected_components();
+  REQUIRE(sccs.components.size() == 1);
+  CHECK(sccs.components[0].size() == k_count);
+  CHECK(graph.find_cycle(0, sccs).size() == k_count);
+}
@@ -0,0 +1,46 @@
+#include <doctest/doctest.h>
+
+#include <string>
+
+#include "lsp/json.hpp"
+
+using life_lang::lsp::Json;
+
+TEST_CASE("Json parses and prints JSON-RPC messages") {
+  auto const message = Json::parse(R"( {"jsonrpc": "2.0", "id": 7, "params": {"list": [1, -2.5, true, null]}} )");
+  REQUIRE(message.has_value());
+  CHECK((*message)["id"].as_int() == 7);
+  CHECK(*(*message)["jsonrpc"].as_string() == "2.0");
+  CHECK(*(*message)["params"]["list"][1].as_number() == -2.5);
+  CHECK(*(*message)["params"]["list"][2].as_bool());
+  CHECK((*message)["params"]["list"][3].is_null());
+
+  // Missing members and out-of-range elements read as null
+  CHECK((*message)["params"]["missing"]["deeper"].is_null());
+  CHECK((*message)["params"]["list"][9].is_null());
+  CHECK((*message)["id"]["not an object"].is_null());
+
+  // Keys come out sorted, integers without a fraction
+  CHECK(message->dump() == R"({"id":7,"jsonrpc":"2.0","params":{"list":[1,-2.5,true,null]}})");
+  CHECK(Json::parse(message->dump()) == message);
+}
+
+TEST_CASE("Json strings escape and unescape") {
+  auto const text = Json::parse(R"("tab\t quote\" slash\/ \u00e9 \ud83d\ude00 \u0001")");
+  REQUIRE(text.has_value());
+  CHECK(*text->as_string() == "tab\t quote\" slash/ \xC3\xA9 \xF0\x9F\x98\x80 \x01");
+  CHECK(text->dump() == "\"tab\\t quote\\\" slash/ \xC3\xA9 \xF0\x9F\x98\x80 \\u0001\"");
+
+  CHECK(*Json::parse(R"("\ud800")")->as_string() == "\xEF\xBF\xBD");  // Lone surrogate
+}
+
+TEST_CASE("Json rejects malformed text") {
+  CHECK_FALSE(Json::parse("").has_value());
+  CHECK_FALSE(Json::parse("{").has_value());
+  CHECK_FALSE(Json::parse(R"({"a" 1})").has_value());
+  CHECK_FALSE(Json::parse("[1,]").has_value());
+  CHECK_FALSE(Json::parse("tru").has_value());
+  CHECK_FALSE(Json::parse("1 2").has_value());
+  CHECK_FALSE(Json::parse("\"line\nbreak\"").has_value());
+  CHECK_FALSE(Json::parse(std::string(10'000, '[') + std::string(10'000, ']')).has_value());  // Too deep
+}
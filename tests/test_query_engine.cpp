@@ -0,0 +1,254 @@
+#include <doctest/doctest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "semantic/query_engine.hpp"
+
+using life_lang::semantic::Derived_Query;
+using life_lang::semantic::Input_Query;
+using life_lang::semantic::Query_Cycle_Error;
+using life_lang::semantic::Query_Engine;
+
+namespace {
+
+// text (input) -> lines -> parity: a file's line count, and whether it is even
+struct Line_Queries {
+  Query_Engine engine;
+  Input_Query<std::string, std::string> text{engine};
+  Derived_Query<std::string, std::size_t> lines{engine, [this](std::string const& file_) {
+                                                  auto const* contents = text.get(file_);
+                                                  return contents == nullptr ? std::size_t{0}
+                                                                             : static_cast<std::size_t>(
+                                                                                   std::ranges::count(*contents, '\n')
+                                                                               );
+                                                }};
+  Derived_Query<std::string, bool> even{engine, [this](std::string const& file_) {
+                                          return lines.get(file_) % 2 == 0;
+                                        }};
+};
+
+}  // namespace
+
+TEST_CASE("Query_Engine memoizes derived values") {
+  Line_Queries queries;
+  queries.text.set("a", "1\n2\n");
+
+  bool executed = false;
+  CHECK(queries.lines.get(std::string{"a"}, executed) == 2);
+  CHECK(executed);
+  CHECK(queries.lines.get(std::string{"a"}, executed) == 2);
+  CHECK_FALSE(executed);
+  CHECK(queries.engine.execution_count() == 1);
+
+  // Keys are memoized separately
+  queries.text.set("b", "1\n");
+  CHECK(queries.lines.get(std::string{"b"}) == 1);
+  CHECK(queries.engine.execution_count() == 2);
+}
+
+TEST_CASE("Query_Engine recomputes only what depends on a changed input") {
+  Line_Queries queries;
+  queries.text.set("a", "1\n");
+  queries.text.set("b", "1\n2\n");
+  CHECK_FALSE(queries.even.get(std::string{"a"}));
+  CHECK(queries.even.get(std::string{"b"}));
+  CHECK(queries.engine.execution_count() == 4);
+
+  auto const revision = queries.engine.revision();
+  queries.text.set("a", "1\n2\n3\n4\n");
+  CHECK(queries.engine.revision() == revision + 1);
+
+  // "b" is green: its input didn't change, so neither query runs again
+  bool executed = true;
+  CHECK(queries.even.get(std::string{"b"}, executed));
+  CHECK_FALSE(executed);
+  CHECK(queries.engine.execution_count() == 4);
+
+  // "a" is red all the way up
+  CHECK(queries.even.get(std::string{"a"}, executed));
+  CHECK(executed);
+  CHECK(queries.engine.execution_count() == 6);
+}
+
+TEST_CASE("Query_Engine setting an equal input keeps the revision") {
+  Line_Queries queries;
+  queries.text.set("a", "1\n");
+  auto const revision = queries.engine.revision();
+  queries.text.set("a", "1\n");
+  CHECK(queries.engine.revision() == revision);
+}
+
+TEST_CASE("Query_Engine cuts off recomputation when a value comes out equal") {
+  Line_Queries queries;
+  queries.text.set("a", "x\ny\n");
+  CHECK(queries.even.get(std::string{"a"}));
+  CHECK(queries.engine.execution_count() == 2);
+
+  // Same line count: lines runs again, but even keeps its value without running
+  queries.text.set("a", "xx\nyy\n");
+  bool executed = true;
+  CHECK(queries.even.get(std::string{"a"}, executed));
+  CHECK_FALSE(executed);
+  CHECK(queries.engine.execution_count() == 3);
+
+  // A different count with the same parity: lines changes, so even runs again
+  queries.text.set("a", "1\n2\n3\n4\n");
+  CHECK(queries.even.get(std::string{"a"}, executed));
+  CHECK(executed);
+  CHECK(queries.engine.execution_count() == 5);
+}
+
+TEST_CASE("Query_Engine reading an unset input depends on it") {
+  Line_Queries queries;
+  CHECK(queries.lines.get(std::string{"new"}) == 0);
+
+  queries.text.set("new", "1\n2\n3\n");
+  CHECK(queries.lines.get(std::string{"new"}) == 3);
+}
+
+TEST_CASE("Query_Engine reading unset inputs doesn't grow the input table") {
+  Line_Queries queries;
+  for (int i = 0; i < 100; ++i) {
+    CHECK(queries.lines.get(std::to_string(i)) == 0);
+  }
+  CHECK(queries.text.size() == 0);
+
+  // Every miss was a dependency: setting any one new key recomputes them
+  queries.text.set("7", "1\n");
+  CHECK(queries.text.size() == 1);
+  CHECK(queries.lines.get(std::string{"7"}) == 1);
+  bool executed = false;
+  CHECK(queries.lines.get(std::string{"8"}, executed) == 0);
+  CHECK(executed);
+}
+
+TEST_CASE("Query_Engine recovers from a compute that throws") {
+  Query_Engine engine;
+  Input_Query<int, int> input{engine};
+  bool fail = true;
+  Derived_Query<int, int> doubled{engine, [&](int const& n_) {
+                                    auto const* value = input.get(n_);
+                                    REQUIRE(value != nullptr);
+                                    if (fail) {
+                                      throw std::runtime_error("compute failed");
+                                    }
+                                    return 2 * *value;
+                                  }};
+  Derived_Query<int, int> outer{engine, [&](int const& n_) { return doubled.get(n_) + 1; }};
+  input.set(1, 5);
+  CHECK_THROWS_AS((void)outer.get(1), std::runtime_error);
+
+  // Neither slot is left claimed, and reads made afterwards are tracked as usual
+  fail = false;
+  CHECK(outer.get(1) == 11);
+  input.set(1, 6);
+  CHECK(outer.get(1) == 13);
+}
+
+TEST_CASE("Query_Engine reports a query that depends on itself") {
+  // loop(n) reads itself while its input is positive
+  Query_Engine engine;
+  Input_Query<int, int> input{engine};
+  Derived_Query<int, int>* loop_ptr = nullptr;
+  Derived_Query<int, int> loop{engine, [&](int const& n_) {
+                                 auto const* value = input.get(n_);
+                                 REQUIRE(value != nullptr);
+                                 return *value > 0 ? loop_ptr->get(n_) : 0;
+                               }};
+  loop_ptr = &loop;
+
+  input.set(1, 1);
+  CHECK_THROWS_AS((void)loop.get(1), Query_Cycle_Error);
+  CHECK_THROWS_AS((void)loop.get(1), Query_Cycle_Error);  // Nothing was memoized, so it is found again
+
+  // Breaking the cycle makes the value computable
+  input.set(1, 0);
+  CHECK(loop.get(1) == 0);
+}
+
+TEST_CASE("Query_Engine computes different values concurrently") {
+  // Each compute waits (up to a timeout) for the other: both finish early only if they overlap
+  Query_Engine engine;
+  std::atomic<int> inside{0};
+  auto const wait_for_other = [&inside](int const&) {
+    ++inside;
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds{5};
+    while (inside.load() < 2 && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    return inside.load() == 2;
+  };
+  Derived_Query<int, bool> overlapped{engine, wait_for_other};
+
+  std::vector<int> results(2, 0);
+  {
+    std::jthread const first{[&] { results[0] = overlapped.get(0) ? 1 : 0; }};
+    std::jthread const second{[&] { results[1] = overlapped.get(1) ? 1 : 0; }};
+  }
+  CHECK(results == std::vector{1, 1});
+}
+
+TEST_CASE("Query_Engine revalidates a chain of queries") {
+  // sum(n) = input(n) + sum(n - 1): each value depends on all inputs below it
+  Query_Engine engine;
+  Input_Query<int, int> input{engine};
+  Derived_Query<int, int>* sum_ptr = nullptr;
+  Derived_Query<int, int> sum{engine, [&](int const& n_) {
+                                auto const* own = input.get(n_);
+                                REQUIRE(own != nullptr);
+                                return n_ == 0 ? *own : *own + sum_ptr->get(n_ - 1);
+                              }};
+  sum_ptr = &sum;
+
+  constexpr int k_depth = 200;
+  for (int n = 0; n < k_depth; ++n) {
+    input.set(n, 1);
+  }
+  CHECK(sum.get(k_depth - 1) == k_depth);
+  CHECK(engine.execution_count() == k_depth);
+
+  // Changing the top input reruns the top only
+  input.set(k_depth - 1, 2);
+  CHECK(sum.get(k_depth - 1) == k_depth + 1);
+  CHECK(engine.execution_count() == k_depth + 1);
+
+  // Changing the bottom reruns everything above it
+  input.set(0, 2);
+  CHECK(sum.get(k_depth - 1) == k_depth + 2);
+  CHECK(engine.execution_count() == 2 * k_depth + 1);
+}
+
+TEST_CASE("Query_Engine serves concurrent readers") {
+  Line_Queries queries;
+  constexpr int k_files = 16;
+  for (int i = 0; i < k_files; ++i) {
+    queries.text.set(std::to_string(i), std::string(static_cast<std::size_t>(i), '\n'));
+  }
+
+  std::vector<int> failures(8, 0);
+  {
+    std::vector<std::jthread> threads;
+    for (std::size_t t = 0; t < failures.size(); ++t) {
+      threads.emplace_back([&queries, &failures, t] {
+        for (int round = 0; round < 20; ++round) {
+          for (int i = 0; i < k_files; ++i) {
+            if (queries.even.get(std::to_string(i)) != (i % 2 == 0)) {
+              ++failures[t];
+            }
+          }
+        }
+      });
+    }
+  }
+  CHECK(std::ranges::count(failures, 0) == static_cast<std::ptrdiff_t>(failures.size()));
+
+  // Every value was computed once, however many threads asked for it first
+  CHECK(queries.engine.execution_count() == 2 * k_files);
+}
@@ -0,0 +1,66 @@
+#include <doctest/doctest.h>
+
+#include <atomic>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+using life_lang::Thread_Pool;
+
+TEST_CASE("Thread_Pool") {
+  SUBCASE("Runs every task once and results land in their slots") {
+    Thread_Pool pool{4};
+    CHECK(pool.thread_count() == 4);
+
+    std::vector<int> results(1000, 0);
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      pool.submit([&results, i] { results[i] = static_cast<int>(i) * 2; });
+    }
+    pool.wait();
+    for (std::size_t i = 0; i < results.size(); ++i) {
+      CHECK(results[i] == static_cast<int>(i) * 2);
+    }
+  }
+
+  SUBCASE("Tasks may submit more tasks") {
+    Thread_Pool pool{3};
+    std::atomic<int> leaves{0};
+    for (int i = 0; i < 10; ++i) {
+      pool.submit([&] {
+        for (int j = 0; j < 10; ++j) {
+          pool.submit([&] { leaves.fetch_add(1); });
+        }
+      });
+    }
+    pool.wait();
+    CHECK(leaves.load() == 100);
+  }
+
+  SUBCASE("Pool can be reused after wait") {
+    Thread_Pool pool{2};
+    std::atomic<int> count{0};
+    for (int round = 0; round < 3; ++round) {
+      for (int i = 0; i < 50; ++i) {
+        pool.submit([&] { count.fetch_add(1); });
+      }
+      pool.wait();
+      CHECK(count.load() == (round + 1) * 50);
+    }
+  }
+
+  SUBCASE("Destructor drains queued tasks") {
+    std::atomic<int> count{0};
+    {
+      Thread_Pool pool{1};
+      for (int i = 0; i < 20; ++i) {
+        pool.submit([&] { count.fetch_add(1); });
+      }
+    }
+    CHECK(count.load() == 20);
+  }
+
+  SUBCASE("Zero means hardware concurrency") {
+    Thread_Pool const pool;
+    CHECK(pool.thread_count() >= 1);
+  }
+}
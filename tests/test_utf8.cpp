@@ -0,0 +1,64 @@
+#include <doctest/doctest.h>
+
+#include <string>
+
+#include "utf8.hpp"
+
+using life_lang::Utf8_Error;
+using life_lang::validate_utf8;
+
+TEST_CASE("UTF-8 ASCII prefix") {
+  CHECK(life_lang::ascii_prefix_length("") == 0);
+  CHECK(life_lang::ascii_prefix_length("plain ascii") == 11);
+
+  // Non-ASCII byte at every position of a buffer longer than one SIMD block
+  for (std::size_t pos = 0; pos < 40; ++pos) {
+    std::string text(40, 'a');
+    text[pos] = '\xC3';
+    CAPTURE(pos);
+    CHECK(life_lang::ascii_prefix_length(text) == pos);
+  }
+}
+
+TEST_CASE("UTF-8 validation") {
+  SUBCASE("Well-formed text") {
+    CHECK(validate_utf8("").empty());
+    CHECK(validate_utf8("let s = \"héllo 世界 🎉\";").empty());
+    CHECK(validate_utf8("\xF4\x8F\xBF\xBF").empty());  // U+10FFFF
+  }
+
+  SUBCASE("Ill-formed sequences") {
+    CHECK(validate_utf8("\x80") == std::vector<Utf8_Error>{{.offset = 0, .length = 1}});          // Stray continuation
+    CHECK(validate_utf8("a\xC0\xAF") == std::vector<Utf8_Error>{{.offset = 1, .length = 2}});     // Overlong '/'
+    CHECK(validate_utf8("\xE0\x80\x80") == std::vector<Utf8_Error>{{.offset = 0, .length = 3}});  // Overlong 3-byte
+    CHECK(validate_utf8("\xED\xA0\x80") == std::vector<Utf8_Error>{{.offset = 0, .length = 3}});  // Surrogate
+    CHECK(validate_utf8("\xF4\x90\x80\x80") == std::vector<Utf8_Error>{{.offset = 0, .length = 4}});  // > U+10FFFF
+    CHECK(validate_utf8("\xE4\xB8x") == std::vector<Utf8_Error>{{.offset = 0, .length = 2}});        // Truncated
+  }
+
+  SUBCASE("Separate errors are reported separately") {
+    auto const errors = validate_utf8("ok \xFF then \xFE done");
+    CHECK(errors == std::vector<Utf8_Error>{{.offset = 3, .length = 1}, {.offset = 10, .length = 1}});
+  }
+}
+
+TEST_CASE("UTF-8 code point helpers") {
+  std::string const text = "a\xC3\xA9\xE4\xB8\x96z";  // a é 世 z
+  CHECK(life_lang::count_code_points(text) == 4);
+  CHECK(life_lang::advance_code_points(text, 0, 2) == 3);
+  CHECK(life_lang::advance_code_points(text, 0, 3) == 6);
+  CHECK(life_lang::advance_code_points(text, 0, 10) == text.size());
+  CHECK(life_lang::utf8_sequence_length('a') == 1);
+  CHECK(life_lang::utf8_sequence_length('\xF0') == 4);
+  CHECK(life_lang::utf8_sequence_length('\x80') == 0);
+}
+
+TEST_CASE("UTF-16 code unit helpers") {
+  std::string const text = "a\xC3\xA9\xF0\x9F\x98\x80z";  // a é 😀 z
+  CHECK(life_lang::count_utf16_units(text) == 5);
+  CHECK(life_lang::advance_utf16_units(text, 0, 2) == 3);
+  CHECK(life_lang::advance_utf16_units(text, 0, 4) == 7);
+  CHECK(life_lang::advance_utf16_units(text, 0, 3) == 7);  // Inside the surrogate pair
+  CHECK(life_lang::advance_utf16_units(text, 3, 2) == 7);
+  CHECK(life_lang::advance_utf16_units(text, 0, 10) == text.size());
+}